@@ -4,6 +4,9 @@
 #include "ABCTree.h"
 #include "Alembic/Abc/IObject.h"
 #include "zeno/ListObject.h"
+#include <map>
+#include <mutex>
+#include <string>
 
 namespace zeno {
 class TimeAndSamplesMap {
@@ -26,6 +29,24 @@ private:
     bool m_isVerbose;
 };
 
+struct ABCMeshTopology;
+
+// state kept across frames by ReadAlembic: topology of meshes that alembic marks
+// as non-heterogeneous, keyed by abc path, so later frames only refresh positions
+// and attributes; `parallel` lets traverseABC read objects concurrently (Ogawa only)
+struct ABCReadCache {
+    bool parallel = false;
+    std::mutex mtx;
+    std::map<std::string, std::shared_ptr<ABCMeshTopology>> meshes;
+
+    std::shared_ptr<ABCMeshTopology> mesh(std::string const &path);
+
+    void clear() {
+        std::lock_guard lck(mtx);
+        meshes.clear();
+    }
+};
+
 extern void traverseABC(
     Alembic::AbcGeom::IObject &obj,
     ABCTree &tree,
@@ -36,10 +57,13 @@ extern void traverseABC(
     const TimeAndSamplesMap & iTimeMap,
     ObjectVisibility parent_visible,
     bool skipInvisibleObject,
-    bool outOfRangeAsEmpty
+    bool outOfRangeAsEmpty,
+    ABCReadCache *cache = nullptr
 );
 
-extern Alembic::AbcGeom::IArchive readABC(std::string const &path);
+extern Alembic::AbcGeom::IArchive readABC(std::string const &path, int numStreams = 1);
+
+extern bool isOgawaABC(std::string const &path);
 
 extern std::shared_ptr<zeno::ListObject> get_xformed_prims(std::shared_ptr<zeno::ABCTree> abctree);
 
@@ -22,6 +22,11 @@
 #include <zeno/utils/string.h>
 #include <zeno/utils/scope_exit.h>
 #include <numeric>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 #ifdef ZENO_WITH_PYTHON3
     #include <Python.h>
@@ -574,6 +579,26 @@ static ObjectVisibility read_visible_attr(ICompoundProperty arbattrs, const ISam
     return ObjectVisibility::kVisibilityDeferred;
 }
 
+struct ABCMeshTopology {
+    bool valid = false;
+    bool is_point = true;
+    AttrVector<int> loops;
+    AttrVector<vec2i> polys;
+    AttrVector<vec2f> uvs;
+
+    bool faceset_valid = false;
+    std::vector<int> faceset;
+    std::vector<std::string> faceSetNames;
+};
+
+std::shared_ptr<ABCMeshTopology> ABCReadCache::mesh(std::string const &path) {
+    std::lock_guard lck(mtx);
+    auto &topo = meshes[path];
+    if (!topo)
+        topo = std::make_shared<ABCMeshTopology>();
+    return topo;
+}
+
 static std::shared_ptr<PrimitiveObject> foundABCMesh(
         Alembic::AbcGeom::IPolyMeshSchema &mesh
         , int frameid
@@ -581,6 +606,7 @@ static std::shared_ptr<PrimitiveObject> foundABCMesh(
         , bool read_face_set
         , bool outOfRangeAsEmpty
         , std::string abc_name
+        , ABCMeshTopology *topo = nullptr
 ) {
     auto prim = std::make_shared<PrimitiveObject>();
 
@@ -595,20 +621,40 @@ static std::shared_ptr<PrimitiveObject> foundABCMesh(
         return prim;
     }
     ISampleSelector iSS = Alembic::Abc::v12::ISampleSelector((Alembic::AbcCoreAbstract::index_t)sample_index);
-    Alembic::AbcGeom::IPolyMeshSchema::Sample mesamp = mesh.getValue(iSS);
 
-    if (auto marr = mesamp.getPositions()) {
+    // topology (and uvs, when they are not animated) of homogeneous meshes never
+    // changes between samples, take it from the cache instead of re-expanding it
+    auto uvParam = mesh.getUVsParam();
+    bool can_cache = topo && mesh.getTopologyVariance() != kHeterogeneousTopology
+        && (!uvParam || uvParam.isConstant());
+    bool reuse_topo = can_cache && topo->valid;
+    Alembic::AbcGeom::IPolyMeshSchema::Sample mesamp;
+    P3fArraySamplePtr positions;
+    V3fArraySamplePtr velocities;
+    if (reuse_topo) {
+        positions = mesh.getPositionsProperty().getValue(iSS);
+        if (auto vel = mesh.getVelocitiesProperty()) {
+            velocities = vel.getValue(iSS);
+        }
+    } else {
+        mesamp = mesh.getValue(iSS);
+        positions = mesamp.getPositions();
+        velocities = mesamp.getVelocities();
+    }
+
+    if (auto marr = positions) {
         if (!read_done) {
             log_debug("[alembic] totally {} positions", marr->size());
         }
         auto &parr = prim->verts;
+        parr.resize(marr->size());
         for (size_t i = 0; i < marr->size(); i++) {
             auto const &val = (*marr)[i];
-            parr.emplace_back(val[0], val[1], val[2]);
+            parr[i] = {val[0], val[1], val[2]};
         }
     }
 
-    read_velocity(prim, mesamp.getVelocities(), read_done);
+    read_velocity(prim, velocities, read_done);
     if (auto nrm = mesh.getNormalsParam()) {
         auto nrmsamp =
                 nrm.getIndexedValue(Alembic::Abc::v12::ISampleSelector((Alembic::AbcCoreAbstract::index_t)sample_index));
@@ -623,81 +669,94 @@ static std::shared_ptr<PrimitiveObject> foundABCMesh(
         }
     }
 
-    if (auto marr = mesamp.getFaceIndices()) {
-        if (!read_done) {
-            log_debug("[alembic] totally {} face indices", marr->size());
-        }
-        auto &parr = prim->loops;
-        for (size_t i = 0; i < marr->size(); i++) {
-            int ind = (*marr)[i];
-            parr.push_back(ind);
-        }
-    }
-
     bool is_point = true;
-
-    if (auto marr = mesamp.getFaceCounts()) {
-        if (!read_done) {
-            log_debug("[alembic] totally {} faces", marr->size());
-        }
-        auto &loops = prim->loops;
-        auto &parr = prim->polys;
-        int base = 0;
-        for (size_t i = 0; i < marr->size(); i++) {
-            int cnt = (*marr)[i];
-            parr.emplace_back(base, cnt);
-            base += cnt;
-            if (cnt != 1) {
-                is_point = false;
+    if (reuse_topo) {
+        prim->loops = topo->loops;
+        prim->polys = topo->polys;
+        prim->uvs = topo->uvs;
+        is_point = topo->is_point;
+    } else {
+        if (auto marr = mesamp.getFaceIndices()) {
+            if (!read_done) {
+                log_debug("[alembic] totally {} face indices", marr->size());
             }
-        }
-    }
-    if (auto uv = mesh.getUVsParam()) {
-        auto uvsamp =
-            uv.getIndexedValue(Alembic::Abc::v12::ISampleSelector((Alembic::AbcCoreAbstract::index_t)sample_index));
-        int value_size = (int)uvsamp.getVals()->size();
-        int index_size = (int)uvsamp.getIndices()->size();
-        if (!read_done) {
-            log_debug("[alembic] totally {} uv value", value_size);
-            log_debug("[alembic] totally {} uv indices", index_size);
-            if (prim->loops.size() == index_size) {
-                log_debug("[alembic] uv per face");
-            } else if (prim->verts.size() == index_size) {
-                log_debug("[alembic] uv per vertex");
-            } else {
-                log_error("[alembic] error uv indices");
+            auto &parr = prim->loops;
+            for (size_t i = 0; i < marr->size(); i++) {
+                int ind = (*marr)[i];
+                parr.push_back(ind);
             }
         }
-        prim->uvs.resize(value_size);
-        {
-            auto marr = uvsamp.getVals();
+
+        if (auto marr = mesamp.getFaceCounts()) {
+            if (!read_done) {
+                log_debug("[alembic] totally {} faces", marr->size());
+            }
+            auto &loops = prim->loops;
+            auto &parr = prim->polys;
+            int base = 0;
             for (size_t i = 0; i < marr->size(); i++) {
-                auto const &val = (*marr)[i];
-                prim->uvs[i] = {val[0], val[1]};
+                int cnt = (*marr)[i];
+                parr.emplace_back(base, cnt);
+                base += cnt;
+                if (cnt != 1) {
+                    is_point = false;
+                }
             }
         }
-        if (prim->loops.size() == index_size) {
-            prim->loops.add_attr<int>("uvs");
-            for (auto i = 0; i < prim->loops.size(); i++) {
-                prim->loops.attr<int>("uvs")[i] = (*uvsamp.getIndices())[i];
+        if (auto uv = mesh.getUVsParam()) {
+            auto uvsamp =
+                uv.getIndexedValue(Alembic::Abc::v12::ISampleSelector((Alembic::AbcCoreAbstract::index_t)sample_index));
+            int value_size = (int)uvsamp.getVals()->size();
+            int index_size = (int)uvsamp.getIndices()->size();
+            if (!read_done) {
+                log_debug("[alembic] totally {} uv value", value_size);
+                log_debug("[alembic] totally {} uv indices", index_size);
+                if (prim->loops.size() == index_size) {
+                    log_debug("[alembic] uv per face");
+                } else if (prim->verts.size() == index_size) {
+                    log_debug("[alembic] uv per vertex");
+                } else {
+                    log_error("[alembic] error uv indices");
+                }
+            }
+            prim->uvs.resize(value_size);
+            {
+                auto marr = uvsamp.getVals();
+                for (size_t i = 0; i < marr->size(); i++) {
+                    auto const &val = (*marr)[i];
+                    prim->uvs[i] = {val[0], val[1]};
+                }
+            }
+            if (prim->loops.size() == index_size) {
+                prim->loops.add_attr<int>("uvs");
+                for (auto i = 0; i < prim->loops.size(); i++) {
+                    prim->loops.attr<int>("uvs")[i] = (*uvsamp.getIndices())[i];
+                }
+            }
+            else if (prim->verts.size() == index_size) {
+                prim->loops.add_attr<int>("uvs");
+                for (auto i = 0; i < prim->loops.size(); i++) {
+                    prim->loops.attr<int>("uvs")[i] = prim->loops[i];
+                }
             }
         }
-        else if (prim->verts.size() == index_size) {
+        if (!prim->loops.has_attr("uvs")) {
+            if (!read_done) {
+                log_warn("[alembic] Not found uv, auto fill zero.");
+            }
+            prim->uvs.resize(1);
+            prim->uvs[0] = zeno::vec2f(0, 0);
             prim->loops.add_attr<int>("uvs");
             for (auto i = 0; i < prim->loops.size(); i++) {
-                prim->loops.attr<int>("uvs")[i] = prim->loops[i];
+                prim->loops.attr<int>("uvs")[i] = 0;
             }
         }
-    }
-    if (!prim->loops.has_attr("uvs")) {
-        if (!read_done) {
-            log_warn("[alembic] Not found uv, auto fill zero.");
-        }
-        prim->uvs.resize(1);
-        prim->uvs[0] = zeno::vec2f(0, 0);
-        prim->loops.add_attr<int>("uvs");
-        for (auto i = 0; i < prim->loops.size(); i++) {
-            prim->loops.attr<int>("uvs")[i] = 0;
+        if (can_cache) {
+            topo->loops = prim->loops;
+            topo->polys = prim->polys;
+            topo->uvs = prim->uvs;
+            topo->is_point = is_point;
+            topo->valid = true;
         }
     }
     ICompoundProperty arbattrs = mesh.getArbGeomParams();
@@ -711,15 +770,26 @@ static std::shared_ptr<PrimitiveObject> foundABCMesh(
         return prim;
     }
 
-    if (read_face_set) {
+    if (read_face_set && reuse_topo && topo->faceset_valid) {
+        prim->polys.add_attr<int>("faceset") = topo->faceset;
+        auto &ud = prim->userData();
+        for (auto i = 0; i < topo->faceSetNames.size(); i++) {
+            ud.set2(zeno::format("faceset_{}", i), topo->faceSetNames[i]);
+        }
+        ud.set2("faceset_count", int(topo->faceSetNames.size()));
+    }
+    else if (read_face_set) {
         auto &faceset = prim->polys.add_attr<int>("faceset");
         std::fill(faceset.begin(), faceset.end(), -1);
         auto &ud = prim->userData();
         std::vector<std::string> faceSetNames;
         mesh.getFaceSetNames(faceSetNames);
+        // animated face sets have to be read again on every frame
+        bool facesets_constant = true;
         for (auto i = 0; i < faceSetNames.size(); i++) {
             auto n = faceSetNames[i];
             IFaceSet faceSet = mesh.getFaceSet(n);
+            facesets_constant = facesets_constant && faceSet.getSchema().isConstant();
             IFaceSetSchema::Sample faceSetSample = faceSet.getSchema().getValue();
             size_t s = faceSetSample.getFaces()->size();
             for (auto j = 0; j < s; j++) {
@@ -743,6 +813,11 @@ static std::shared_ptr<PrimitiveObject> foundABCMesh(
             ud.set2(zeno::format("faceset_{}", i), n);
         }
         ud.set2("faceset_count", int(faceSetNames.size()));
+        if (can_cache && facesets_constant) {
+            topo->faceset = faceset;
+            topo->faceSetNames = std::move(faceSetNames);
+            topo->faceset_valid = true;
+        }
     }
 
     return prim;
@@ -1010,7 +1085,7 @@ static std::shared_ptr<PrimitiveObject> foundABCCurves(Alembic::AbcGeom::ICurves
     return prim;
 }
 
-void traverseABC(
+static void traverseABCImpl(
     Alembic::AbcGeom::IObject &obj,
     ABCTree &tree,
     int frameid,
@@ -1020,7 +1095,9 @@ void traverseABC(
     const TimeAndSamplesMap & iTimeMap,
     ObjectVisibility parent_visible,
     bool skipInvisibleObject,
-    bool outOfRangeAsEmpty
+    bool outOfRangeAsEmpty,
+    ABCReadCache *cache,
+    std::vector<std::function<void()>> &jobs
 ) {
     {
         auto const &md = obj.getMetaData();
@@ -1052,67 +1129,76 @@ void traverseABC(
             tree.visible = parent_visible;
         }
         if (!(tree.visible == ObjectVisibility::kVisibilityHidden && skipInvisibleObject)) {
-            if (Alembic::AbcGeom::IPolyMesh::matches(md)) {
-                if (!read_done) {
-                    log_debug("[alembic] found a mesh [{}]", obj.getName());
-                }
+            auto read_object = [=, &tree] () mutable {
+                auto const &md = obj.getMetaData();
+                if (Alembic::AbcGeom::IPolyMesh::matches(md)) {
+                    if (!read_done) {
+                        log_debug("[alembic] found a mesh [{}]", obj.getName());
+                    }
 
-                Alembic::AbcGeom::IPolyMesh meshy(obj);
-                auto &mesh = meshy.getSchema();
-                tree.prim = foundABCMesh(mesh, frameid, read_done, read_face_set, outOfRangeAsEmpty, obj.getName());
-                tree.prim->userData().set2("_abc_name", obj.getName());
-                prim_set_abcpath(tree.prim.get(), path);
-            } else if (Alembic::AbcGeom::IXformSchema::matches(md)) {
-                if (!read_done) {
-                    log_debug("[alembic] found a Xform [{}]", obj.getName());
-                }
-                Alembic::AbcGeom::IXform xfm(obj);
-                auto &cam_sch = xfm.getSchema();
-                tree.xform = foundABCXform(cam_sch, frameid);
-            } else if (Alembic::AbcGeom::ICameraSchema::matches(md)) {
-                if (!read_done) {
-                    log_debug("[alembic] found a Camera [{}]", obj.getName());
-                }
-                Alembic::AbcGeom::ICamera cam(obj);
-                auto &cam_sch = cam.getSchema();
-                tree.camera_info = foundABCCamera(cam_sch, frameid);
-            } else if(Alembic::AbcGeom::IPointsSchema::matches(md)) {
-                if (!read_done) {
-                    log_debug("[alembic] found points [{}]", obj.getName());
-                }
-                Alembic::AbcGeom::IPoints points(obj);
-                auto &points_sch = points.getSchema();
-                tree.prim = foundABCPoints(points_sch, frameid, read_done, outOfRangeAsEmpty);
-                tree.prim->userData().set2("_abc_name", obj.getName());
-                prim_set_abcpath(tree.prim.get(), path);
-                tree.prim->userData().set2("faceset_count", 0);
-            } else if(Alembic::AbcGeom::ICurvesSchema::matches(md)) {
-                if (!read_done) {
-                    log_debug("[alembic] found curves [{}]", obj.getName());
-                }
-                Alembic::AbcGeom::ICurves curves(obj);
-                auto &curves_sch = curves.getSchema();
-                tree.prim = foundABCCurves(curves_sch, frameid, read_done, outOfRangeAsEmpty);
-                tree.prim->userData().set2("_abc_name", obj.getName());
-                prim_set_abcpath(tree.prim.get(), path);
-                tree.prim->userData().set2("faceset_count", 0);
-            } else if (Alembic::AbcGeom::ISubDSchema::matches(md)) {
-                if (!read_done) {
-                    log_debug("[alembic] found SubD [{}]", obj.getName());
+                    Alembic::AbcGeom::IPolyMesh meshy(obj);
+                    auto &mesh = meshy.getSchema();
+                    auto topo = cache ? cache->mesh(path) : nullptr;
+                    tree.prim = foundABCMesh(mesh, frameid, read_done, read_face_set, outOfRangeAsEmpty, obj.getName(), topo.get());
+                    tree.prim->userData().set2("_abc_name", obj.getName());
+                    prim_set_abcpath(tree.prim.get(), path);
+                } else if (Alembic::AbcGeom::IXformSchema::matches(md)) {
+                    if (!read_done) {
+                        log_debug("[alembic] found a Xform [{}]", obj.getName());
+                    }
+                    Alembic::AbcGeom::IXform xfm(obj);
+                    auto &cam_sch = xfm.getSchema();
+                    tree.xform = foundABCXform(cam_sch, frameid);
+                } else if (Alembic::AbcGeom::ICameraSchema::matches(md)) {
+                    if (!read_done) {
+                        log_debug("[alembic] found a Camera [{}]", obj.getName());
+                    }
+                    Alembic::AbcGeom::ICamera cam(obj);
+                    auto &cam_sch = cam.getSchema();
+                    tree.camera_info = foundABCCamera(cam_sch, frameid);
+                } else if(Alembic::AbcGeom::IPointsSchema::matches(md)) {
+                    if (!read_done) {
+                        log_debug("[alembic] found points [{}]", obj.getName());
+                    }
+                    Alembic::AbcGeom::IPoints points(obj);
+                    auto &points_sch = points.getSchema();
+                    tree.prim = foundABCPoints(points_sch, frameid, read_done, outOfRangeAsEmpty);
+                    tree.prim->userData().set2("_abc_name", obj.getName());
+                    prim_set_abcpath(tree.prim.get(), path);
+                    tree.prim->userData().set2("faceset_count", 0);
+                } else if(Alembic::AbcGeom::ICurvesSchema::matches(md)) {
+                    if (!read_done) {
+                        log_debug("[alembic] found curves [{}]", obj.getName());
+                    }
+                    Alembic::AbcGeom::ICurves curves(obj);
+                    auto &curves_sch = curves.getSchema();
+                    tree.prim = foundABCCurves(curves_sch, frameid, read_done, outOfRangeAsEmpty);
+                    tree.prim->userData().set2("_abc_name", obj.getName());
+                    prim_set_abcpath(tree.prim.get(), path);
+                    tree.prim->userData().set2("faceset_count", 0);
+                } else if (Alembic::AbcGeom::ISubDSchema::matches(md)) {
+                    if (!read_done) {
+                        log_debug("[alembic] found SubD [{}]", obj.getName());
+                    }
+                    Alembic::AbcGeom::ISubD subd(obj);
+                    auto &subd_sch = subd.getSchema();
+                    tree.prim = foundABCSubd(subd_sch, frameid, read_done, read_face_set, outOfRangeAsEmpty);
+                    tree.prim->userData().set2("_abc_name", obj.getName());
+                    prim_set_abcpath(tree.prim.get(), path);
                 }
-                Alembic::AbcGeom::ISubD subd(obj);
-                auto &subd_sch = subd.getSchema();
-                tree.prim = foundABCSubd(subd_sch, frameid, read_done, read_face_set, outOfRangeAsEmpty);
-                tree.prim->userData().set2("_abc_name", obj.getName());
-                prim_set_abcpath(tree.prim.get(), path);
-            }
-            if (tree.prim) {
-                tree.prim->userData().set2("vis", tree.visible);
-                if (tree.visible == 0) {
-                    for (auto i = 0; i < tree.prim->verts.size(); i++) {
-                        tree.prim->verts[i] = {};
+                if (tree.prim) {
+                    tree.prim->userData().set2("vis", tree.visible);
+                    if (tree.visible == 0) {
+                        for (auto i = 0; i < tree.prim->verts.size(); i++) {
+                            tree.prim->verts[i] = {};
+                        }
                     }
                 }
+            };
+            if (cache && cache->parallel) {
+                jobs.push_back(std::move(read_object));
+            } else {
+                read_object();
             }
         }
     }
@@ -1131,30 +1217,83 @@ void traverseABC(
         Alembic::AbcGeom::IObject child(obj, name);
 
         auto childTree = std::make_shared<ABCTree>();
-        traverseABC(child, *childTree, frameid, read_done, read_face_set, path, iTimeMap, tree.visible, skipInvisibleObject, outOfRangeAsEmpty);
+        traverseABCImpl(child, *childTree, frameid, read_done, read_face_set, path, iTimeMap, tree.visible, skipInvisibleObject, outOfRangeAsEmpty, cache, jobs);
         tree.children.push_back(std::move(childTree));
     }
 }
 
-Alembic::AbcGeom::IArchive readABC(std::string const &path) {
+void traverseABC(
+    Alembic::AbcGeom::IObject &obj,
+    ABCTree &tree,
+    int frameid,
+    bool read_done,
+    bool read_face_set,
+    std::string path,
+    const TimeAndSamplesMap & iTimeMap,
+    ObjectVisibility parent_visible,
+    bool skipInvisibleObject,
+    bool outOfRangeAsEmpty,
+    ABCReadCache *cache
+) {
+    std::vector<std::function<void()>> jobs;
+    traverseABCImpl(obj, tree, frameid, read_done, read_face_set, std::move(path), iTimeMap, parent_visible,
+                    skipInvisibleObject, outOfRangeAsEmpty, cache, jobs);
+    if (jobs.empty())
+        return;
+    // the hierarchy is walked serially above, only the per-object sample reads run here,
+    // on as many threads as readABC opened Ogawa streams for
+    std::exception_ptr error;
+    std::mutex error_mtx;
+    std::atomic<std::size_t> next_job{0};
+    auto worker = [&] {
+        for (std::size_t i; (i = next_job.fetch_add(1)) < jobs.size();) {
+            try {
+                jobs[i]();
+            } catch (...) {
+                std::lock_guard lck(error_mtx);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+    std::size_t nthreads = std::min<std::size_t>(jobs.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < nthreads; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+static std::string readABCHeader(std::string const &path) {
     std::string native_path = std::filesystem::u8path(path).string();
-    std::string hdr;
-    {
-        char buf[5];
-        std::memset(buf, 0, 5);
-        auto fp = std::fopen(native_path.c_str(), "rb");
-        if (!fp)
-            throw Exception("[alembic] cannot open file for read: " + path);
-        std::fread(buf, 4, 1, fp);
-        std::fclose(fp);
-        hdr = buf;
-    }
+    char buf[5];
+    std::memset(buf, 0, 5);
+    auto fp = std::fopen(native_path.c_str(), "rb");
+    if (!fp)
+        throw Exception("[alembic] cannot open file for read: " + path);
+    std::fread(buf, 4, 1, fp);
+    std::fclose(fp);
+    return buf;
+}
+
+bool isOgawaABC(std::string const &path) {
+    return readABCHeader(path) == "Ogaw";
+}
+
+Alembic::AbcGeom::IArchive readABC(std::string const &path, int numStreams) {
+    std::string native_path = std::filesystem::u8path(path).string();
+    std::string hdr = readABCHeader(path);
     if (hdr == "\x89HDF") {
         log_info("[alembic] opening as HDF5 format");
         return {Alembic::AbcCoreHDF5::ReadArchive(), native_path};
     } else if (hdr == "Ogaw") {
         log_info("[alembic] opening as Ogawa format");
-        return {Alembic::AbcCoreOgawa::ReadArchive(), native_path};
+        return {Alembic::AbcCoreOgawa::ReadArchive(std::max(numStreams, 1)), native_path};
     } else {
         throw Exception("[alembic] unrecognized ABC header: [" + hdr + "]");
     }
@@ -1164,6 +1303,29 @@ struct ReadAlembic : INode {
     Alembic::Abc::v12::IArchive archive;
     std::string usedPath;
     bool read_done = false;
+    bool ogawa = false;
+    ABCReadCache cache;
+    bool cache_face_set = false;
+    // next frame read in the background, declared last so it is joined before the archive closes
+    int prefetch_frameid = 0;
+    std::tuple<bool, bool, bool> prefetch_options;
+    std::future<std::shared_ptr<ABCTree>> prefetch;
+
+    std::shared_ptr<ABCTree> readTree(int frameid, bool read_face_set, bool skipInvisibleObject, bool outOfRangeAsEmpty) {
+        auto abctree = std::make_shared<ABCTree>();
+        auto obj = archive.getTop();
+        Alembic::Util::uint32_t numSamplings = archive.getNumTimeSamplings();
+        TimeAndSamplesMap timeMap;
+        for (Alembic::Util::uint32_t s = 0; s < numSamplings; ++s)             {
+            timeMap.add(archive.getTimeSampling(s),
+                        archive.getMaxNumSamplesForTimeSamplingIndex(s));
+        }
+
+        traverseABC(obj, *abctree, frameid, read_done, read_face_set, "", timeMap, ObjectVisibility::kVisibilityDeferred,
+                    skipInvisibleObject, outOfRangeAsEmpty, &cache);
+        return abctree;
+    }
+
     virtual void apply() override {
         int frameid;
         if (has_input("frameid")) {
@@ -1171,34 +1333,56 @@ struct ReadAlembic : INode {
         } else {
             frameid = getGlobalState()->frameid;
         }
-        auto abctree = std::make_shared<ABCTree>();
+        std::shared_ptr<ABCTree> abctree;
         bool read_face_set = get_input2<bool>("read_face_set");
         {
             auto path = get_input<StringObject>("path")->get();
+            bool outOfRangeAsEmpty = get_input2<bool>("outOfRangeAsEmpty");
+            bool skipInvisibleObject = get_input2<bool>("skipInvisibleObject");
+            auto options = std::make_tuple(read_face_set, skipInvisibleObject, outOfRangeAsEmpty);
+            if (prefetch.valid()) {
+                try {
+                    auto tree = prefetch.get();
+                    if (usedPath == path && prefetch_frameid == frameid && prefetch_options == options) {
+                        abctree = std::move(tree);
+                    }
+                } catch (std::exception const &e) {
+                    log_warn("[alembic] prefetch of frame {} failed: {}", prefetch_frameid, e.what());
+                }
+            }
             if (usedPath != path) {
                 read_done = false;
             }
             if (read_done == false) {
-                archive = readABC(path);
+                ogawa = isOgawaABC(path);
+                cache.parallel = ogawa && get_input2<bool>("parallelRead");
+                archive = readABC(path, cache.parallel ? (int)std::thread::hardware_concurrency() : 1);
+                cache.clear();
+            }
+            if (cache_face_set != read_face_set) {
+                cache.clear();
+                cache_face_set = read_face_set;
             }
             double start, _end;
             GetArchiveStartAndEndTime(archive, start, _end);
             // fmt::print("GetArchiveStartAndEndTime: {}\n", start);
             // fmt::print("archive.getNumTimeSamplings: {}\n", archive.getNumTimeSamplings());
-            auto obj = archive.getTop();
-            bool outOfRangeAsEmpty = get_input2<bool>("outOfRangeAsEmpty");
-            bool skipInvisibleObject = get_input2<bool>("skipInvisibleObject");
-            Alembic::Util::uint32_t numSamplings = archive.getNumTimeSamplings();
-            TimeAndSamplesMap timeMap;
-            for (Alembic::Util::uint32_t s = 0; s < numSamplings; ++s)             {
-                timeMap.add(archive.getTimeSampling(s),
-                            archive.getMaxNumSamplesForTimeSamplingIndex(s));
+            if (!abctree) {
+                abctree = readTree(frameid, read_face_set, skipInvisibleObject, outOfRangeAsEmpty);
             }
-
-            traverseABC(obj, *abctree, frameid, read_done, read_face_set, "", timeMap, ObjectVisibility::kVisibilityDeferred,
-                        skipInvisibleObject, outOfRangeAsEmpty);
             read_done = true;
             usedPath = path;
+
+            // HDF5 is not thread-safe, a background read could overlap with any other read
+            if (get_input2<bool>("prefetchNext") && !ogawa) {
+                log_warn("[alembic] prefetchNext ignored, {} is not an Ogawa archive", path);
+            } else if (get_input2<bool>("prefetchNext")) {
+                prefetch_frameid = frameid + 1;
+                prefetch_options = options;
+                prefetch = std::async(std::launch::async, [this, frameid, read_face_set, skipInvisibleObject, outOfRangeAsEmpty] {
+                    return readTree(frameid + 1, read_face_set, skipInvisibleObject, outOfRangeAsEmpty);
+                });
+            }
         }
         {
             auto namelist = std::make_shared<zeno::ListObject>();
@@ -1231,6 +1415,8 @@ ZENDEFNODE(ReadAlembic, {
         {"bool", "outOfRangeAsEmpty", "0"},
         {"bool", "skipInvisibleObject", "1"},
         {"bool", "CopyFacesetToMatid", "1"},
+        {"bool", "parallelRead", "1"},
+        {"bool", "prefetchNext", "0"},
         {"frameid"},
     },
     {
@@ -10,7 +10,9 @@
 #include <deque>
 #include <zeno/types/ListObject.h>
 #include "AudioFile.h"
+#include <zeno/utils/Error.h>
 #include <algorithm>
+#include <map>
 
 #define MINIMP3_IMPLEMENTATION
 #define MINIMP3_FLOAT_OUTPUT
@@ -22,6 +24,48 @@ static float lerp(float start, float end, float value) {
 }
 }
 namespace zeno {
+// Ooura's cdft rewrites the bit reversal table in its work area on every call,
+// so the plans are cached per thread and per length
+static std::shared_ptr<Aquila::Fft> getCachedFft(std::size_t length) {
+    thread_local std::map<std::size_t, std::shared_ptr<Aquila::Fft>> plans;
+    auto &fft = plans[length];
+    if (!fft)
+        fft = Aquila::FftFactory::getFft(length);
+    return fft;
+}
+
+static std::vector<double> hammingTable(int duration_count) {
+    std::vector<double> window(duration_count);
+    for (auto i = 0; i < duration_count; i++) {
+        window[i] = 0.54 - 0.46 * std::cos(2.0 * M_PI * i / (duration_count - 1));
+    }
+    return window;
+}
+
+// duration_count samples from start_index (clamped to the last sample), pre-emphasized
+// when alpha is given and multiplied by the window table when it is not empty
+static void fillAudioFrame(std::vector<float> const &value, int start_index, int duration_count,
+                           float const *pre_emphasis_alpha, std::vector<double> const &window,
+                           std::vector<double> &samples) {
+    samples.resize(duration_count + 1);
+    int last = (int)value.size() - 1;
+    for (auto i = 0; i < duration_count + 1; i++) {
+        samples[i] = value[std::min(start_index + i, last)];
+    }
+    if (pre_emphasis_alpha) {
+        auto alpha = *pre_emphasis_alpha;
+        for (auto i = 0; i < duration_count; i++) {
+            samples[i] = samples[i+1] - alpha * samples[i];
+        }
+    }
+    samples.pop_back();
+    if (!window.empty()) {
+        for (auto i = 0; i < duration_count; i++) {
+            samples[i] = samples[i] * window[i];
+        }
+    }
+}
+
 static std::shared_ptr<PrimitiveObject> readWav(std::string path){
     AudioFile<float> wav;
     wav.load (path);
@@ -174,7 +218,7 @@ static std::shared_ptr<PrimitiveObject> readMp3(std::string path) {
             float sampleFrequency = wave->userData().get<zeno::NumericObject>("SampleRate")->get<float>();
             int start_index = int(sampleFrequency * start_time);
             int duration_count = 1024;
-            auto fft = Aquila::FftFactory::getFft(duration_count);
+            auto fft = getCachedFft(duration_count);
             std::vector<double> samples;
             samples.resize(duration_count);
             for (auto i = 0; i < duration_count; i++) {
@@ -262,14 +306,15 @@ static std::shared_ptr<PrimitiveObject> readMp3(std::string path) {
             auto wave = get_input<PrimitiveObject>("wave");
             int duration_count = 1024;
             if (init.empty()) {
-                auto fft = Aquila::FftFactory::getFft(duration_count);
+                auto fft = getCachedFft(duration_count);
                 int clip_count = wave->size() / duration_count;
+                auto &value = wave->attr<float>("value");
                 init.reserve(clip_count);
                 for (auto i = 0; i < clip_count; i++) {
                     std::vector<double> samples;
                     samples.resize(duration_count);
                     for (auto j = 0; j < duration_count; j++) {
-                        samples[j] = wave->attr<float>("value")[min(duration_count * i + j, wave->size()-1)];
+                        samples[j] = value[min(duration_count * i + j, wave->size()-1)];
                     }
                     Aquila::SpectrumType spectrums = fft->fft(samples.data());
                     {
@@ -304,7 +349,7 @@ static std::shared_ptr<PrimitiveObject> readMp3(std::string path) {
             auto start_time = get_input2<float>("time");
             float sampleFrequency = wave->userData().get<zeno::NumericObject>("SampleRate")->get<float>();
             int start_index = int(sampleFrequency * start_time);
-            auto fft = Aquila::FftFactory::getFft(duration_count);
+            auto fft = getCachedFft(duration_count);
             std::vector<double> samples;
             samples.resize(duration_count);
             for (auto i = 0; i < duration_count; i++) {
@@ -374,28 +419,14 @@ static std::shared_ptr<PrimitiveObject> readMp3(std::string path) {
             auto start_time = get_input2<float>("time");
             float sampleFrequency = wave->userData().get<zeno::NumericObject>("SampleRate")->get<float>();
             int start_index = int(sampleFrequency * start_time);
-            std::vector<double> samples;
-            samples.resize(duration_count+1);
-            for (auto i = 0; i < duration_count+1; i++) {
-                samples[i] = wave->attr<float>("value")[min((start_index + i), wave->size()-1)];
-            }
             auto pre_emphasis = get_input2<int>("preEmphasis");
-            if (pre_emphasis) {
-                auto alpha = get_input2<float>("preEmphasisAlpha");
-                for (auto i = 0; i < duration_count; i++) {
-                    samples[i] = samples[i+1] - alpha * samples[i];
-                }
-            }
-            samples.pop_back();
+            auto alpha = get_input2<float>("preEmphasisAlpha");
             auto hamming_window = get_input2<int>("hammingWindow");
-            if (hamming_window) {
-                for (auto i = 0; i < duration_count; i++) {
-                    double i_value = 0.54 - 0.46 * std::cos(2.0 * M_PI * i / (duration_count - 1));
-                    samples[i] = samples[i] * i_value;
-                }
-            }
+            std::vector<double> samples;
+            fillAudioFrame(wave->attr<float>("value"), start_index, duration_count, pre_emphasis ? &alpha : nullptr,
+                           hamming_window ? hammingTable(duration_count) : std::vector<double>{}, samples);
 
-            auto fft = Aquila::FftFactory::getFft(duration_count);
+            auto fft = getCachedFft(duration_count);
             Aquila::SpectrumType spectrums = fft->fft(samples.data());
 
             auto fft_prim = std::make_shared<PrimitiveObject>();
@@ -436,6 +467,117 @@ static std::shared_ptr<PrimitiveObject> readMp3(std::string path) {
         },
     });
 
+    struct AudioSpectrogram : zeno::INode {
+        virtual void apply() override {
+            auto wave = get_input<PrimitiveObject>("wave");
+            int duration_count = get_input2<int>("duration_count");
+            int hop_size = get_input2<int>("hopSize");
+            if (duration_count < 2 || (duration_count & (duration_count - 1)))
+                throw makeError("duration_count must be a power of two");
+            if (hop_size <= 0)
+                throw makeError("hopSize must be positive");
+            auto pre_emphasis = get_input2<int>("preEmphasis");
+            auto alpha = get_input2<float>("preEmphasisAlpha");
+            auto window = get_input2<int>("hammingWindow") ? hammingTable(duration_count) : std::vector<double>{};
+            auto &value = wave->attr<float>("value");
+
+            // frame f is the AudioFFT window starting at sample f * hopSize
+            int frames = std::max(1, ((int)wave->size() + hop_size - 1) / hop_size);
+            int bins = duration_count / 2 + 1;
+            auto spec = std::make_shared<PrimitiveObject>();
+            spec->resize((std::size_t)frames * bins);
+            auto &pos = spec->verts.values;
+            auto &frame = spec->add_attr<float>("frame");
+            auto &freq = spec->add_attr<float>("freq");
+            auto &real = spec->add_attr<float>("real");
+            auto &image = spec->add_attr<float>("image");
+            auto &square = spec->add_attr<float>("square");
+            auto &power = spec->add_attr<float>("power");
+#pragma omp parallel for
+            for (int f = 0; f < frames; f++) {
+                std::vector<double> samples;
+                fillAudioFrame(value, f * hop_size, duration_count, pre_emphasis ? &alpha : nullptr, window, samples);
+                Aquila::SpectrumType spectrums = getCachedFft(duration_count)->fft(samples.data());
+                for (int i = 0; i < bins; i++) {
+                    std::size_t k = (std::size_t)f * bins + i;
+                    float r = spectrums[i].real();
+                    float im = spectrums[i].imag();
+                    pos[k] = vec3f(float(f), float(i), 0);
+                    frame[k] = float(f);
+                    freq[k] = float(i);
+                    real[k] = r;
+                    image[k] = im;
+                    float square_v = r * r + im * im;
+                    square[k] = square_v;
+                    power[k] = square_v / duration_count;
+                }
+            }
+            if (wave->userData().has("SampleRate"))
+                spec->userData().set("SampleRate", wave->userData().get("SampleRate"));
+            spec->userData().set("frames", std::make_shared<NumericObject>(frames));
+            spec->userData().set("bins", std::make_shared<NumericObject>(bins));
+            spec->userData().set("hopSize", std::make_shared<NumericObject>(hop_size));
+            set_output("spectrogram", spec);
+        }
+    };
+    ZENDEFNODE(AudioSpectrogram, {
+        {
+            "wave",
+            {"int", "duration_count", "1024"},
+            {"int", "hopSize", "512"},
+            {"bool", "preEmphasis", "0"},
+            {"float", "preEmphasisAlpha", "0.97"},
+            {"bool", "hammingWindow", "1"},
+        },
+        {
+            "spectrogram",
+        },
+        {},
+        {
+            "audio"
+        },
+    });
+
+    // slices one frame of an AudioSpectrogram into the layout of AudioFFT
+    struct SpectrogramFrame : zeno::INode {
+        virtual void apply() override {
+            auto spec = get_input<PrimitiveObject>("spectrogram");
+            int frames = spec->userData().get<NumericObject>("frames")->get<int>();
+            int bins = spec->userData().get<NumericObject>("bins")->get<int>();
+            int f = get_input2<int>("frame");
+            if (f < 0) {
+                float sampleFrequency = spec->userData().get<NumericObject>("SampleRate")->get<float>();
+                int hop_size = spec->userData().get<NumericObject>("hopSize")->get<int>();
+                f = int(sampleFrequency * get_input2<float>("time")) / hop_size;
+            }
+            f = std::clamp(f, 0, frames - 1);
+
+            auto fft_prim = std::make_shared<PrimitiveObject>();
+            fft_prim->resize(bins);
+            std::size_t base = (std::size_t)f * bins;
+            for (auto const &name: {"freq", "real", "image", "square", "power"}) {
+                auto &src = spec->attr<float>(name);
+                auto &dst = fft_prim->add_attr<float>(name);
+                std::copy(src.begin() + base, src.begin() + base + bins, dst.begin());
+            }
+            set_output("FFTPrim", fft_prim);
+        }
+    };
+    ZENDEFNODE(SpectrogramFrame, {
+        {
+            "spectrogram",
+            {"float", "time", "0"},
+            {"int", "frame", "-1"},
+        },
+        {
+            "FFTPrim",
+        },
+        {},
+        {
+            "audio"
+        },
+    });
+
     struct AudioTrim : zeno::INode {
         virtual void apply() override {
             auto audio = get_input<PrimitiveObject>("audio");
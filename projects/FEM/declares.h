@@ -21,6 +21,7 @@
 
 #include <matrix_helper.hpp>
 #include<Eigen/SparseCholesky>
+#include <Eigen/IterativeLinearSolvers>
 #include <iomanip>
 
 #include <cmath>
@@ -118,6 +119,15 @@ struct FEMIntegrator : zeno::IObject {
 
     size_t _stepID;
 
+    // linear solver state of SolveFEM, kept across Newton iterations and frames. The Hessian
+    // always has the sparsity pattern of _connMatrix, so its symbolic analysis is done once
+    // per topology and each iteration only refactorizes the values.
+    Eigen::SimplicialLDLT<SpMat> _LDLTSolver;
+    bool _LDLTPatternAnalyzed = false;
+    Eigen::ConjugateGradient<SpMat,Eigen::Lower|Eigen::Upper> _CGSolver;
+    // first Newton direction of the previous frame, warm start of the PCG path
+    VecXd _CGWarmStart;
+
     // initialize all the element-wise attributes by interpolating corresponding vertex-wise attributes, 
     // and assume all this attributes remain unchanged during the simulation process
     // the static parameters which remain unchanged include :
@@ -153,6 +163,8 @@ struct FEMIntegrator : zeno::IObject {
         _connMatrix = SpMat(prim->size() * 3,prim->size() * 3);
         _connMatrix.setFromTriplets(connTriplets.begin(),connTriplets.end());
         _connMatrix.makeCompressed();
+        _LDLTPatternAnalyzed = false;
+        _CGWarmStart.resize(0);
 
         // _elmVolume.resize(nm_elms);
         _elmdFdx.resize(nm_elms);
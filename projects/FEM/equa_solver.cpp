@@ -388,9 +388,6 @@ ZENDEFNODE(SolveFEMFast,{
 struct SolveFEM : zeno::INode {
     virtual void apply() override {
         // std::cout << "BEGIN SOLVER " << std::endl;
-        Eigen::SparseLU<SpMat> _LUSolver;
-        Eigen::SimplicialLDLT<SpMat> _LDLTSolver;
-
         auto integrator = get_input<FEMIntegrator>("integrator");
         auto shape = get_input<PrimitiveObject>("shape");
         auto elmView = get_input<PrimitiveObject>("elmView");
@@ -409,6 +406,8 @@ struct SolveFEM : zeno::INode {
         auto c2 = get_input2<float>("CurvatureCoeff");
         auto beta = get_input2<float>("BTL_shrinkingRate");
         auto epsilon = get_input2<float>("epsilon");
+        auto use_pcg = get_input2<std::string>("linearSolver") == "PCG";
+        auto cg_tolerance = get_input2<float>("cgTolerance");
 
         std::vector<Vec2d> wolfeBuffer;
         wolfeBuffer.resize(max_linesearch);
@@ -515,8 +514,33 @@ struct SolveFEM : zeno::INode {
             r *= -1;
 
             clock_t begin_solve = clock();
-            _LDLTSolver.compute(MatHelper::MapHMatrix(shape->size(),integrator->_connMatrix,HBuffer.data()));
-            dp = _LDLTSolver.solve(r);
+            auto H = MatHelper::MapHMatrix(shape->size(),integrator->_connMatrix,HBuffer.data());
+            bool solved = false;
+            if(use_pcg){
+                // diagonal preconditioned CG, the first iteration of a frame starts from the
+                // first direction of the previous frame
+                auto& cg = integrator->_CGSolver;
+                cg.setTolerance(cg_tolerance);
+                cg.compute(H);
+                if(iter_idx == 0 && integrator->_CGWarmStart.size() == r.size())
+                    dp = cg.solveWithGuess(r,integrator->_CGWarmStart);
+                else
+                    dp = cg.solve(r);
+                solved = cg.info() == Eigen::Success;
+                if(!solved)
+                    std::cout << "PCG NOT CONVERGED AFTER " << cg.iterations() << " ITERS, FALL BACK TO LDLT" << std::endl;
+                else if(iter_idx == 0)
+                    integrator->_CGWarmStart = dp;
+            }
+            if(!solved){
+                auto& ldlt = integrator->_LDLTSolver;
+                if(!integrator->_LDLTPatternAnalyzed){
+                    ldlt.analyzePattern(H);
+                    integrator->_LDLTPatternAnalyzed = true;
+                }
+                ldlt.factorize(H);
+                dp = ldlt.solve(r);
+            }
             clock_t end_solve = clock();
 
             // std::cout << "INTERNAL SIZE : " << r.norm() << "\t" << dp.norm() << HBuffer.norm() << std::endl;
@@ -585,7 +609,7 @@ struct SolveFEM : zeno::INode {
 ZENDEFNODE(SolveFEM,{
     {"integrator","shape","elmView","skin",{"int","maxNRIters","10"},{"int","maxBTLs","10"},{"float","ArmijoCoeff","0.01"},
         {"float","CurvatureCoeff","0.9"},{"float","BTL_shrinkingRate","0.5"},
-        {"float","epsilon","1e-8"}
+        {"float","epsilon","1e-8"},{"enum LDLT PCG","linearSolver","LDLT"},{"float","cgTolerance","1e-6"}
     },
     {"shape"},
     {},
@@ -4,7 +4,7 @@
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 
-#include "../ZenoFX/LinearBvh.h"
+#include <zeno/types/LinearBvh.h>
 
 namespace zeno {
 
@@ -12,6 +12,7 @@
 #include <cmath>
 #include <zeno/utils/log.h>
 #include <opencv2/opencv.hpp>
+#include "imgcv.h"
 
 namespace zeno {
 
@@ -650,24 +651,14 @@ struct ImageBlur : INode {
         auto &ud = image->userData();
         int w = ud.get2<int>("w");
         int h = ud.get2<int>("h");
-        auto img_out = std::make_shared<PrimitiveObject>();
-        img_out->resize(w * h);
-        img_out->userData().set2("w", w);
-        img_out->userData().set2("h", h);
-        img_out->userData().set2("isImage", 1);
+        auto img_out = imageLike(image.get());
 
         if(type == "Gaussian" && fastgaussian){
             gaussBlur(image->verts, img_out->verts, w, h, sigmaX, 3);
         }
         else{//CV BLUR
-            cv::Mat imagecvin(h, w, CV_32FC3);
-            cv::Mat imagecvout(h, w, CV_32FC3);
-            for (auto a = 0; a < image->verts.size(); a++){
-                int i = a / w;
-                int j = a % w;
-                vec3f rgb = image->verts[i * w + j];
-                imagecvin.at<cv::Vec3f>(i, j) = {rgb[0], rgb[1], rgb[2]};
-            }
+            cv::Mat imagecvin = imageMatView(image.get());
+            cv::Mat imagecvout = imageMatView(img_out.get());
             if(kernelSize%2==0){
                 kernelSize += 1;
             }
@@ -691,12 +682,6 @@ struct ImageBlur : INode {
             else{
                 zeno::log_error("ImageBlur: Blur type does not exist");
             }
-            for (auto a = 0; a < image->verts.size(); a++){
-                int i = a / w;
-                int j = a % w;
-                cv::Vec3f rgb = imagecvout.at<cv::Vec3f>(i, j);
-                img_out->verts[i * w + j] = {rgb[0], rgb[1], rgb[2]};
-            }
         }
         set_output("image", img_out);
     }
@@ -1029,25 +1014,8 @@ struct ImageDilate: INode {
         int strength = get_input2<int>("strength");
         int kheight = get_input2<int>("kernel_height");
         int kwidth = get_input2<int>("kernel_width");
-        auto &ud = image->userData();
-        int w = ud.get2<int>("w");
-        int h = ud.get2<int>("h");
-        cv::Mat imagecvin(h, w, CV_32FC3);
-        cv::Mat imagecvout(h, w, CV_32FC3);
-        for (int i = 0; i < h; i++) {
-            for (int j = 0; j < w; j++) {
-                vec3f rgb = image->verts[i * w + j];
-                imagecvin.at<cv::Vec3f>(i, j) = {rgb[0], rgb[1], rgb[2]};
-            }
-        }
-        const int kernelSize = 3;
-        dilateImage(imagecvin, imagecvout, kheight, kwidth, strength);
-        for (int i = 0; i < h; i++) {
-            for (int j = 0; j < w; j++) {
-                cv::Vec3f rgb = imagecvout.at<cv::Vec3f>(i, j);
-                image->verts[i * w + j] = {rgb[0], rgb[1], rgb[2]};
-            }
-        }
+        cv::Mat imagecv = imageMatView(image.get());
+        dilateImage(imagecv, imagecv, kheight, kwidth, strength); // dilate supports in-place
         set_output("image", image);
     }
 };
@@ -1109,27 +1077,9 @@ struct ImageErode: INode {
         int strength = get_input2<int>("strength");
         int kheight = get_input2<int>("kernel_height");
         int kwidth = get_input2<int>("kernel_width");
-        auto &ud = image->userData();
-        int w = ud.get2<int>("w");
-        int h = ud.get2<int>("h");
-        cv::Mat imagecvin(h, w, CV_32FC3);
-        cv::Mat imagecvout(h, w, CV_32FC3);
-        for (int i = 0; i < h; i++) {
-            for (int j = 0; j < w; j++) {
-                vec3f rgb = image->verts[i * w + j];
-                imagecvin.at<cv::Vec3f>(i, j) = {rgb[0], rgb[1], rgb[2]};
-            }
-        }
-
+        cv::Mat imagecv = imageMatView(image.get());
         cv::Mat kernel = getStructuringElement(cv::MORPH_RECT, cv::Size(kheight, kwidth));
-        cv::erode(imagecvin, imagecvout, kernel,cv::Point(-1, -1), strength);
-
-        for (int i = 0; i < h; i++) {
-            for (int j = 0; j < w; j++) {
-                cv::Vec3f rgb = imagecvout.at<cv::Vec3f>(i, j);
-                image->verts[i * w + j] = {rgb[0], rgb[1], rgb[2]};
-            }
-        }
+        cv::erode(imagecv, imagecv, kernel,cv::Point(-1, -1), strength); // erode supports in-place
         set_output("image", image);
     }
 };
@@ -61,10 +61,7 @@ struct ImageEdgeDetect : INode {
         //float scale = get_input2<float>("scale");
         //float delta = get_input2<float>("delta");
         //int borderType = get_input2<int>("borderType");
-        auto &ud = image->userData();
-        int w = ud.get2<int>("w");
-        int h = ud.get2<int>("h");
-        float var = 1;
+        cv::Mat imagecv = imageMatView(image.get());
         /*if (mode == "zeno_gray") {
             std::vector<float> dx, dy;
             zenoedge(image, w, h, dx, dy);
@@ -96,41 +93,22 @@ struct ImageEdgeDetect : INode {
             set_output("image", image);
         }*/
         if (mode == "Sobel") {
-            cv::Mat imagecvin(h, w, CV_32F);
-#pragma omp parallel for
-            for (int i = 0; i < h; i++) {
-                for (int j = 0; j < w; j++) {
-                    vec3f rgb = image->verts[i * w + j];
-                    var = rgb[0] * 0.299 + rgb[1] * 0.587 + rgb[2] *0.114;//TODO:: detect rgb three channel?
-                    imagecvin.at<float>(i, j) = var;
-                }
-            }
+            cv::Mat imagecvin;
+            cv::transform(imagecv, imagecvin, cv::Matx13f(0.299f, 0.587f, 0.114f));
             cv::Mat gradX, gradY;
             //cv::Sobel(imagecvin, gradX, CV_32F, 1, 0, kernelSize,scale,delta,borderType);
             cv::Sobel(imagecvin, gradX, CV_32F, 1, 0, kernelSize);
             cv::Sobel(imagecvin, gradY, CV_32F, 0, 1, kernelSize);
-#pragma omp parallel for
-            for (int i = 0; i < h; i++) {
-                for (int j = 0; j < w; j++) {
-                    float magnitude = abs(gradX.at<float>(i, j)) + abs(gradY.at<float>(i, j));//manhattan distance？ not euclidean distance
-                    image->verts[i * w + j] = {magnitude, magnitude, magnitude};
-                }
-            }
+            cv::Mat magnitude = cv::abs(gradX) + cv::abs(gradY);//manhattan distance？ not euclidean distance
+            cv::cvtColor(magnitude, imagecv, cv::COLOR_GRAY2RGB);
             set_output("image", image);
         }
         else if (mode == "Roberts") {
-            cv::Mat imagecvin(h, w, CV_32F);
-            cv::Mat imagecvout(h, w, CV_32F);
+            cv::Mat imagecvin;
+            cv::Mat imagecvout;
             cv::Mat robertsX, robertsY;
             cv::Mat magnitude;
-#pragma omp parallel for
-            for (int i = 0; i < h; i++) {
-                for (int j = 0; j < w; j++) {
-                    vec3f rgb = image->verts[i * w + j];
-                    var = (rgb[0] * 0.299 + rgb[1] * 0.587 + rgb[2] *0.114);
-                    imagecvin.at<float>(i, j) = var;
-                }
-            }
+            cv::transform(imagecv, imagecvin, cv::Matx13f(0.299f, 0.587f, 0.114f));
             cv::Mat kernelX = (cv::Mat_<float>(2, 2) << 1, 0, 0, -1);
             cv::filter2D(imagecvin, robertsX, -1, kernelX);
 
@@ -138,12 +116,7 @@ struct ImageEdgeDetect : INode {
             cv::filter2D(imagecvin, robertsY, -1, kernelY);
 
             cv::magnitude(robertsX, robertsY, imagecvout);
-#pragma omp parallel for
-            for (int i = 0; i < h; i++) {
-                for (int j = 0; j < w; j++) {
-                    image->verts[i * w + j] = vec3f(imagecvout.at<float>(i, j));
-                }
-            }
+            cv::cvtColor(imagecvout, imagecv, cv::COLOR_GRAY2RGB);
             set_output("image", image);
         }
         /*if (mode == "roberts_threshold") {
@@ -173,18 +146,11 @@ struct ImageEdgeDetect : INode {
             set_output("image", image);
         }*/
         else if (mode == "Prewitt") {
-            cv::Mat imagecvin(h, w, CV_32F);
-            cv::Mat imagecvout(h, w, CV_32F);
+            cv::Mat imagecvin;
+            cv::Mat imagecvout;
             cv::Mat edges;
             cv::Mat prewittX, prewittY;
-#pragma omp parallel for
-            for (int i = 0; i < h; i++) {
-                for (int j = 0; j < w; j++) {
-                    vec3f rgb = image->verts[i * w + j];
-                    var =  (rgb[0] * 0.299 + rgb[1] * 0.587 + rgb[2] *0.114);
-                    imagecvin.at<float>(i, j) = var;
-                }
-            }
+            cv::transform(imagecv, imagecvin, cv::Matx13f(0.299f, 0.587f, 0.114f));
             cv::Mat kernelX = (cv::Mat_<float>(3, 3) << -1, 0, 1, -1, 0, 1, -1, 0, 1);
             cv::filter2D(imagecvin, prewittX, -1, kernelX);
 
@@ -192,12 +158,7 @@ struct ImageEdgeDetect : INode {
             cv::filter2D(imagecvin, prewittY, -1, kernelY);
 
             cv::magnitude(prewittX, prewittY, imagecvout);
-#pragma omp parallel for
-            for (int i = 0; i < h; i++) {
-                for (int j = 0; j < w; j++) {
-                    image->verts[i * w + j] = vec3f(imagecvout.at<float>(i, j));
-                }
-            }
+            cv::cvtColor(imagecvout, imagecv, cv::COLOR_GRAY2RGB);
             set_output("image", image);
         }
         /*if (mode == "Canny") {//TODO：： Canny opencv only accept 8bit image
@@ -424,16 +385,13 @@ struct ImageFeatureDetectORB : INode {
         if (ikeypoints.size() == 0) {
             throw zeno::Exception("Did not find any features");
         }
-        cv::Mat imageFloat;
-        idescriptor.convertTo(imageFloat, CV_32F, 1.0 / 255.0);
-        cv::Size ds = imageFloat.size();
+        cv::Size ds = idescriptor.size();
         int dss = ds.width * ds.height;
         image->uvs.resize(dss);
         image->userData().set2("dw",ds.width);
         zeno::log_info("orbDescriptor.width:{}, orbDescriptor.height:{}",ds.width, ds.height);
-        for (int i = 0; i < dss; i++) {
-            dp[i] = imageFloat.at<float>(i);
-        }
+        cv::Mat descriptors(ds.height, ds.width, CV_32F, dp.data());
+        idescriptor.convertTo(descriptors, CV_32F, 1.0 / 255.0);
         for(size_t i = 0;i < ikeypoints.size();i++){
             cv::KeyPoint keypoint = ikeypoints[i];
             float x = static_cast<float>(keypoint.pt.x);
@@ -514,16 +472,13 @@ struct ImageFeatureDetectSIFT : INode {
                           cv::DrawMatchesFlags::DRAW_RICH_KEYPOINTS);
 //                          | cv::DrawMatchesFlags::DRAW_OVER_OUTIMG
 
-        cv::Mat imageFloat;
-        idescriptor.convertTo(imageFloat, CV_32F, 1.0 / 255.0);
-        cv::Size ds = imageFloat.size();
+        cv::Size ds = idescriptor.size();
         int dss = ds.width * ds.height;
         image->userData().set2("dw",ds.width);
         image->uvs.resize(dss);
         zeno::log_info("siftDescriptor.width:{}, siftDescriptor.height:{}",ds.width, ds.height);
-        for (int i = 0; i < dss; i++) {
-            dp[i] = imageFloat.at<float>(i);
-        }
+        cv::Mat descriptors(ds.height, ds.width, CV_32F, dp.data());
+        idescriptor.convertTo(descriptors, CV_32F, 1.0 / 255.0);
         for(size_t i = 0;i < ikeypoints.size();i++){
             cv::KeyPoint keypoint = ikeypoints[i];
             float x = static_cast<float>(keypoint.pt.x);
@@ -626,18 +581,8 @@ struct ImageFeatureMatch : INode {
         int dw2 = ud2.get2<int>("dw");
         int ks1 = d1.size()/dw1;
         int ks2 = d2.size()/dw2;
-        cv::Mat imagecvdescriptors1(ks1, dw1, CV_32F);
-        cv::Mat imagecvdescriptors2(ks2, dw2, CV_32F);
-        for (int i = 0; i < ks1; i++) {
-            for (int j = 0; j < dw1; j++) {
-                imagecvdescriptors1.at<float>(i, j) = d1[i * dw1 + j];
-            }
-        }
-        for (int i = 0; i < ks2; i++) {
-            for (int j = 0; j < dw2; j++) {
-                imagecvdescriptors2.at<float>(i, j) = d2[i * dw2 + j];
-            }
-        }
+        cv::Mat imagecvdescriptors1(ks1, dw1, CV_32F, d1.data());
+        cv::Mat imagecvdescriptors2(ks2, dw2, CV_32F, d2.data());
         zeno::log_info("image1Keypoints.size:{},image2Keypoints.size:{},image1Descriptors.width:{},image2Descriptors.width:{}",ks1,ks2,dw1,dw2);
 
         cv::Ptr<cv::DescriptorMatcher> matcher = cv::DescriptorMatcher::create(cv::DescriptorMatcher::BRUTEFORCE);
@@ -1069,14 +1014,8 @@ struct Image3DAnalyze : INode {
         }
         zeno::log_info("image1Points.size:{} image2Points.size:{}",image1Points.size(),image2Points.size());
 
-        cv::Mat points1Mat(2,image1Points.size(), CV_32FC1);
-        cv::Mat points2Mat(2,image2Points.size(), CV_32FC1);
-        for (size_t i = 0; i < image1PointsP2C.size(); i++) {
-            points1Mat.at<float>(0, i) = image1PointsP2C[i].x;
-            points1Mat.at<float>(1, i) = image1PointsP2C[i].y;
-            points2Mat.at<float>(0, i) = image2PointsP2C[i].x;
-            points2Mat.at<float>(1, i) = image2PointsP2C[i].y;
-        }
+        cv::Mat points1Mat = cv::Mat(image1PointsP2C).reshape(1).t();
+        cv::Mat points2Mat = cv::Mat(image2PointsP2C).reshape(1).t();
         zeno::log_info("points1Mat.size:{} points2Mat.size:{}",points1Mat.cols,points2Mat.cols);
 
 //essentialMatrix1
@@ -1197,11 +1136,6 @@ struct Image3DAnalyze : INode {
 // triangulatePoints method2
 //        cv::triangulatePoints(cameraMatrixPro1x, cameraMatrixPro2x, points1Mat, points2Mat, points4D);
         zeno::log_info("points4D.cols:{},points4D.rows:{}",points4D.cols,points4D.rows);
-        for (size_t j = 0; j < points4D.cols; j++) {
-            for(size_t i = 0;i < points4D.rows;i++){
-                p4d[j][i] = points4D.at<float>(i,j);
-            }
-        }
 
 //        cv::triangulatePoints(cameraMatrixPro,cameraMatrixPro, points1, points2, points4D);
 //        for (size_t i = 0; i < points4D.rows; i++) {
@@ -911,10 +911,11 @@ struct ReadImageByOpenCV : INode {
     img->verts.resize(width * height);
     auto &clr = img->verts.add_attr<vec3f>("clr");
     for (size_t j = 0; j < height; j++) {
+      const float *row = exrImage.ptr<float>(j);
       for (size_t i = 0; i < width; i++) {
         size_t index = j * width + i;
         img->verts[index] = {float(i) / float(width), float(j) / float(height), 0};
-        float Y = exrImage.at<float>(j, i);
+        float Y = row[i];
         clr[index] = {Y, Y, Y};
       }
     }
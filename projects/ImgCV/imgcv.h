@@ -2,6 +2,9 @@
 #define ZENO_IMGCV_H
 #include <opencv2/core/utility.hpp>
 #include "zeno/core/IObject.h"
+#include "zeno/types/PrimitiveObject.h"
+#include "zeno/types/UserData.h"
+#include "zeno/utils/Error.h"
 
 namespace zeno {
     struct CVImageObject : IObjectClone<CVImageObject> {
@@ -23,5 +26,35 @@ namespace zeno {
         }
         std::variant<cv::Mat> m;
     };
+
+    // image prims store their pixels row-major in verts, which is exactly the layout
+    // of a CV_32FC3 matrix: wrap that storage in a cv::Mat header instead of copying
+    // it pixel by pixel, opencv then reads from and writes into the prim directly
+    static_assert(sizeof(vec3f) == 3 * sizeof(float), "vec3f must be tightly packed");
+
+    inline cv::Mat imageMatView(std::vector<vec3f> &pixels, int w, int h) {
+        if (pixels.size() != (size_t)w * h)
+            throw makeError("image has " + std::to_string(pixels.size()) + " pixels, expect "
+                            + std::to_string(w) + "x" + std::to_string(h));
+        return cv::Mat(h, w, CV_32FC3, pixels.data());
+    }
+
+    inline cv::Mat imageMatView(PrimitiveObject *image) {
+        auto &ud = image->userData();
+        return imageMatView(image->verts.values, ud.get2<int>("w"), ud.get2<int>("h"));
+    }
+
+    // new image prim of the same size, for filters that cannot run in-place
+    inline std::shared_ptr<PrimitiveObject> imageLike(PrimitiveObject *image) {
+        auto &ud = image->userData();
+        int w = ud.get2<int>("w");
+        int h = ud.get2<int>("h");
+        auto img_out = std::make_shared<PrimitiveObject>();
+        img_out->resize(w * h);
+        img_out->userData().set2("w", w);
+        img_out->userData().set2("h", h);
+        img_out->userData().set2("isImage", 1);
+        return img_out;
+    }
 }
 #endif //ZENO_IMGCV_H
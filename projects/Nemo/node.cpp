@@ -9,6 +9,7 @@
 #include <zeno/utils/bit_operations.h>
 #include <zeno/types/PrimitiveUtils.h>
 #include <boost/algorithm/string.hpp>
+#include <numeric>
 
 #include "Evaluate.h"
 #include "zeno/utils/log.h"
@@ -17,8 +18,29 @@
 
 namespace zeno {
 namespace zeno_nemo {
+struct NemoPlayOptions {
+    bool readFaceset = true;
+    bool splitByFaceset = false;
+    bool killDeadVerts = true;
+    bool triangulate = false;
+
+    int key() const {
+        return readFaceset | splitByFaceset << 1 | killDeadVerts << 2 | triangulate << 3;
+    }
+};
+
+// prims of one mesh as NemoPlay outputs them, positions aside
+struct NemoMeshTopo {
+    std::size_t pointCount = 0;
+    std::vector<std::shared_ptr<PrimitiveObject>> prims;
+    // vert i of prims[k] takes point pointIds[k][i] of the mesh
+    std::vector<std::vector<int>> pointIds;
+};
+
 struct NemoObject : PrimitiveObject {
     std::unique_ptr<nemo::Evaluator> evaluator;
+    // key: NemoPlayOptions::key(), then plug id
+    std::map<int, std::map<unsigned, NemoMeshTopo>> topoCache;
 };
 
 struct NemoEvaluator : INode {
@@ -91,6 +113,103 @@ static std::shared_ptr<ListObject> nemo_split_by_name(std::shared_ptr<PrimitiveO
 }
 
 struct NemoPlay : INode {
+    // builds the prims of one mesh as NemoPlay outputs them, with the rig point index of
+    // every vert kept in pointIds, so that later frames only need to refresh positions
+    static NemoMeshTopo buildTopo(nemo::Evaluator &evaluator, unsigned plug_id, std::string const &path,
+                                  std::map<int, std::vector<int>> &mapping_mesh_to_faceset, NemoPlayOptions const &opts) {
+        NemoMeshTopo topo;
+        topo.pointCount = evaluator.getPoints(plug_id).size();
+        auto sub_prim = std::make_shared<zeno::PrimitiveObject>();
+        sub_prim->verts.resize(topo.pointCount);
+        auto &point_id = sub_prim->verts.add_attr<int>("nemo_point");
+        std::iota(point_id.begin(), point_id.end(), 0);
+        auto [counts, connection] = evaluator.getTopo(plug_id);
+        sub_prim->loops.values.assign(connection.begin(), connection.end());
+        auto offset = 0;
+        sub_prim->polys.reserve(counts.size());
+        for (auto i: counts) {
+            sub_prim->polys.emplace_back(offset, i);
+            offset += i;
+        }
+        auto [uValues, vValues, uvIds] = evaluator.getDefaultUV(plug_id);
+        if (uvIds.size() == connection.size()) {
+            auto &uvs = sub_prim->loops.add_attr<int>("uvs");
+            for (auto i = 0; i < uvs.size(); i++) {
+                uvs[i] = uvIds[i];
+            }
+            sub_prim->uvs.reserve(uValues.size());
+            for (auto i = 0; i < uValues.size(); i++) {
+                sub_prim->uvs.emplace_back(uValues[i], vValues[i]);
+            }
+        }
+        std::vector<std::string> faceSetNames;
+        if (opts.readFaceset) {
+            auto &faceset_attr = sub_prim->polys.add_attr<int>("faceset");
+            std::fill(faceset_attr.begin(), faceset_attr.end(), -1);
+            if (mapping_mesh_to_faceset.count(plug_id)) {
+                for (auto fi: mapping_mesh_to_faceset[plug_id]) {
+                    auto &faceset = evaluator.facesets[fi];
+                    auto cur_index = faceSetNames.size();
+                    faceSetNames.push_back(faceset.name);
+                    for (auto i: faceset.members[plug_id]) {
+                        faceset_attr[i] = cur_index;
+                    }
+                }
+            }
+            for (auto i = 0; i < faceSetNames.size(); i++) {
+                auto n = faceSetNames[i];
+                sub_prim->userData().set2(zeno::format("faceset_{}", i), n);
+            }
+            sub_prim->userData().set2("faceset_count", int(faceSetNames.size()));
+        }
+        prim_set_abcpath(sub_prim.get(), "/ABC"+path);
+        if (opts.splitByFaceset && faceSetNames.size() >= 2) {
+            auto list = nemo_split_by_name(sub_prim, true);
+            for (auto p: list->arr) {
+                auto np = std::dynamic_pointer_cast<PrimitiveObject>(p);
+                if (opts.killDeadVerts) {
+                    primKillDeadVerts(np.get());
+                }
+                topo.prims.push_back(np);
+            }
+        }
+        else {
+            topo.prims.push_back(sub_prim);
+        }
+        for (auto &prim: topo.prims) {
+            if (opts.triangulate) {
+                zeno::primTriangulate(prim.get());
+            }
+            topo.pointIds.push_back(std::move(prim->verts.attr<int>("nemo_point")));
+            prim->verts.erase_attr("nemo_point");
+        }
+        return topo;
+    }
+
+    // copies of the cached prims with the positions of this frame, false if the point
+    // count no longer matches the cached topology
+    static bool fillPrims(nemo::Evaluator const &evaluator, unsigned plug_id, NemoMeshTopo const &topo,
+                          bool topologyStatic, std::vector<std::shared_ptr<PrimitiveObject>> &out) {
+        std::vector<glm::vec3> points = evaluator.getPoints(plug_id);
+        if (points.size() != topo.pointCount) {
+            return false;
+        }
+        int vis = evaluator.isVisible(plug_id);
+        out.clear();
+        for (auto k = 0; k < topo.prims.size(); k++) {
+            auto prim = std::make_shared<PrimitiveObject>(*topo.prims[k]);
+            auto const &ids = topo.pointIds[k];
+            auto &pos = prim->verts.values;
+            for (auto i = 0; i < ids.size(); i++) {
+                pos[i] = bit_cast<vec3f>(points[ids[i]]);
+            }
+            prim->userData().set2("vis", vis);
+            prim->userData().set2("topology_static", int(topologyStatic));
+            out.push_back(std::move(prim));
+        }
+        return true;
+    }
+
     virtual void apply() override {
         auto evaluator = get_input2<NemoObject>("Evaluator");
         if (!evaluator) {
@@ -104,8 +223,13 @@ struct NemoPlay : INode {
         bool skipHiddenPrim = get_input2<bool>("skipHiddenPrim");
         std::map<int, std::vector<int>> mapping_mesh_to_faceset;
 
-        auto readFaceset = get_input2<bool>("readFaceset");
-        if (readFaceset) {
+        NemoPlayOptions opts;
+        opts.readFaceset = get_input2<bool>("readFaceset");
+        opts.splitByFaceset = get_input2<bool>("splitByFaceset");
+        opts.killDeadVerts = get_input2<bool>("killDeadVerts");
+        opts.triangulate = get_input2<bool>("triangulate");
+
+        if (opts.readFaceset) {
             for (auto i = 0; i < evaluator->evaluator->facesets.size(); i++) {
                 auto const &faceset = evaluator->evaluator->facesets[i];
                 for (auto [mesh_id, _]: faceset.members) {
@@ -117,93 +241,46 @@ struct NemoPlay : INode {
             }
         }
 
-        auto splitByFaceset = get_input2<bool>("splitByFaceset");
-        auto killDeadVerts = get_input2<bool>("killDeadVerts");
-        auto triangulate = get_input2<bool>("triangulate");
-
-        auto prims = std::make_shared<zeno::ListObject>();
-        std::map<unsigned, std::string> meshes;
+        // topology is static per mesh (Evaluator::LUT_topology), build it once per options
+        auto &topoCache = evaluator->topoCache[opts.key()];
+        std::vector<unsigned> plugs;
+        std::vector<bool> topologyStatic;
         for (unsigned mesh_id = 0; mesh_id != evaluator->evaluator->meshes.size(); ++mesh_id) {
             unsigned plug_id = evaluator->evaluator->meshes[mesh_id];
             if (skipHiddenPrim && evaluator->evaluator->isVisible(plug_id) == 0) {
                 continue;
             }
-
-            std::string path = evaluator->evaluator->LUT_path.at(plug_id);
-            boost::algorithm::replace_all(path, "|", "/");
-            meshes[plug_id] = path;
-            std::vector<glm::vec3> points = evaluator->evaluator->getPoints(plug_id);
-            auto sub_prim = std::make_shared<zeno::PrimitiveObject>();
-            sub_prim->verts.resize(points.size());
-            for (auto i = 0; i < points.size(); i++) {
-                sub_prim->verts[i] = bit_cast<vec3f>(points[i]);
-            }
-            auto [counts, connection] = evaluator->evaluator->getTopo(plug_id);
-            sub_prim->loops.reserve(counts.size());
-            for (auto i: connection) {
-                sub_prim->loops.push_back(i);
-            }
-            auto offset = 0;
-            sub_prim->polys.reserve(counts.size());
-            for (auto i: counts) {
-                sub_prim->polys.emplace_back(offset, i);
-                offset += i;
-            }
-            auto [uValues, vValues, uvIds] = evaluator->evaluator->getDefaultUV(plug_id);
-            if (uvIds.size() == connection.size()) {
-                auto &uvs = sub_prim->loops.add_attr<int>("uvs");
-                for (auto i = 0; i < uvs.size(); i++) {
-                    uvs[i] = uvIds[i];
-                }
-                sub_prim->uvs.reserve(uValues.size());
-                for (auto i = 0; i < uValues.size(); i++) {
-                    sub_prim->uvs.emplace_back(uValues[i], vValues[i]);
-                }
-            }
-            std::vector<std::string> faceSetNames;
-            if (readFaceset) {
-                auto &faceset_attr = sub_prim->polys.add_attr<int>("faceset");
-                std::fill(faceset_attr.begin(), faceset_attr.end(), -1);
-                if (mapping_mesh_to_faceset.count(plug_id)) {
-                    for (auto fi: mapping_mesh_to_faceset[plug_id]) {
-                        auto &faceset = evaluator->evaluator->facesets[fi];
-                        auto cur_index = faceSetNames.size();
-                        faceSetNames.push_back(faceset.name);
-                        for (auto i: faceset.members[plug_id]) {
-                            faceset_attr[i] = cur_index;
-                        }
-                    }
-                }
-                for (auto i = 0; i < faceSetNames.size(); i++) {
-                    auto n = faceSetNames[i];
-                    sub_prim->userData().set2(zeno::format("faceset_{}", i), n);
-                }
-                sub_prim->userData().set2("faceset_count", int(faceSetNames.size()));
-            }
-            prim_set_abcpath(sub_prim.get(), "/ABC"+path);
-            sub_prim->userData().set2("vis", int(evaluator->evaluator->isVisible(plug_id)));
-            if (splitByFaceset && faceSetNames.size() >= 2) {
-                auto list = nemo_split_by_name(sub_prim, true);
-                for (auto p: list->arr) {
-                    auto np = std::dynamic_pointer_cast<PrimitiveObject>(p);
-                    if (killDeadVerts) {
-                        primKillDeadVerts(np.get());
-                    }
-                    prims->arr.emplace_back(p);
-                }
-            }
-            else {
-                prims->arr.emplace_back(sub_prim);
+            plugs.push_back(plug_id);
+            topologyStatic.push_back(topoCache.count(plug_id) != 0);
+            if (!topologyStatic.back()) {
+                std::string path = evaluator->evaluator->LUT_path.at(plug_id);
+                boost::algorithm::replace_all(path, "|", "/");
+                topoCache[plug_id] = buildTopo(*evaluator->evaluator, plug_id, path, mapping_mesh_to_faceset, opts);
             }
         }
 
-        if (triangulate) {
-            for (auto &prim: prims->arr) {
-                auto _prim = std::dynamic_pointer_cast<PrimitiveObject>(prim);
-                zeno::primTriangulate(_prim.get());
+        // refresh positions across meshes, CUDA shapes are pulled one at a time
+        std::vector<std::vector<std::shared_ptr<PrimitiveObject>>> meshPrims(plugs.size());
+        std::vector<char> stale(plugs.size());
+#pragma omp parallel for if (!evaluator->evaluator->runtime.cuda)
+        for (intptr_t i = 0; i < plugs.size(); i++) {
+            stale[i] = !fillPrims(*evaluator->evaluator, plugs[i], topoCache.at(plugs[i]), topologyStatic[i], meshPrims[i]);
+        }
+        for (auto i = 0; i < plugs.size(); i++) {
+            if (stale[i]) {
+                std::string path = evaluator->evaluator->LUT_path.at(plugs[i]);
+                boost::algorithm::replace_all(path, "|", "/");
+                auto &topo = topoCache[plugs[i]] = buildTopo(*evaluator->evaluator, plugs[i], path, mapping_mesh_to_faceset, opts);
+                fillPrims(*evaluator->evaluator, plugs[i], topo, false, meshPrims[i]);
             }
         }
 
+        auto prims = std::make_shared<zeno::ListObject>();
+        for (auto &list: meshPrims) {
+            for (auto &prim: list) {
+                prims->arr.push_back(std::move(prim));
+            }
+        }
         set_output2("prims", prims);
     }
 };
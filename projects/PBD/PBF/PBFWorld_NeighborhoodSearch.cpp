@@ -1,6 +1,6 @@
 #include <zeno/zeno.h>
 #include <zeno/types/PrimitiveObject.h>
-#include "../ZenoFX/LinearBvh.h" //BVH的构建和使用API
+#include <zeno/types/LinearBvh.h> //BVH的构建和使用API
 #include "./PBFWorld.h"
 #include "../Utils/myPrint.h"
 using namespace zeno;
@@ -8,6 +8,7 @@ using namespace zeno;
 namespace zeno{
 struct PBFWorld_NeighborhoodSearch: INode
 {
+    zeno::LBvh lbvh; //上一帧的BVH, 粒子移动不大时只refit
 
     void buildNeighborList(const std::vector<vec3f> &pos, float searchRadius, const zeno::LBvh *lbvh, std::vector<std::vector<int>> & list)
     {
@@ -35,14 +36,14 @@ struct PBFWorld_NeighborhoodSearch: INode
         auto &pos = prim->verts;
 
         //构建BVH
-        auto lbvh = std::make_shared<zeno::LBvh>(prim,  data->neighborSearchRadius,zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
+        lbvh.refitOrBuild(prim, data->neighborSearchRadius, {}, zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
 
         //清零
         data->neighborList.clear();
         data->neighborList.resize(pos.size());
 
         //邻域搜索
-        buildNeighborList(pos, data->neighborSearchRadius, lbvh.get(), data->neighborList);
+        buildNeighborList(pos, data->neighborSearchRadius, &lbvh, data->neighborList);
 
         // //debug
         // printVectorField("neighborList_out11.csv",data->neighborList,0);//test
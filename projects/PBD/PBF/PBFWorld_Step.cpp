@@ -1,4 +1,4 @@
-#include "../ZenoFX/LinearBvh.h"
+#include <zeno/types/LinearBvh.h>
 #include <zeno/types/PrimitiveObject.h>
 #include <zeno/zeno.h>
 #include "./PBFWorld.h"
@@ -9,6 +9,8 @@ using namespace zeno;
 
 
 struct PBFWorld_Step : zeno::INode {
+    zeno::LBvh lbvh; //上一帧的BVH, 粒子移动不大时只refit
+
     void preSolve(PBFWorld* data, PrimitiveObject * prim)
     {
         auto &pos = prim->verts;
@@ -29,14 +31,14 @@ struct PBFWorld_Step : zeno::INode {
         auto &pos = prim->verts;
 
         //构建BVH
-        auto lbvh = std::make_shared<zeno::LBvh>(prim,  data->neighborSearchRadius,zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
+        lbvh.refitOrBuild(prim, data->neighborSearchRadius, {}, zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
 
         //清零
         data->neighborList.clear();
         data->neighborList.resize(pos.size());
 
         //邻域搜索
-        buildNeighborList(pos, data->neighborSearchRadius, lbvh.get(), data->neighborList);
+        buildNeighborList(pos, data->neighborSearchRadius, &lbvh, data->neighborList);
     }
 
 
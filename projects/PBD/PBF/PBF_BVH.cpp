@@ -127,7 +127,7 @@ void PBF_BVH::neighborSearch(std::shared_ptr<PrimitiveObject> prim)
     neighborList.clear();
     neighborList.resize(pos.size());
 
-    lbvh->refit();
+    lbvh->refitOrBuild(prim, neighborSearchRadius, {}, zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
     
     //邻域搜索
     buildNeighborList(pos, neighborSearchRadius, lbvh.get(), neighborList);
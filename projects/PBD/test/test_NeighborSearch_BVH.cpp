@@ -1,6 +1,6 @@
 #include <zeno/zeno.h>
 #include <zeno/types/PrimitiveObject.h>
-#include "../ZenoFX/LinearBvh.h" //BVH搜索
+#include <zeno/types/LinearBvh.h> //BVH搜索
 #include "../PBF/NeighborListData.h" // 数据类，用来节点间数据传递
 #include "../Utils/myPrint.h"//test
 #include "../Utils/readFile.h"//test
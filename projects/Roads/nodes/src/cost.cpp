@@ -48,6 +48,13 @@ namespace zeno::reflect {
         using std::string::string;
     };
 
+    struct PathSearchModeInput : std::string {
+        using std::string::string;
+
+        PathSearchModeInput() = default;
+        PathSearchModeInput(std::string InValue) : std::string(std::move(InValue)) {}
+    };
+
     template<>
     struct ValueTypeToString<ConnectiveTypeInput> {
         inline static std::string TypeName = "enum 4 8 16 40";
@@ -58,6 +65,11 @@ namespace zeno::reflect {
         inline static std::string TypeName = "enum Dijkstra A*";
     };
 
+    template<>
+    struct ValueTypeToString<PathSearchModeInput> {
+        inline static std::string TypeName = "enum Grid Hierarchical Legacy";
+    };
+
 }// namespace zeno::reflect
 
 namespace boost::geometry {
@@ -229,6 +241,15 @@ namespace {
         bool bRemoveTriangles;
         ZENO_DECLARE_INPUT_FIELD(bRemoveTriangles, "Remove Triangles", false, "", "true");
 
+        zeno::reflect::PathSearchModeInput SearchMode;
+        ZENO_DECLARE_INPUT_FIELD(SearchMode, "Search Mode", false, "", "Legacy");
+
+        int CoarseLevel;
+        ZENO_DECLARE_INPUT_FIELD(CoarseLevel, "Coarse Level (Hierarchical)", false, "", "3");
+
+        int CorridorRadius;
+        ZENO_DECLARE_INPUT_FIELD(CorridorRadius, "Corridor Radius (Hierarchical)", false, "", "4");
+
         int Nx = 0;
         ZENO_BINDING_PRIMITIVE_USERDATA(Primitive, Nx, SizeXChannel, false);
 
@@ -246,40 +267,12 @@ namespace {
 
         //std::unordered_map<size_t, float> CurvatureCache;
 
-        void apply() override {
-            RoadsAssert(AutoParameter->Nx * AutoParameter->Ny <= AutoParameter->GradientList.size(), "Bad nx ny.");
-
-            CostPoint GoalPoint{static_cast<size_t>(AutoParameter->Goal[0]), static_cast<size_t>(AutoParameter->Goal[1]), 0};
-            CostPoint StartPoint{static_cast<size_t>(AutoParameter->Start[0]), static_cast<size_t>(AutoParameter->Start[1]), 0};
-
+        ArrayList<size_t> SearchLegacy(const CostPoint &StartPoint, const CostPoint &GoalPoint, std::function<float(float)> &HeightCostFunc, std::function<float(float)> &GradientCostFunc, std::function<float(float)> &CurvatureCostFunc) {
             DefaultedHashMap<CostPoint, CostPoint> Predecessor;
             DefaultedHashMap<CostPoint, float> CostMap;
 
             size_t Nx = AutoParameter->Nx, Ny = AutoParameter->Ny;
 
-            auto MapFuncGen = [](const std::shared_ptr<zeno::CurveObject> &Curve, float Threshold) -> std::function<float(float)> {
-                if (Curve) {
-                    return [Curve, Threshold](float In) -> float {
-                        if (Threshold > 0 && In > Threshold) {
-                            return 9e06f;
-                        }
-                        return Curve->eval(float(In));
-                    };
-                } else {
-                    zeno::log_warn("[Roads] Invalid Curve !");
-                    return [Threshold](float In) -> float {
-                        if (Threshold > 0 && In > Threshold) {
-                            return 9e06f;
-                        }
-                        return In;
-                    };
-                }
-            };
-
-            auto HeightCostFunc = MapFuncGen(AutoParameter->HeightCurve, -1.0f);
-            auto GradientCostFunc = MapFuncGen(AutoParameter->GradientCurve, -1.0f);
-            auto CurvatureCostFunc = MapFuncGen(AutoParameter->CurvatureCurve, AutoParameter->CurvatureThreshold);
-
             DynamicGrid<CostPoint> CostGrid(AutoParameter->Nx, AutoParameter->Ny);
             CostGrid.resize(AutoParameter->Nx * AutoParameter->Ny);
             //#pragma omp parallel for
@@ -323,8 +316,6 @@ namespace {
                 return Cost;
             };
 
-            zeno::log_info("[Roads] Generating trajectory...");
-
             ROADS_TIMING_PRE_GENERATED;
 
             ROADS_TIMING_BLOCK("AStar Extended", roads::energy::RoadsShortestPath(StartPoint, GoalPoint, CostPoint{static_cast<size_t>(AutoParameter->Nx), static_cast<size_t>(AutoParameter->Ny)}, AutoParameter->ConnectiveMask, AutoParameter->AngleMask, AutoParameter->WeightHeuristic, Predecessor, CostMap, CostFunc));
@@ -340,6 +331,74 @@ namespace {
             }
             Path.push_back(StartPoint[0] + StartPoint[1] * AutoParameter->Nx);
 
+            return Path;
+        }
+
+        void apply() override {
+            RoadsAssert(AutoParameter->Nx * AutoParameter->Ny <= AutoParameter->GradientList.size(), "Bad nx ny.");
+
+            CostPoint GoalPoint{static_cast<size_t>(AutoParameter->Goal[0]), static_cast<size_t>(AutoParameter->Goal[1]), 0};
+            CostPoint StartPoint{static_cast<size_t>(AutoParameter->Start[0]), static_cast<size_t>(AutoParameter->Start[1]), 0};
+
+            size_t Nx = AutoParameter->Nx, Ny = AutoParameter->Ny;
+
+            auto MapFuncGen = [](const std::shared_ptr<zeno::CurveObject> &Curve, float Threshold) -> std::function<float(float)> {
+                if (Curve) {
+                    return [Curve, Threshold](float In) -> float {
+                        if (Threshold > 0 && In > Threshold) {
+                            return 9e06f;
+                        }
+                        return Curve->eval(float(In));
+                    };
+                } else {
+                    zeno::log_warn("[Roads] Invalid Curve !");
+                    return [Threshold](float In) -> float {
+                        if (Threshold > 0 && In > Threshold) {
+                            return 9e06f;
+                        }
+                        return In;
+                    };
+                }
+            };
+
+            auto HeightCostFunc = MapFuncGen(AutoParameter->HeightCurve, -1.0f);
+            auto GradientCostFunc = MapFuncGen(AutoParameter->GradientCurve, -1.0f);
+            auto CurvatureCostFunc = MapFuncGen(AutoParameter->CurvatureCurve, AutoParameter->CurvatureThreshold);
+
+            ArrayList<size_t> Path;
+
+            zeno::log_info("[Roads] Generating trajectory...");
+
+            if (AutoParameter->SearchMode == "Legacy") {
+                Path = SearchLegacy(StartPoint, GoalPoint, HeightCostFunc, GradientCostFunc, CurvatureCostFunc);
+            } else {
+                ArrayList<float> HeightLayer(Nx * Ny), GradientLayer(Nx * Ny);
+#pragma omp parallel for
+                for (int64_t i = 0; i < int64_t(Nx * Ny); ++i) {
+                    HeightLayer[i] = AutoParameter->PositionList[i][1];
+                    GradientLayer[i] = AutoParameter->GradientList[i];
+                }
+
+                roads::energy::GridPathOptions Options;
+                Options.MaskK = AutoParameter->ConnectiveMask;
+                Options.WeightHeuristic = AutoParameter->WeightHeuristic;
+                Options.CoarseLevel = AutoParameter->SearchMode == "Hierarchical" ? AutoParameter->CoarseLevel : 0;
+                Options.CorridorRadius = AutoParameter->CorridorRadius;
+
+                auto EdgeCostFunc = [&HeightCostFunc, &GradientCostFunc](float DeltaHeight, float DeltaGradient) -> float {
+                    return HeightCostFunc(DeltaHeight) + GradientCostFunc(DeltaGradient);
+                };
+
+                ROADS_TIMING_PRE_GENERATED;
+
+                ROADS_TIMING_BLOCK("Grid AStar", Path = roads::energy::GridShortestPath(Nx, Ny, HeightLayer, GradientLayer, StartPoint[0] + StartPoint[1] * Nx, GoalPoint[0] + GoalPoint[1] * Nx, Options, EdgeCostFunc, CurvatureCostFunc));
+            }
+
+            if (Path.empty()) {
+                zeno::log_error("[Roads] Goal point can't be reached from start point.");
+                return;
+            }
+
             if (AutoParameter->bRemoveTriangles) {
                 AutoParameter->Primitive->tris.clear();
             }
@@ -578,54 +637,126 @@ namespace {
             zeno::AttrVector<zeno::vec3f>& PositionAttr = Mesh->verts;
             zeno::AttrVector<float>& RoadMaskk = AutoParameter->RoadMask;
 
-            std::vector<float> UpdatedHeightField(PositionAttr.size());
+            // Every epoch smooths the same input heights, so a single pass gives the result of all of them
+            if (Epochs <= 0 || SmoothRadius <= 0) {
+                return;
+            }
+
+            const int32_t KernelSize = 2 * SmoothRadius + 1;
 
-            for (int32_t Epoch = 0; Epoch < Epochs; ++Epoch) {
+            std::vector<float> Heights(size_t(Nx) * Ny);
 #pragma omp parallel for
+            for (int32_t i = 0; i < Heights.size(); ++i) {
+                Heights[i] = PositionAttr[i][1];
+            }
+
+            std::vector<int32_t> RoadCells;
+            for (int32_t i = 0; i < Heights.size(); ++i) {
+                if (0 != RoadMaskk[i]) {
+                    RoadCells.push_back(i);
+                }
+            }
+
+            std::vector<float> UpdatedHeightField(RoadCells.size());
+
+            if (OverThresholdWeightRatio == 1.0f) {
+                // Slope gate changes nothing, the gaussian is split into a pass along x then along y
+                std::vector<float> Kernel(KernelSize);
+                for (int32_t d = -SmoothRadius; d <= SmoothRadius; ++d) {
+                    Kernel[d + SmoothRadius] = std::exp(-(d * d) / (2.0f * SmoothRadius * SmoothRadius));
+                }
+
+                std::vector<uint8_t> RowNeeded(Ny, 0);
+                for (int32_t Idx : RoadCells) {
+                    const int32_t y = Idx / Nx;
+                    for (int32_t ny = std::max(y - SmoothRadius, 0); ny <= std::min(y + SmoothRadius, Ny - 1); ++ny) {
+                        RowNeeded[ny] = 1;
+                    }
+                }
+
+                std::vector<float> RowHeight(Heights.size()), RowWeight(Heights.size());
+#pragma omp parallel for schedule(dynamic, 16)
                 for (int32_t y = 0; y < Ny; ++y) {
+                    if (!RowNeeded[y]) continue;
                     for (int32_t x = 0; x < Nx; ++x) {
-                        int32_t Idx = y * Nx + x;
-                        if (0 != RoadMaskk[Idx]) {
-                            float HeightSummary = 0.0f;
-                            float WeightSummary = 0;
-
-                            for (int32_t dx = -SmoothRadius; dx <= SmoothRadius; ++dx) {
-                                for (int32_t dy = -SmoothRadius; dy <= SmoothRadius; ++dy) {
-                                    int32_t nx = x + dx;
-                                    int32_t ny = y + dy;
-
-                                    if (nx >= 0 && ny >= 0 && nx < Nx && ny < Ny) {
-                                        float Distance = std::sqrt(dx * dx + dy * dy);
-                                        float Slope = 0.0f;
-
-                                        if (Distance > 1e-3) {
-                                            Slope = std::abs<float>(PositionAttr[y*Nx + x][1] - PositionAttr[ny*Nx + nx][1]) / Distance;
-                                        }
-
-                                        float Weight = std::exp(-(dx*dx + dy*dy) / (2.0f * SmoothRadius * SmoothRadius));
-
-                                        if (Slope > SlopeThreshold) {
-                                            Weight *= OverThresholdWeightRatio;
-                                        }
-
-                                        HeightSummary += PositionAttr[ny * Nx + nx].at(1) * Weight;
-                                        WeightSummary += Weight;
-                                    }
-                                }
+                        float HeightSummary = 0.0f;
+                        float WeightSummary = 0.0f;
+                        for (int32_t nx = std::max(x - SmoothRadius, 0); nx <= std::min(x + SmoothRadius, Nx - 1); ++nx) {
+                            HeightSummary += Heights[y * Nx + nx] * Kernel[nx - x + SmoothRadius];
+                            WeightSummary += Kernel[nx - x + SmoothRadius];
+                        }
+                        RowHeight[y * Nx + x] = HeightSummary;
+                        RowWeight[y * Nx + x] = WeightSummary;
+                    }
+                }
+
+#pragma omp parallel for
+                for (int32_t i = 0; i < RoadCells.size(); ++i) {
+                    const int32_t x = RoadCells[i] % Nx;
+                    const int32_t y = RoadCells[i] / Nx;
+                    float HeightSummary = 0.0f;
+                    float WeightSummary = 0.0f;
+                    for (int32_t ny = std::max(y - SmoothRadius, 0); ny <= std::min(y + SmoothRadius, Ny - 1); ++ny) {
+                        HeightSummary += RowHeight[ny * Nx + x] * Kernel[ny - y + SmoothRadius];
+                        WeightSummary += RowWeight[ny * Nx + x] * Kernel[ny - y + SmoothRadius];
+                    }
+                    UpdatedHeightField[i] = HeightSummary / WeightSummary;
+                }
+            } else {
+                // Weight of each neighbour depends on its slope to the center, so the kernel is walked per cell;
+                // distances and gaussian weights of the offsets are computed once, in the same expressions as before
+                std::vector<float> KernelDistance(KernelSize * KernelSize);
+                std::vector<float> KernelWeight(KernelSize * KernelSize);
+                for (int32_t dx = -SmoothRadius; dx <= SmoothRadius; ++dx) {
+                    for (int32_t dy = -SmoothRadius; dy <= SmoothRadius; ++dy) {
+                        const int32_t k = (dx + SmoothRadius) * KernelSize + (dy + SmoothRadius);
+                        KernelDistance[k] = std::sqrt(dx * dx + dy * dy);
+                        KernelWeight[k] = std::exp(-(dx*dx + dy*dy) / (2.0f * SmoothRadius * SmoothRadius));
+                    }
+                }
+
+#pragma omp parallel for schedule(dynamic, 64)
+                for (int32_t i = 0; i < RoadCells.size(); ++i) {
+                    const int32_t x = RoadCells[i] % Nx;
+                    const int32_t y = RoadCells[i] / Nx;
+                    const float CenterHeight = Heights[RoadCells[i]];
+                    float HeightSummary = 0.0f;
+                    float WeightSummary = 0;
+
+                    for (int32_t dx = -SmoothRadius; dx <= SmoothRadius; ++dx) {
+                        const int32_t nx = x + dx;
+                        if (nx < 0 || nx >= Nx) continue;
+                        for (int32_t dy = -SmoothRadius; dy <= SmoothRadius; ++dy) {
+                            const int32_t ny = y + dy;
+                            if (ny < 0 || ny >= Ny) continue;
+
+                            const int32_t k = (dx + SmoothRadius) * KernelSize + (dy + SmoothRadius);
+                            const float Distance = KernelDistance[k];
+                            float Slope = 0.0f;
+
+                            if (Distance > 1e-3) {
+                                Slope = std::abs<float>(CenterHeight - Heights[ny * Nx + nx]) / Distance;
                             }
 
-                            if (WeightSummary > 0) {
-                                UpdatedHeightField[Idx] = HeightSummary / WeightSummary;
+                            float Weight = KernelWeight[k];
+
+                            if (Slope > SlopeThreshold) {
+                                Weight *= OverThresholdWeightRatio;
                             }
+
+                            HeightSummary += Heights[ny * Nx + nx] * Weight;
+                            WeightSummary += Weight;
                         }
                     }
+
+                    // Center always has weight 1
+                    UpdatedHeightField[i] = HeightSummary / WeightSummary;
                 }
             }
 
 #pragma omp parallel for
-            for (int32_t i = 0; i < UpdatedHeightField.size(); ++i) {
-                if (0 != RoadMaskk[i])
-                    PositionAttr[i][1] = UpdatedHeightField[i];
+            for (int32_t i = 0; i < RoadCells.size(); ++i) {
+                PositionAttr[RoadCells[i]][1] = UpdatedHeightField[i];
             }
         }
     };
@@ -191,6 +191,29 @@ namespace roads {
                 }
             }
         }
+
+        struct GridPathOptions {
+            // Neighbours are the offsets (dx, dy) with |dx|, |dy| <= MaskK and gcd(|dx|, |dy|) == 1
+            int32_t MaskK = 1;
+            // Heuristic is WeightHeuristic * (cheapest edge cost) * (steps left to the goal)
+            float WeightHeuristic = 1.0f;
+            // Search a grid 2^CoarseLevel times coarser first, then keep the fine search inside the corridor around its path. 0 disables it.
+            int32_t CoarseLevel = 0;
+            // Half width of the corridor, in coarse cells
+            int32_t CorridorRadius = 4;
+            // Edge costs without curvature are tabulated per cell and direction when they fit in this budget
+            size_t EdgeCostCacheBytes = size_t(1) << 30;
+        };
+
+        using GridEdgeCostFunc = std::function<float(float DeltaHeight, float DeltaGradient)>;
+        using GridCurvatureCostFunc = std::function<float(float Curvature)>;
+
+        /**
+         * A* over the cells of a Nx * Ny height field, using flat cost and predecessor arrays and a binary heap.
+         * Moving from cell A to B costs EdgeCost(|dh|, |dg|) + CurvatureCost(|curvature of Predecessor(A), A, B|).
+         * @return cell indices from Goal back to Start, empty if Goal can't be reached
+         */
+        ROADS_API ArrayList<size_t> GridShortestPath(size_t Nx, size_t Ny, const ArrayList<float> &Height, const ArrayList<float> &Gradient, size_t Start, size_t Goal, const GridPathOptions &Options, const GridEdgeCostFunc &EdgeCost, const GridCurvatureCostFunc &CurvatureCost);
     }// namespace energy
 
     namespace spline {
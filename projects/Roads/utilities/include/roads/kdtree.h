@@ -3,6 +3,8 @@
 #include "Eigen/Dense"
 #include "pch.h"
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -23,7 +25,7 @@ namespace roads {
     class KDTree {
         std::shared_ptr<KDTreeNode> Root = nullptr;
 
-        static KDTreeNode* BuildKdTree_Impl(ArrayList<VectorXf> Data, int64_t Lower, int64_t Upper, uint32_t Depth);
+        static KDTreeNode* BuildKdTree_Impl(ArrayList<VectorXf>& Data, int64_t Lower, int64_t Upper, uint32_t Depth);
 
         std::shared_ptr<KDTreeNode> Insert_Impl(const std::shared_ptr<KDTreeNode> &Node, VectorXf Point, uint32_t Depth);
 
@@ -38,6 +40,169 @@ namespace roads {
     };
 
 
+    /**
+     * Implicit KD-tree over points of fixed dimension.
+     * Entries are reordered so that every range [Lower, Upper) keeps its splitting point at
+     * Lower + (Upper - Lower) / 2, split on axis Depth % Dim; no node is allocated.
+     * Queries return indices into the array given to Build, and write into caller buffers.
+     */
+    template <int Dim, typename Scalar = float>
+    class FlatKDTree {
+    public:
+        using PointType = Eigen::Matrix<Scalar, Dim, 1>;
+
+        struct Entry {
+            PointType Point;
+            uint32_t Index;
+        };
+
+        void Build(const PointType* InPoints, size_t Num) {
+            Entries.resize(Num);
+            for (size_t Idx = 0; Idx < Num; ++Idx) {
+                Entries[Idx] = Entry { InPoints[Idx], static_cast<uint32_t>(Idx) };
+            }
+#pragma omp parallel
+#pragma omp single
+            Build_Impl(0, Num, 0);
+        }
+
+        void Build(const ArrayList<PointType>& InPoints) {
+            Build(InPoints.data(), InPoints.size());
+        }
+
+        size_t Size() const {
+            return Entries.size();
+        }
+
+        const ArrayList<Entry>& GetEntries() const {
+            return Entries;
+        }
+
+        /**
+         * Indices of the points within Radius of Center, OutIndices is cleared first
+         * @return Number of points found
+         */
+        size_t SearchRadius(const PointType& Center, Scalar Radius, ArrayList<uint32_t>& OutIndices) const {
+            OutIndices.clear();
+            const Scalar RadiusSquared = Radius * Radius;
+            Range Stack[MaxStackDepth];
+            size_t Top = 0;
+            Stack[Top++] = Range { 0, Entries.size(), 0, 0 };
+            while (Top != 0) {
+                const Range Current = Stack[--Top];
+                if (Current.Lower >= Current.Upper) {
+                    continue;
+                }
+                const size_t Middle = Current.Lower + (Current.Upper - Current.Lower) / 2;
+                const Entry& Node = Entries[Middle];
+                if ((Node.Point - Center).squaredNorm() <= RadiusSquared) {
+                    OutIndices.push_back(Node.Index);
+                }
+                const uint32_t Axis = Current.Depth % Dim;
+                const Scalar Diff = Center[Axis] - Node.Point[Axis];
+                if (Diff - Radius <= 0) {
+                    Stack[Top++] = Range { Current.Lower, Middle, Current.Depth + 1, 0 };
+                }
+                if (Diff + Radius >= 0) {
+                    Stack[Top++] = Range { Middle + 1, Current.Upper, Current.Depth + 1, 0 };
+                }
+            }
+            return OutIndices.size();
+        }
+
+        /**
+         * The K points nearest to Center, nearest first
+         * @param OutIndices Receives up to K indices
+         * @param OutSquaredDistances Receives the squared distances, may be nullptr
+         * @return Number of points found, min(K, Size())
+         */
+        size_t SearchKNearest(const PointType& Center, size_t K, uint32_t* OutIndices, Scalar* OutSquaredDistances = nullptr) const {
+            if (K == 0) {
+                return 0;
+            }
+            // Sorted insertion, K is expected to be small
+            constexpr size_t LocalCapacity = 32;
+            Scalar LocalDistances[LocalCapacity];
+            ArrayList<Scalar> HeapDistances;
+            Scalar* Distances = LocalDistances;
+            if (OutSquaredDistances) {
+                Distances = OutSquaredDistances;
+            } else if (K > LocalCapacity) {
+                HeapDistances.resize(K);
+                Distances = HeapDistances.data();
+            }
+            size_t Found = 0;
+            auto Worst = [&] {
+                return Found < K ? std::numeric_limits<Scalar>::max() : Distances[Found - 1];
+            };
+
+            Range Stack[MaxStackDepth];
+            size_t Top = 0;
+            Stack[Top++] = Range { 0, Entries.size(), 0, 0 };
+            while (Top != 0) {
+                const Range Current = Stack[--Top];
+                if (Current.Lower >= Current.Upper || Current.PlaneDistanceSquared > Worst()) {
+                    continue;
+                }
+                const size_t Middle = Current.Lower + (Current.Upper - Current.Lower) / 2;
+                const Entry& Node = Entries[Middle];
+                const Scalar DistanceSquared = (Node.Point - Center).squaredNorm();
+                if (DistanceSquared < Worst()) {
+                    size_t Slot = Found < K ? Found++ : K - 1;
+                    while (Slot > 0 && Distances[Slot - 1] > DistanceSquared) {
+                        Distances[Slot] = Distances[Slot - 1];
+                        OutIndices[Slot] = OutIndices[Slot - 1];
+                        --Slot;
+                    }
+                    Distances[Slot] = DistanceSquared;
+                    OutIndices[Slot] = Node.Index;
+                }
+                const uint32_t Axis = Current.Depth % Dim;
+                const Scalar Diff = Center[Axis] - Node.Point[Axis];
+                const Range Near = Diff < 0 ? Range { Current.Lower, Middle, Current.Depth + 1, 0 }
+                                            : Range { Middle + 1, Current.Upper, Current.Depth + 1, 0 };
+                const Range Far = Diff < 0 ? Range { Middle + 1, Current.Upper, Current.Depth + 1, Diff * Diff }
+                                           : Range { Current.Lower, Middle, Current.Depth + 1, Diff * Diff };
+                // Far side is popped after the near side has tightened Worst()
+                Stack[Top++] = Far;
+                Stack[Top++] = Near;
+            }
+            return Found;
+        }
+
+    private:
+        struct Range {
+            size_t Lower, Upper;
+            uint32_t Depth;
+            Scalar PlaneDistanceSquared;
+        };
+
+        // Ranges halve on every level, two are pushed per pop
+        static constexpr size_t MaxStackDepth = 2 * 64 + 2;
+        static constexpr size_t ParallelBuildThreshold = 1 << 14;
+
+        ArrayList<Entry> Entries;
+
+        void Build_Impl(size_t Lower, size_t Upper, uint32_t Depth) {
+            if (Upper - Lower <= 1) {
+                return;
+            }
+            const uint32_t Axis = Depth % Dim;
+            const auto Middle = Entries.begin() + Lower + (Upper - Lower) / 2;
+            std::nth_element(Entries.begin() + Lower, Middle, Entries.begin() + Upper, [Axis](const Entry& A, const Entry& B) {
+                return A.Point[Axis] < B.Point[Axis];
+            });
+            const size_t MiddleIndex = Middle - Entries.begin();
+#pragma omp task if (Upper - Lower > ParallelBuildThreshold)
+            Build_Impl(Lower, MiddleIndex, Depth + 1);
+            Build_Impl(MiddleIndex + 1, Upper, Depth + 1);
+#pragma omp taskwait
+        }
+    };
+
+    using FlatKDTree2f = FlatKDTree<2, float>;
+    using FlatKDTree3f = FlatKDTree<3, float>;
+
     class Octree {
     public:
         using Point3D = Eigen::Vector3f;
@@ -3,6 +3,8 @@
 #include "boost/graph/floyd_warshall_shortest.hpp"
 
 #include "roads/thirdparty/tinysplinecxx.h"
+#include <algorithm>
+#include <limits>
 #include <random>
 
 using namespace roads;
@@ -49,6 +51,253 @@ DynamicGrid<SlopePoint> roads::CalculateSlope(const DynamicGrid<HeightPoint> &In
     return Result;
 }
 
+namespace {
+    struct GridStep {
+        int32_t dx, dy;
+        // Tabulated direction holding this step; steps against it read the cost stored at their target cell
+        size_t Layer;
+        bool bStoredAtTarget;
+    };
+
+    struct GridLevel {
+        size_t Nx, Ny;
+        float CellSize;
+        const float *Height;
+        const float *Gradient;
+    };
+
+    class GridAStar {
+    public:
+        GridAStar(const GridLevel &InLevel, const energy::GridPathOptions &Options, const energy::GridEdgeCostFunc &InEdgeCost, const energy::GridCurvatureCostFunc &InCurvatureCost)
+            : Level(InLevel), MaskK(std::max(Options.MaskK, 1)), WeightHeuristic(Options.WeightHeuristic), EdgeCost(InEdgeCost), CurvatureCost(InCurvatureCost) {
+            ArrayList<std::array<int32_t, 2>> Directions;
+            for (int32_t dy = 0; dy <= MaskK; ++dy) {
+                for (int32_t dx = -MaskK; dx <= MaskK; ++dx) {
+                    if ((dy > 0 || dx > 0) && energy::GreatestCommonDivisor(std::abs(dx), std::abs(dy)) == 1) {
+                        Directions.push_back({dx, dy});
+                    }
+                }
+            }
+            for (size_t i = 0; i < Directions.size(); ++i) {
+                Steps.push_back(GridStep{Directions[i][0], Directions[i][1], i, false});
+                Steps.push_back(GridStep{-Directions[i][0], -Directions[i][1], i, true});
+            }
+
+            const size_t N = Level.Nx * Level.Ny;
+            const bool bCacheLayers = Directions.size() * N * sizeof(float) <= Options.EdgeCostCacheBytes;
+            if (bCacheLayers) {
+                Layers.resize(Directions.size() * N, 0.0f);
+            }
+
+            // One pass over every edge, tabulating it if allowed, to find the cheapest edge for the heuristic
+            float MinCost = std::numeric_limits<float>::max();
+            for (size_t l = 0; l < Directions.size(); ++l) {
+                const int32_t dx = Directions[l][0], dy = Directions[l][1];
+                float *Layer = bCacheLayers ? Layers.data() + l * N : nullptr;
+#pragma omp parallel for reduction(min : MinCost)
+                for (int64_t y = 0; y < int64_t(Level.Ny); ++y) {
+                    const int64_t ny = y + dy;
+                    if (ny >= int64_t(Level.Ny)) continue;
+                    for (int64_t x = 0; x < int64_t(Level.Nx); ++x) {
+                        const int64_t nx = x + dx;
+                        if (nx < 0 || nx >= int64_t(Level.Nx)) continue;
+                        const size_t From = x + y * Level.Nx;
+                        const size_t To = nx + ny * Level.Nx;
+                        const float Cost = EdgeCost(std::abs(Level.Height[From] - Level.Height[To]), std::abs(Level.Gradient[From] - Level.Gradient[To]));
+                        if (Layer) Layer[From] = Cost;
+                        MinCost = std::min(MinCost, Cost);
+                    }
+                }
+            }
+            if (MinCost < 0) {
+                throw std::runtime_error("[Roads] Graph should not have negative weight. Check your curve !");
+            }
+            MinEdgeCost = MinCost == std::numeric_limits<float>::max() ? 0.0f : MinCost;
+        }
+
+        /**
+         * @param Corridor optional per-cell mask, cells marked 0 are never entered
+         * @return false if Goal can't be reached
+         */
+        bool Search(uint32_t Start, uint32_t Goal, const uint8_t *Corridor, ArrayList<size_t> &OutPath) const {
+            constexpr uint32_t Invalid = std::numeric_limits<uint32_t>::max();
+            const size_t N = Level.Nx * Level.Ny;
+            const int64_t GoalX = Goal % Level.Nx, GoalY = Goal / Level.Nx;
+
+            ArrayList<float> CostTo(N, std::numeric_limits<float>::max());
+            ArrayList<uint32_t> Predecessor(N, Invalid);
+            ArrayList<uint8_t> Closed(N, 0);
+
+            auto Heuristic = [this, GoalX, GoalY](int64_t x, int64_t y) -> float {
+                const int64_t Chebyshev = std::max(std::abs(x - GoalX), std::abs(y - GoalY));
+                return WeightHeuristic * MinEdgeCost * float((Chebyshev + MaskK - 1) / MaskK);
+            };
+
+            using HeapEntry = std::pair<float, uint32_t>;
+            ArrayList<HeapEntry> Heap;
+            Heap.reserve(1024);
+            auto Push = [&Heap](float Priority, uint32_t Cell) {
+                Heap.emplace_back(Priority, Cell);
+                std::push_heap(Heap.begin(), Heap.end(), std::greater<HeapEntry>());
+            };
+
+            CostTo[Start] = 0.0f;
+            Predecessor[Start] = Start;
+            Push(Heuristic(Start % Level.Nx, Start / Level.Nx), Start);
+
+            while (!Heap.empty()) {
+                std::pop_heap(Heap.begin(), Heap.end(), std::greater<HeapEntry>());
+                const uint32_t Cell = Heap.back().second;
+                Heap.pop_back();
+
+                // Cells may be pushed several times, only the cheapest entry is expanded
+                if (Closed[Cell]) continue;
+                Closed[Cell] = 1;
+                if (Cell == Goal) break;
+
+                const int64_t x = Cell % Level.Nx, y = Cell / Level.Nx;
+                const uint32_t Prev = Predecessor[Cell];
+                for (const GridStep &Step: Steps) {
+                    const int64_t nx = x + Step.dx, ny = y + Step.dy;
+                    if (nx < 0 || ny < 0 || nx >= int64_t(Level.Nx) || ny >= int64_t(Level.Ny)) continue;
+                    const uint32_t Next = uint32_t(nx + ny * Level.Nx);
+                    if (Closed[Next] || (Corridor && !Corridor[Next])) continue;
+
+                    const float BendCost = CurvatureCost(std::abs(Curvature(Prev, Cell, Next)));
+                    if (BendCost < 0) {
+                        throw std::runtime_error("[Roads] Graph should not have negative weight. Check your curve !");
+                    }
+                    const float NewCost = CostTo[Cell] + StaticCost(Cell, Next, Step) + BendCost;
+                    if (NewCost < CostTo[Next]) {
+                        CostTo[Next] = NewCost;
+                        Predecessor[Next] = Cell;
+                        Push(NewCost + Heuristic(nx, ny), Next);
+                    }
+                }
+            }
+
+            if (Predecessor[Goal] == Invalid) {
+                return false;
+            }
+            OutPath.clear();
+            for (uint32_t Cell = Goal; Cell != Start; Cell = Predecessor[Cell]) {
+                OutPath.push_back(Cell);
+            }
+            OutPath.push_back(Start);
+            return true;
+        }
+
+    private:
+        float StaticCost(uint32_t From, uint32_t To, const GridStep &Step) const {
+            if (!Layers.empty()) {
+                return Layers[Step.Layer * Level.Nx * Level.Ny + (Step.bStoredAtTarget ? To : From)];
+            }
+            return EdgeCost(std::abs(Level.Height[From] - Level.Height[To]), std::abs(Level.Gradient[From] - Level.Gradient[To]));
+        }
+
+        // Curvature at B of the polyline A -> B -> C, in the same form as the legacy cost function
+        float Curvature(uint32_t A, uint32_t B, uint32_t C) const {
+            const float CellSize = Level.CellSize;
+            const Eigen::Vector3f PA(float(int64_t(A % Level.Nx)) * CellSize, float(int64_t(A / Level.Nx)) * CellSize, Level.Height[A]);
+            const Eigen::Vector3f PB(float(int64_t(B % Level.Nx)) * CellSize, float(int64_t(B / Level.Nx)) * CellSize, Level.Height[B]);
+            const Eigen::Vector3f PC(float(int64_t(C % Level.Nx)) * CellSize, float(int64_t(C / Level.Nx)) * CellSize, Level.Height[C]);
+
+            const Eigen::Vector3f BA = PA - PB;
+            const Eigen::Vector3f BC = PC - PB;
+            const float SquaredNorm_BC = BC.squaredNorm();
+            const float Norm_BA = BA.norm();
+            // Start cell is its own predecessor and has no incoming direction
+            const Eigen::Vector3f BA_Normalized = Norm_BA > 0 ? Eigen::Vector3f(BA / Norm_BA) : Eigen::Vector3f::Zero();
+            const Eigen::Vector3f BC_Normalized = BC / std::sqrt(SquaredNorm_BC);
+
+            return (BC_Normalized - BA_Normalized).norm() / SquaredNorm_BC * BC.z();
+        }
+
+        GridLevel Level;
+        int32_t MaskK;
+        float WeightHeuristic;
+        const energy::GridEdgeCostFunc &EdgeCost;
+        const energy::GridCurvatureCostFunc &CurvatureCost;
+
+        ArrayList<GridStep> Steps;
+        // Direction-major, NumDirections * Nx * Ny; empty if over the cache budget
+        ArrayList<float> Layers;
+        float MinEdgeCost = 0.0f;
+    };
+}// namespace
+
+ArrayList<size_t> roads::energy::GridShortestPath(size_t Nx, size_t Ny, const ArrayList<float> &Height, const ArrayList<float> &Gradient, size_t Start, size_t Goal, const GridPathOptions &Options, const GridEdgeCostFunc &EdgeCost, const GridCurvatureCostFunc &CurvatureCost) {
+    const size_t N = Nx * Ny;
+    if (N >= std::numeric_limits<uint32_t>::max() || Height.size() < N || Gradient.size() < N) {
+        throw std::runtime_error("[Roads] Bad grid size.");
+    }
+    if (Start >= N || Goal >= N) {
+        throw std::runtime_error("[Roads] Start or goal point is out of the grid.");
+    }
+
+    ArrayList<size_t> Path;
+    const GridLevel Fine{Nx, Ny, 1.0f, Height.data(), Gradient.data()};
+    const GridAStar FineSearch(Fine, Options, EdgeCost, CurvatureCost);
+
+    const size_t Factor = size_t(1) << std::clamp(Options.CoarseLevel, 0, 16);
+    const size_t CoarseNx = (Nx + Factor - 1) / Factor, CoarseNy = (Ny + Factor - 1) / Factor;
+    if (Factor > 1 && CoarseNx > 1 && CoarseNy > 1) {
+        // Coarse cells average the height and gradient of the fine cells they cover
+        ArrayList<float> CoarseHeight(CoarseNx * CoarseNy), CoarseGradient(CoarseNx * CoarseNy);
+#pragma omp parallel for
+        for (int64_t cy = 0; cy < int64_t(CoarseNy); ++cy) {
+            for (size_t cx = 0; cx < CoarseNx; ++cx) {
+                double SumHeight = 0.0, SumGradient = 0.0;
+                size_t Count = 0;
+                for (size_t y = cy * Factor; y < std::min(Ny, (cy + 1) * Factor); ++y) {
+                    for (size_t x = cx * Factor; x < std::min(Nx, (cx + 1) * Factor); ++x) {
+                        SumHeight += Height[x + y * Nx];
+                        SumGradient += Gradient[x + y * Nx];
+                        ++Count;
+                    }
+                }
+                CoarseHeight[cx + cy * CoarseNx] = float(SumHeight / double(Count));
+                CoarseGradient[cx + cy * CoarseNx] = float(SumGradient / double(Count));
+            }
+        }
+
+        auto ToCoarse = [Nx, Factor, CoarseNx](size_t Cell) -> uint32_t {
+            return uint32_t((Cell % Nx) / Factor + (Cell / Nx) / Factor * CoarseNx);
+        };
+
+        GridPathOptions CoarseOptions = Options;
+        CoarseOptions.CoarseLevel = 0;
+        const GridLevel Coarse{CoarseNx, CoarseNy, float(Factor), CoarseHeight.data(), CoarseGradient.data()};
+        ArrayList<size_t> CoarsePath;
+        if (GridAStar(Coarse, CoarseOptions, EdgeCost, CurvatureCost).Search(ToCoarse(Start), ToCoarse(Goal), nullptr, CoarsePath)) {
+            const int64_t Radius = std::max(Options.CorridorRadius, 0);
+            ArrayList<uint8_t> CoarseMask(CoarseNx * CoarseNy, 0);
+            for (size_t Cell: CoarsePath) {
+                const int64_t cx = Cell % CoarseNx, cy = Cell / CoarseNx;
+                for (int64_t y = std::max<int64_t>(cy - Radius, 0); y <= std::min<int64_t>(cy + Radius, CoarseNy - 1); ++y) {
+                    for (int64_t x = std::max<int64_t>(cx - Radius, 0); x <= std::min<int64_t>(cx + Radius, CoarseNx - 1); ++x) {
+                        CoarseMask[x + y * CoarseNx] = 1;
+                    }
+                }
+            }
+
+            ArrayList<uint8_t> Corridor(N);
+#pragma omp parallel for
+            for (int64_t i = 0; i < int64_t(N); ++i) {
+                Corridor[i] = CoarseMask[ToCoarse(i)];
+            }
+
+            if (FineSearch.Search(uint32_t(Start), uint32_t(Goal), Corridor.data(), Path)) {
+                return Path;
+            }
+        }
+        // No route inside the corridor, search the whole grid
+    }
+
+    FineSearch.Search(uint32_t(Start), uint32_t(Goal), nullptr, Path);
+    return Path;
+}
+
 tinyspline::BSpline spline::GenerateBSplineFromSegment(const ArrayList<std::array<float, 3>> &InPoints, const ArrayList<std::array<int, 2>> &Segments) {
     using namespace tinyspline;
 
@@ -8,7 +8,7 @@ using namespace Eigen;
 
 KDTreeNode::KDTreeNode(VectorXf Value) : Point(std::move(Value)) {}
 
-KDTreeNode* KDTree::BuildKdTree_Impl(ArrayList<VectorXf> Data, int64_t Lower, int64_t Upper, uint32_t Depth) {
+KDTreeNode* KDTree::BuildKdTree_Impl(ArrayList<VectorXf>& Data, int64_t Lower, int64_t Upper, uint32_t Depth) {
     if (Lower >= Upper) {
         return nullptr;
     }
@@ -31,7 +31,9 @@ KDTreeNode* KDTree::BuildKdTree_Impl(ArrayList<VectorXf> Data, int64_t Lower, in
 
 KDTree* KDTree::BuildKdTree(const ArrayList<VectorXf>& Data) {
     auto* NewTree = new KDTree;
-    auto* Root = (BuildKdTree_Impl(Data, 0, int64_t(Data.size() - 1), 0));
+    // Children only reorder their own range, so one working copy is enough
+    ArrayList<VectorXf> WorkingData = Data;
+    auto* Root = (BuildKdTree_Impl(WorkingData, 0, int64_t(Data.size() - 1), 0));
     NewTree->Root = std::shared_ptr<KDTreeNode>(Root);
 
     if (!NewTree->Root) {
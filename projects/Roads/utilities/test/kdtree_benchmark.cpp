@@ -0,0 +1,94 @@
+#include "roads/kdtree.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace roads;
+
+namespace {
+    template <typename Func>
+    double Measure(Func&& F) {
+        const auto Start = std::chrono::steady_clock::now();
+        F();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t NumPoints = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    const size_t NumQueries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+    const float Radius = 0.01f;
+    constexpr size_t K = 8;
+
+    std::mt19937 Rng(42);
+    std::uniform_real_distribution<float> Dist(0.f, 1.f);
+    ArrayList<Vector3f> Points(NumPoints);
+    ArrayList<VectorXf> DynamicPoints(NumPoints);
+    for (size_t Idx = 0; Idx < NumPoints; ++Idx) {
+        Points[Idx] = Vector3f(Dist(Rng), Dist(Rng), Dist(Rng));
+        DynamicPoints[Idx] = Points[Idx];
+    }
+    ArrayList<Vector3f> Queries(NumQueries);
+    for (Vector3f& Query : Queries) {
+        Query = Vector3f(Dist(Rng), Dist(Rng), Dist(Rng));
+    }
+
+    std::unique_ptr<KDTree> Tree;
+    const double TreeBuild = Measure([&] { Tree.reset(KDTree::BuildKdTree(DynamicPoints)); });
+    FlatKDTree3f FlatTree;
+    const double FlatBuild = Measure([&] { FlatTree.Build(Points); });
+
+    size_t TreeFound = 0, FlatFound = 0;
+    const double TreeRadius = Measure([&] {
+        for (const Vector3f& Query : Queries) {
+            TreeFound += Tree->SearchRadius(Query, Radius).size();
+        }
+    });
+    ArrayList<uint32_t> Indices;
+    const double FlatRadius = Measure([&] {
+        for (const Vector3f& Query : Queries) {
+            FlatFound += FlatTree.SearchRadius(Query, Radius, Indices);
+        }
+    });
+
+    Octree Oct(0.f, 1.f, 0.f, 1.f, 0.f, 1.f, 10);
+    const double OctreeBuild = Measure([&] {
+        for (Vector3f& Point : Points) {
+            Oct.addPoint(&Point);
+        }
+    });
+    size_t OctreeFound = 0;
+    const double OctreeRadius = Measure([&] {
+        for (const Vector3f& Query : Queries) {
+            OctreeFound += Oct.findPointsInRadius(Query.x(), Query.y(), Query.z(), Radius).size();
+        }
+    });
+
+    // Check k-NN against brute force on a few queries
+    size_t Mismatches = 0;
+    uint32_t KnnIndices[K];
+    float KnnDistances[K];
+    const double FlatKnn = Measure([&] {
+        for (const Vector3f& Query : Queries) {
+            FlatTree.SearchKNearest(Query, K, KnnIndices, KnnDistances);
+        }
+    });
+    for (size_t Q = 0; Q < std::min<size_t>(NumQueries, 100); ++Q) {
+        ArrayList<float> BruteForce(NumPoints);
+        for (size_t Idx = 0; Idx < NumPoints; ++Idx) {
+            BruteForce[Idx] = (Points[Idx] - Queries[Q]).squaredNorm();
+        }
+        std::partial_sort(BruteForce.begin(), BruteForce.begin() + K, BruteForce.end());
+        FlatTree.SearchKNearest(Queries[Q], K, KnnIndices, KnnDistances);
+        for (size_t Idx = 0; Idx < K; ++Idx) {
+            Mismatches += KnnDistances[Idx] != BruteForce[Idx];
+        }
+    }
+
+    printf("[Roads] %zu points, %zu queries\n", NumPoints, NumQueries);
+    printf("[Roads] KDTree      build %.4fs  radius %.4fs  (%zu found)\n", TreeBuild, TreeRadius, TreeFound);
+    printf("[Roads] Octree      build %.4fs  radius %.4fs  (%zu found)\n", OctreeBuild, OctreeRadius, OctreeFound);
+    printf("[Roads] FlatKDTree  build %.4fs  radius %.4fs  (%zu found)  %zu-NN %.4fs\n", FlatBuild, FlatRadius, FlatFound, K, FlatKnn);
+    printf("[Roads] FlatKDTree  %zu-NN mismatches against brute force: %zu\n", K, Mismatches);
+    return Mismatches == 0 ? 0 : 1;
+}
@@ -16,13 +16,16 @@
 
 #include "httplib/httplib.h"
 #include "msgpack/msgpack.h"
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <random>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -34,7 +37,11 @@
 #include <zeno/extra/GlobalState.h>
 #include <zeno/extra/GlobalStatus.h>
 #include <zeno/extra/GraphException.h>
+#include <zeno/extra/SubnetNode.h>
 #include <zeno/logger.h>
+#include <zeno/types/StringObject.h>
+#include <zeno/utils/safe_at.h>
+#include <zeno/utils/scope_exit.h>
 #include <zeno/types/PrimitiveObject.h>
 #include <zeno/unreal/UnrealTool.h>
 #include <zeno/unreal/ZenoRemoteTypes.h>
@@ -99,10 +106,54 @@ namespace zeno {
                 return ESubjectType::Mesh;
             } else if (InStr == "HeightField") {
                 return ESubjectType::HeightField;
+            } else if (InStr == "PackedMesh") {
+                return ESubjectType::PackedMesh;
             }
             return ESubjectType::Invalid;
         }
 
+        /**
+         * Last packed payload committed for a subject, and the patch from the one before it
+         */
+        struct SubjectPatchBase {
+            int32_t Version = -1;
+            std::vector<uint8_t> Data;
+            bool bHasPatch = false;
+            SubjectPatch Patch;
+        };
+
+        /**
+         * Clones of the outputs of a node taken right after it was applied
+         */
+        struct NodeSnapshot {
+            zany MutedOutput;
+            std::map<std::string, zany> Outputs;
+        };
+
+        /**
+         * Graph loaded for a session key, kept between runs so that a run of the same
+         * definition only applies the nodes affected by changed parameters
+         */
+        struct SessionGraph {
+            std::shared_ptr<zeno::Graph> Graph;
+            std::string Definition;
+            // nodes whose outputs are valid from the last run
+            zeno::dynamic_bitset Evaluated;
+            // parameter values seen by the last run, by name
+            std::map<std::string, ParamValue> AppliedParams;
+            // by node name, the outputs themselves may since be modified in place by
+            // their consumers, so a reused node hands clones of these to dirty ones
+            std::map<std::string, NodeSnapshot> Snapshots;
+
+            void Reset() {
+                Graph = nullptr;
+                Definition.clear();
+                Evaluated.clear();
+                AppliedParams.clear();
+                Snapshots.clear();
+            }
+        };
+
     }// namespace remote
 
 #define SERVER_HANDLER_WRAPPER(FUNC)                              \
@@ -131,10 +182,19 @@ namespace zeno {
         httplib::Server Srv;
         std::map<zeno::remote::SessionKeyType, remote::SubjectHistory> History;
         std::vector<std::string> Sessions;
+        std::map<zeno::remote::SessionKeyType,
+                 std::map<std::string, remote::SubjectPatchBase>>
+            PatchBases;
+        // Graphs run on the global session, one at a time
+        std::mutex RunGraphMutex;
+        std::map<zeno::remote::SessionKeyType, remote::SessionGraph> SessionGraphs;
 
     private:
         bool IsValidSession(const std::string &SessionKey) const;
         remote::SubjectHistory &GetGlobalHistory();
+        void CommitPatchBases(const std::set<std::string> &Changes,
+                              const zeno::remote::SessionKeyType &SessionKey,
+                              int32_t Version);
 
         static void OnError(const httplib::Request &Req, httplib::Response &Res);
 
@@ -142,12 +202,16 @@ namespace zeno {
         void NewSession(const httplib::Request &Req, httplib::Response &Res);
 
         void FetchDataDiff(const httplib::Request &Req, httplib::Response &Res);
-        static void PushData(const httplib::Request &Req, httplib::Response &Res);
+        void PushData(const httplib::Request &Req, httplib::Response &Res);
         void FetchData(const httplib::Request &Req, httplib::Response &Res);
 
         static void ParseGraphInfo(const httplib::Request &Req,
                                    httplib::Response &Res);
-        static void RunGraph(const httplib::Request &Req, httplib::Response &Res);
+        void RunGraph(const httplib::Request &Req, httplib::Response &Res);
+        static std::set<std::string>
+        CollectDirtyNodes(remote::SessionGraph &Cached,
+                          const zeno::remote::SessionKeyType &SessionKey,
+                          std::map<std::string, remote::ParamValue> &SeenParams);
 
         static void PushParameter(const httplib::Request &Req,
                                   httplib::Response &Res);
@@ -176,6 +240,8 @@ namespace zeno {
                 auto &HistoryObj = HistoryIter->second;
 
                 HistoryObj.Commit(Changes);
+                CommitPatchBases(Changes, SessionKey,
+                                 static_cast<int32_t>(HistoryObj.GetTopIndex()));
             };
             Srv.set_payload_max_length(1024 * 1024 * 1024);// 1 GB
             Srv.set_error_handler(OnError);
@@ -323,6 +389,27 @@ namespace zeno {
         auto Container = msgpack::unpack<remote::SubjectContainerList>(
             reinterpret_cast<const uint8_t *>(Body.data()), Body.size(), Err);
         if (!Err) {
+            // Patches are applied to the payload committed at their base version
+            auto &Bases = PatchBases[SessionKey];
+            for (remote::SubjectContainer &Subject: Container.Data) {
+                if (Subject.GetType() != remote::ESubjectType::Patch) {
+                    continue;
+                }
+                auto Patch = msgpack::unpack<remote::SubjectPatch>(Subject.Data, Err);
+                auto BaseIter = Bases.find(Subject.Name);
+                if (Err || BaseIter == Bases.end() ||
+                    BaseIter->second.Version != Patch.BaseVersion) {
+                    Res.status = 409;
+                    return;
+                }
+                std::vector<uint8_t> Data = BaseIter->second.Data;
+                if (!Patch.Apply(Data)) {
+                    Res.status = 409;
+                    return;
+                }
+                Subject.Type = Patch.SubjectType;
+                Subject.Data = std::move(Data);
+            }
             zeno::remote::StaticRegistry.Push(Container.Data, SessionKey);
             Res.status = 204;
         } else {
@@ -331,9 +418,10 @@ namespace zeno {
     }
 
     /**
- * GET /subject/fetch?key={string}&key={string}  ...
+ * GET /subject/fetch?key={string}&key={string}&since={int}  ...
  * return msgpack packed data of zeno::remote::SubjectContainerList, list will
- * be empty if nothing found
+ * be empty if nothing found. With `since`, the history version the client holds,
+ * packed subjects it has the previous payload of come as a Patch against it.
  */
     void ZenoRemoteServer::FetchData(const httplib::Request &Req,
                                      httplib::Response &Res) {
@@ -353,6 +441,10 @@ namespace zeno {
         auto &GlobalElements =
             GetOrCreate(remote::StaticRegistry.SessionalElements, std::string{""});
 
+        const int32_t ClientVersion =
+            Req.has_param("since") ? std::atoi(Req.get_param_value("since").c_str()) : -1;
+        auto &Bases = PatchBases[SessionKey];
+
         size_t Num = Req.get_param_value_count("key");
         remote::SubjectContainerList List;
         List.Data.reserve(Num);
@@ -360,7 +452,16 @@ namespace zeno {
             std::string Key = Req.get_param_value("key", Idx);
             auto Value = Elements.find(Key);
             if (Value != Elements.end()) {
-                List.Data.emplace_back(Value->second);
+                auto BaseIter = Bases.find(Key);
+                if (BaseIter != Bases.end() && BaseIter->second.bHasPatch &&
+                    BaseIter->second.Patch.BaseVersion <= ClientVersion &&
+                    ClientVersion < BaseIter->second.Version) {
+                    List.Data.push_back(remote::SubjectContainer{
+                        Key, static_cast<int16_t>(remote::ESubjectType::Patch),
+                        msgpack::pack(BaseIter->second.Patch)});
+                } else {
+                    List.Data.emplace_back(Value->second);
+                }
                 break;
             }
             Value = GlobalElements.find(Key);
@@ -452,6 +553,10 @@ namespace zeno {
  * POST /graph/run
  * BODY msgpack packed data of zeno::remote::GraphRunInfo
  * return msgpack packed data of zeno::remote::GraphRunResult
+ *
+ * Each session key keeps the graph of its last run, so a run with an unchanged
+ * definition only applies the nodes affected by changed parameters. Graphs run on
+ * the global session, one request at a time.
  */
     void ZenoRemoteServer::RunGraph(const httplib::Request &Req,
                                     httplib::Response &Res) {
@@ -461,33 +566,133 @@ namespace zeno {
         auto RunInfo = msgpack::unpack<zeno::remote::GraphRunInfo>(
             reinterpret_cast<const uint8_t *>(BodyStr.data()), BodyStr.size(), Err);
         if (!Err) {
+            std::lock_guard<std::mutex> Lock(RunGraphMutex);
+            remote::SessionGraph &Cached = SessionGraphs[SessionKey];
             try {
-                // Initialize graph
+                // Initialize graph, or reuse the one loaded from the same definition
                 auto &Session = zeno::getSession();
                 Session.globalState->clearState();
                 Session.globalComm->clearState();
                 Session.globalStatus->clearState();
-                auto Graph = Session.createGraph();
-                Graph->loadGraph(RunInfo.GraphDefinition.c_str());
+                if (!Cached.Graph || Cached.Definition != RunInfo.GraphDefinition) {
+                    Cached.Reset();
+                    auto NewGraph = Session.createGraph();
+                    NewGraph->loadGraph(RunInfo.GraphDefinition.c_str());
+                    Cached.Graph = std::move(NewGraph);
+                    Cached.Definition = RunInfo.GraphDefinition;
+                }
+                auto &Graph = Cached.Graph;
                 // Set input parameters
                 for (auto &Param: RunInfo.Values.Values) {
                     zeno::remote::StaticRegistry.SetParameter(SessionKey, Param.Name,
                                                               Param);
                 }
+                std::map<std::string, remote::ParamValue> SeenParams;
+                const std::set<std::string> DirtyNodes =
+                    CollectDirtyNodes(Cached, SessionKey, SeenParams);
+                // Dirty nodes left unapplied by this run (e.g. an untaken branch) must
+                // not keep the mark or snapshot of an earlier run
+                for (const auto &NodeName: DirtyNodes) {
+                    Cached.Evaluated.reset(Graph->nodes.at(NodeName)->nodeId);
+                    Cached.Snapshots.erase(NodeName);
+                }
+                // Dirty nodes read fresh clones of the reused outputs they depend on
+                std::set<std::string> Restored;
+                for (const auto &NodeName: DirtyNodes) {
+                    for (const auto &[InputName, Bound]: Graph->nodes.at(NodeName)->inputBounds) {
+                        auto SnapshotIter = Cached.Snapshots.find(Bound.first);
+                        if (DirtyNodes.count(Bound.first) ||
+                            SnapshotIter == Cached.Snapshots.end() ||
+                            !Restored.insert(Bound.first).second) {
+                            continue;
+                        }
+                        INode *Source = Graph->nodes.at(Bound.first).get();
+                        const remote::NodeSnapshot &Snapshot = SnapshotIter->second;
+                        Source->muted_output =
+                            Snapshot.MutedOutput ? Snapshot.MutedOutput->clone() : nullptr;
+                        for (const auto &[OutputName, Output]: Snapshot.Outputs) {
+                            Source->outputs[OutputName] = Output ? Output->clone() : nullptr;
+                        }
+                    }
+                }
+                Graph->onNodeApplied = [&Cached](INode *Node) {
+                    remote::NodeSnapshot Snapshot;
+                    bool bClonable = true;
+                    if (Node->muted_output) {
+                        Snapshot.MutedOutput = Node->muted_output->clone();
+                        bClonable = Snapshot.MutedOutput != nullptr;
+                    }
+                    for (const auto &[OutputName, Output]: Node->outputs) {
+                        zany Clone = Output ? Output->clone() : nullptr;
+                        bClonable = bClonable && (Clone || !Output);
+                        Snapshot.Outputs.emplace(OutputName, std::move(Clone));
+                    }
+                    // A node without a snapshot is never reused
+                    if (bClonable) {
+                        Cached.Snapshots.insert_or_assign(Node->myname, std::move(Snapshot));
+                    }
+                };
+                scope_exit HookGuard{[&] { Graph->onNodeApplied = nullptr; }};
                 remote::StaticFlags.CurrentSession = SessionKey;
+                scope_exit CurrentSessionGuard{
+                    [] { remote::StaticFlags.CurrentSession = ""; }};
                 Session.globalState->frameid = 0;
                 Session.globalComm->newFrame();
                 Session.globalState->frameBegin();
-                // Run graph
+                // Run graph, nodes left out of DirtyNodes keep the outputs of last run
                 while (Session.globalState->substepBegin()) {
-                    GraphException::catched([&] { Graph->applyNodesToExec(); },
-                                            *Session.globalStatus);
+                    GraphException::catched(
+                        [&] {
+                            Graph->ctx = std::make_unique<Context>();
+                            scope_exit ContextGuard{[&] { Graph->ctx = nullptr; }};
+                            for (const auto &[NodeName, Node]: Graph->nodes) {
+                                if (DirtyNodes.count(NodeName) == 0) {
+                                    Graph->ctx->visited.set(Node->nodeId);
+                                }
+                            }
+                            for (const auto &NodeName: Graph->nodesToExec) {
+                                Graph->applyNode(NodeName);
+                            }
+                            Cached.Evaluated.merge(Graph->ctx->visited);
+                        },
+                        *Session.globalStatus);
                     Session.globalState->substepEnd();
                 }
                 Session.globalComm->finishFrame();
-                remote::StaticFlags.CurrentSession = "";
+                if (Session.globalStatus->failed()) {
+                    // Outputs of a failed run are not trusted, next run starts over
+                    Cached.Reset();
+                } else {
+                    // Only parameters of declare nodes that were applied count as seen
+                    const INodeClass *DeclareNodeClass =
+                        zeno::safe_at(Session.nodeClasses, "DeclareRemoteParameter",
+                                      "node class not found")
+                            .get();
+                    for (const auto &[NodeName, Node]: Graph->nodes) {
+                        if (Node->nodeClass != DeclareNodeClass ||
+                            !Cached.Evaluated.test(Node->nodeId)) {
+                            continue;
+                        }
+                        auto InputIter = Node->inputs.find("name");
+                        auto *InputName =
+                            InputIter != Node->inputs.end()
+                                ? dynamic_cast<zeno::StringObject *>(InputIter->second.get())
+                                : nullptr;
+                        if (InputName == nullptr) {
+                            continue;
+                        }
+                        auto SeenIter = SeenParams.find(InputName->value);
+                        if (SeenIter != SeenParams.end()) {
+                            Cached.AppliedParams.insert_or_assign(SeenIter->first,
+                                                                  SeenIter->second);
+                        } else {
+                            Cached.AppliedParams.erase(InputName->value);
+                        }
+                    }
+                }
                 Res.status = 204;
             } catch (...) {
+                Cached.Reset();
                 Res.status = 400;
             }
         } else {
@@ -495,6 +700,96 @@ namespace zeno {
         }
     }
 
+    /**
+     * Find nodes of a cached graph to apply in the next run: nodes without valid
+     * outputs or a snapshot of them, parameters whose value changed since last run,
+     * other nodes reading the registry, subnets, keyframed or formula inputs, and all
+     * nodes downstream of them.
+     * @param SeenParams Receives the current value of every declared parameter
+     */
+    std::set<std::string>
+    ZenoRemoteServer::CollectDirtyNodes(remote::SessionGraph &Cached,
+                                        const zeno::remote::SessionKeyType &SessionKey,
+                                        std::map<std::string, remote::ParamValue> &SeenParams) {
+        auto &Graph = *Cached.Graph;
+        const INodeClass *DeclareNodeClass =
+            zeno::safe_at(zeno::getSession().nodeClasses, "DeclareRemoteParameter",
+                          "node class not found")
+                .get();
+
+        auto IsParameterChanged = [&](INode *Node) -> bool {
+            auto InputIter = Node->inputs.find("name");
+            zeno::StringObject *InputName =
+                InputIter != Node->inputs.end()
+                    ? dynamic_cast<zeno::StringObject *>(InputIter->second.get())
+                    : nullptr;
+            if (InputName == nullptr || Node->inputBounds.count("name")) {
+                return true;
+            }
+            const remote::ParamValue *Value =
+                zeno::remote::StaticRegistry.GetParameter(SessionKey, InputName->value);
+            auto LastIter = Cached.AppliedParams.find(InputName->value);
+            if (Value == nullptr) {
+                return LastIter != Cached.AppliedParams.end();
+            }
+            SeenParams.insert_or_assign(InputName->value, *Value);
+            if (LastIter == Cached.AppliedParams.end()) {
+                return true;
+            }
+            const remote::ParamValue &Last = LastIter->second;
+            return Value->Type != Last.Type || Value->NumericData != Last.NumericData ||
+                   Value->ComplexData != Last.ComplexData;
+        };
+
+        auto IsSource = [&](INode *Node) -> bool {
+            if (Node->nodeClass == DeclareNodeClass) {
+                // Always evaluated, to record the value in SeenParams
+                const bool bChanged = IsParameterChanged(Node);
+                return bChanged || !Cached.Evaluated.test(Node->nodeId) ||
+                       !Cached.Snapshots.count(Node->myname);
+            }
+            if (!Cached.Evaluated.test(Node->nodeId) || !Cached.Snapshots.count(Node->myname) ||
+                Graph.nodesToExec.count(Node->myname) || !Node->kframes.empty() ||
+                !Node->formulas.empty()) {
+                return true;
+            }
+            // The content of subnets is not inspected
+            if (dynamic_cast<SubnetNode *>(Node) != nullptr) {
+                return true;
+            }
+            // Other Unreal nodes read subjects that are pushed between runs
+            const auto &Categories = Node->nodeClass->desc->categories;
+            return std::find(Categories.begin(), Categories.end(), "Unreal") !=
+                   Categories.end();
+        };
+
+        std::map<INode *, bool> Memo;
+        std::function<bool(INode *)> IsDirty = [&](INode *Node) -> bool {
+            // A node met again before its result is known is on a cycle, keep it dirty
+            auto [MemoIter, bInserted] = Memo.try_emplace(Node, true);
+            if (!bInserted) {
+                return MemoIter->second;
+            }
+            bool bDirty = IsSource(Node);
+            for (const auto &[InputName, Bound]: Node->inputBounds) {
+                auto SourceIter = Graph.nodes.find(Bound.first);
+                if (SourceIter == Graph.nodes.end() || IsDirty(SourceIter->second.get())) {
+                    bDirty = true;
+                }
+            }
+            MemoIter->second = bDirty;
+            return bDirty;
+        };
+
+        std::set<std::string> DirtyNodes;
+        for (const auto &[NodeName, Node]: Graph.nodes) {
+            if (IsDirty(Node.get())) {
+                DirtyNodes.insert(NodeName);
+            }
+        }
+        return DirtyNodes;
+    }
+
     /**
  * GET /graph/param/push
  * BODY msgpack packed data of zeno::remote::ParamValueBatch
@@ -593,6 +888,34 @@ namespace zeno {
         return ParseSessionKey(Req.get_header_value(ZENO_SESSION_HEADER_NAME));
     }
 
+    /**
+     * Keep the payload of packed subjects committed at Version, and the patch from
+     * their previous payload, called with StaticRegistry.Mutex held
+     */
+    void ZenoRemoteServer::CommitPatchBases(const std::set<std::string> &Changes,
+                                            const zeno::remote::SessionKeyType &SessionKey,
+                                            int32_t Version) {
+        auto &Elements = zeno::remote::StaticRegistry.GetOrCreateSessionElement(SessionKey);
+        auto &Bases = PatchBases[SessionKey];
+        for (const std::string &Name: Changes) {
+            auto ElementIter = Elements.find(Name);
+            if (ElementIter == Elements.end() ||
+                ElementIter->second.GetType() != remote::ESubjectType::PackedMesh) {
+                Bases.erase(Name);
+                continue;
+            }
+            const remote::SubjectContainer &Subject = ElementIter->second;
+            remote::SubjectPatchBase &Base = Bases[Name];
+            // A patch touching every block is no smaller than the payload itself
+            Base.bHasPatch = Base.Version >= 0 && Base.Patch.Diff(Base.Data, Subject.Data) &&
+                             Base.Patch.Data.size() < Subject.Data.size();
+            Base.Patch.SubjectType = Subject.Type;
+            Base.Patch.BaseVersion = Base.Version;
+            Base.Version = Version;
+            Base.Data = Subject.Data;
+        }
+    }
+
     remote::SubjectHistory &ZenoRemoteServer::GetGlobalHistory() {
         auto HistoryIter = History.find("");
         if (HistoryIter == History.end()) {
@@ -623,12 +946,11 @@ namespace zeno {
             auto *PrimObj = safe_dynamic_cast<PrimitiveObject>(Node);
             std::vector<std::array<remote::AnyNumeric, 3>> verts;
             std::vector<std::array<int32_t, 3>> tris;
+            verts.reserve(PrimObj->verts.size());
             for (const std::array<float, 3> &data: PrimObj->verts) {
                 verts.push_back({data.at(0), data.at(2), data.at(1)});
             }
-            for (const std::array<int32_t, 3> &data: PrimObj->tris) {
-                tris.emplace_back(data);
-            }
+            tris.assign(PrimObj->tris.begin(), PrimObj->tris.end());
             remote::Mesh Mesh{std::move(verts), std::move(tris)};
             Mesh.Meta = InMeta;
             std::vector<uint8_t> Data = msgpack::pack(Mesh);
@@ -638,6 +960,35 @@ namespace zeno {
         }
     };
 
+    template<>
+    struct IObjectExtractor<remote::ESubjectType::PackedMesh> {
+        remote::SubjectContainer
+        operator()(IObject *Node, const std::string &InName = "",
+                   const std::map<std::string, std::string> &InMeta = {}) {
+            auto *PrimObj = safe_dynamic_cast<PrimitiveObject>(Node);
+            const size_t NumVerts = PrimObj->verts.size();
+            // Swap Y and Z as the Mesh extractor does
+            std::vector<float> Verts(NumVerts * 3);
+#pragma omp parallel for
+            for (intptr_t Idx = 0; Idx < static_cast<intptr_t>(NumVerts); ++Idx) {
+                const vec3f &Pos = PrimObj->verts[Idx];
+                Verts[Idx * 3 + 0] = Pos[0];
+                Verts[Idx * 3 + 1] = Pos[2];
+                Verts[Idx * 3 + 2] = Pos[1];
+            }
+            static_assert(sizeof(vec3i) == sizeof(int32_t) * 3);
+            remote::PackedMesh Mesh{
+                Verts.data(), NumVerts,
+                reinterpret_cast<const int32_t *>(PrimObj->tris.values.data()),
+                PrimObj->tris.size()};
+            Mesh.Meta = InMeta;
+            std::vector<uint8_t> Data = msgpack::pack(Mesh);
+            return remote::SubjectContainer{
+                InName, static_cast<int16_t>(remote::ESubjectType::PackedMesh),
+                std::move(Data)};
+        }
+    };
+
     template<>
     struct IObjectExtractor<remote::ESubjectType::HeightField> {
         remote::SubjectContainer
@@ -649,20 +1000,33 @@ namespace zeno {
                 // Currently height field are always square.
                 const auto N =
                     static_cast<int32_t>(std::round(std::sqrt(PrimObj->verts.size())));
-                std::vector<uint16_t> RemappedHeightFieldData;
-                RemappedHeightFieldData.reserve(PrimObj->verts.size());
-                for (float Height: HeightAttrs) {
-                    // Map height [-255, 255] in R to [0, UINT16_MAX] in Z
-                    constexpr uint16_t uint16Max = std::numeric_limits<uint16_t>::max();
-                    // LandscapeDataAccess.h:
-                    // static_cast<uint16>(FMath::RoundToInt(FMath::Clamp<float>(Height *
-                    // LANDSCAPE_INV_ZSCALE + MidValue, 0.f, MaxValue)))
-                    auto NewValue = static_cast<uint16_t>(
-                        std::round(zeno::clamp(Height * UE_LANDSCAPE_ZSCALE + 0x8000, 0.f,
-                                               static_cast<float>(uint16Max))));
-                    RemappedHeightFieldData.push_back(NewValue);
+                if (static_cast<size_t>(N) * N != HeightAttrs.size()) {
+                    log_error("HeightField must have a square number of points");
+                    return {std::string{},
+                            static_cast<int16_t>(remote::ESubjectType::Invalid),
+                            std::vector<uint8_t>{}};
+                }
+                // Remap straight into the rows, instead of a flat copy split afterwards
+                remote::HeightField HeightField;
+                HeightField.Nx = N;
+                HeightField.Ny = N;
+                HeightField.Data.resize(N);
+#pragma omp parallel for
+                for (int32_t Y = 0; Y < N; ++Y) {
+                    std::vector<uint16_t> &Row = HeightField.Data[Y];
+                    Row.resize(N);
+                    for (int32_t X = 0; X < N; ++X) {
+                        const float Height = HeightAttrs[static_cast<size_t>(Y) * N + X];
+                        // Map height [-255, 255] in R to [0, UINT16_MAX] in Z
+                        constexpr uint16_t uint16Max = std::numeric_limits<uint16_t>::max();
+                        // LandscapeDataAccess.h:
+                        // static_cast<uint16>(FMath::RoundToInt(FMath::Clamp<float>(Height *
+                        // LANDSCAPE_INV_ZSCALE + MidValue, 0.f, MaxValue)))
+                        Row[X] = static_cast<uint16_t>(
+                            std::round(zeno::clamp(Height * UE_LANDSCAPE_ZSCALE + 0x8000, 0.f,
+                                                   static_cast<float>(uint16Max))));
+                    }
                 }
-                remote::HeightField HeightField{N, N, RemappedHeightFieldData};
                 HeightField.Meta = InMeta;
                 std::vector<uint8_t> Data = msgpack::pack(HeightField);
                 return remote::SubjectContainer{
@@ -722,6 +1086,13 @@ namespace zeno {
                 zeno::remote::StaticRegistry.Push({
                     std::move(NewSubject),
                 });
+            } else if (processor_type == "PackedMesh") {
+                remote::SubjectContainer NewSubject =
+                    IObjectExtractor<remote::ESubjectType::PackedMesh>{}(prim.get(),
+                                                                         subject_name);
+                zeno::remote::StaticRegistry.Push({
+                    std::move(NewSubject),
+                });
             } else if (processor_type == "Points") {
                 remote::SubjectContainer NewSubject =
                     IObjectExtractor<remote::ESubjectType::PointSet>{}(prim.get(),
@@ -739,7 +1110,7 @@ namespace zeno {
     ZENO_DEFNODE(TransferPrimitiveToUnreal)
     ({
         {
-            {"enum StaticMeshNoUV HeightField", "type", "StaticMeshNoUV"},
+            {"enum StaticMeshNoUV PackedMesh HeightField", "type", "StaticMeshNoUV"},
             {"string", "name", "SubjectFromZeno"},
             {"prim"},
         },
@@ -752,7 +1123,7 @@ namespace zeno {
     ZENO_DEFNODE(SavePrimitiveToGlobalRegistry)
     ({
         {
-            {"enum StaticMeshNoUV HeightField", "type", "StaticMeshNoUV"},
+            {"enum StaticMeshNoUV PackedMesh HeightField", "type", "StaticMeshNoUV"},
             {"string", "name", "SubjectFromZeno"},
             {"prim"},
         },
@@ -786,6 +1157,27 @@ namespace zeno {
             return Prim;
         }
 
+        template<>
+        std::shared_ptr<zeno::PrimitiveObject>
+        ToPrimitiveObject(zeno::remote::PackedMesh &Data) {
+            std::shared_ptr<zeno::PrimitiveObject> Prim =
+                std::make_shared<zeno::PrimitiveObject>();
+            const std::vector<int32_t> Triangles = Data.GetTriangles();
+            const std::vector<float> Vertices = Data.GetVertices();
+            // Same axis order as the Mesh subject
+            Prim->tris.resize(Triangles.size() / 3);
+            for (size_t Idx = 0; Idx < Prim->tris.size(); ++Idx) {
+                Prim->tris[Idx] = {Triangles[Idx * 3], Triangles[Idx * 3 + 2],
+                                   Triangles[Idx * 3 + 1]};
+            }
+            Prim->verts.resize(Vertices.size() / 3);
+            for (size_t Idx = 0; Idx < Prim->verts.size(); ++Idx) {
+                Prim->verts[Idx] = {Vertices[Idx * 3], Vertices[Idx * 3 + 2],
+                                    Vertices[Idx * 3 + 1]};
+            }
+            return Prim;
+        }
+
         template<>
         std::shared_ptr<zeno::PrimitiveObject>
         ToPrimitiveObject(zeno::remote::HeightField &Data) {
@@ -809,6 +1201,14 @@ namespace zeno {
                 if (Data.has_value()) {
                     OutPrim = ToPrimitiveObject(Data.value());
                 }
+            } else if (Type == remote::ESubjectType::PackedMesh) {
+                std::optional<remote::PackedMesh> Data =
+                    remote::StaticRegistry.Get<remote::PackedMesh>(
+                        subject_name, zeno::remote::StaticFlags.GetCurrentSession(),
+                        true);
+                if (Data.has_value()) {
+                    OutPrim = ToPrimitiveObject(Data.value());
+                }
             } else if (Type == remote::ESubjectType::HeightField) {
                 std::optional<remote::HeightField> Data =
                     remote::StaticRegistry.Get<remote::HeightField>(
@@ -829,7 +1229,7 @@ namespace zeno {
     ZENO_DEFNODE(ReadPrimitiveFromRegistry)
     ({{
           {"string", "name", "SubjectFromZeno"},
-          {"enum StaticMeshNoUV HeightField", "type", "StaticMeshNoUV"},
+          {"enum StaticMeshNoUV PackedMesh HeightField", "type", "StaticMeshNoUV"},
           {"int", "nx", "0"},
           {"int", "ny", "0"},
           {"float", "scale", "250"},
@@ -912,6 +1312,11 @@ namespace zeno {
                     IObjectExtractor<remote::ESubjectType::Mesh>{}(Value.get(),
                                                                    SubjectName, Meta);
                 remote::StaticRegistry.Push({NewSubject}, SessionKey);
+            } else if (Type == remote::ESubjectType::PackedMesh) {
+                remote::SubjectContainer NewSubject =
+                    IObjectExtractor<remote::ESubjectType::PackedMesh>{}(Value.get(),
+                                                                         SubjectName, Meta);
+                remote::StaticRegistry.Push({NewSubject}, SessionKey);
             } else if (Type == remote::ESubjectType::HeightField) {
                 remote::SubjectContainer NewSubject =
                     IObjectExtractor<remote::ESubjectType::HeightField>{}(
@@ -932,7 +1337,7 @@ namespace zeno {
     ({{
           {"string", "name", "OutputA"},
           {"value"},
-          {"enum StaticMeshNoUV HeightField", "type", "StaticMeshNoUV"},
+          {"enum StaticMeshNoUV PackedMesh HeightField", "type", "StaticMeshNoUV"},
           {"meta"},
       },
       {},
@@ -518,9 +518,7 @@ inline
     } else {
         return; // Give up if vector is too large
     }
-    for (const auto &elem : value) {
-        serialized_object.emplace_back(elem);
-    }
+    serialized_object.insert(serialized_object.end(), value.begin(), value.end());
 }
 
 class Unpacker {
@@ -804,6 +802,7 @@ inline
 template<>
 inline
     void Unpacker::unpack_type(uint16_t &value) {
+    value = 0;
     if (safe_data() == uint16) {
         safe_increment();
         for (auto i = sizeof(uint16_t); i > 0; --i) {
@@ -823,6 +822,7 @@ inline
 template<>
 inline
     void Unpacker::unpack_type(uint32_t &value) {
+    value = 0;
     if (safe_data() == uint32) {
         safe_increment();
         for (auto i = sizeof(uint32_t); i > 0; --i) {
@@ -848,6 +848,7 @@ inline
 template<>
 inline
     void Unpacker::unpack_type(uint64_t &value) {
+    value = 0;
     if (safe_data() == uint64) {
         safe_increment();
         for (auto i = sizeof(uint64_t); i > 0; --i) {
@@ -5,7 +5,11 @@
 #include <string>
 #include <set>
 #include <map>
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #if defined(__clang__) || _MSC_VER >= 1900
 #define CONSTEXPR constexpr
@@ -25,6 +29,8 @@ enum class ESubjectType : int16_t {
     Mesh = 0,
     HeightField,
     PointSet,
+    PackedMesh,
+    Patch,
     Num,
 };
 
@@ -92,6 +98,147 @@ struct Mesh : public ZenoSubject<ESubjectType::Mesh> {
 
 };
 
+/**
+ * Copy values into a little-endian byte block, to ship arrays as a single msgpack bin
+ * @param InData First value
+ * @param Count Number of values
+ */
+template <typename T>
+std::vector<uint8_t> PackLittleEndian(const T* InData, size_t Count) {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic values are packed.");
+    std::vector<uint8_t> Result(Count * sizeof(T));
+    if (Count != 0) {
+        std::memcpy(Result.data(), InData, Result.size());
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t Idx = 0; Idx < Result.size(); Idx += sizeof(T)) {
+        std::reverse(Result.begin() + Idx, Result.begin() + Idx + sizeof(T));
+    }
+#endif
+    return Result;
+}
+
+/**
+ * Inverse of PackLittleEndian, trailing bytes not filling a whole value are ignored
+ */
+template <typename T>
+std::vector<T> UnpackLittleEndian(const std::vector<uint8_t>& InData) {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic values are packed.");
+    std::vector<T> Result(InData.size() / sizeof(T));
+    if (!Result.empty()) {
+        std::memcpy(Result.data(), InData.data(), Result.size() * sizeof(T));
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (T& Value : Result) {
+        auto* Bytes = reinterpret_cast<uint8_t*>(&Value);
+        std::reverse(Bytes, Bytes + sizeof(T));
+    }
+#endif
+    return Result;
+}
+
+/**
+ * @brief PackedMesh
+ * @note  Same content as Mesh, with vertices as little-endian float x, y, z and
+ *        triangles as little-endian int32 corners, each in one bin block.
+ */
+struct PackedMesh : public ZenoSubject<ESubjectType::PackedMesh> {
+    uint32_t NumVertices = 0;
+    uint32_t NumTriangles = 0;
+    std::vector<uint8_t> Vertices;
+    std::vector<uint8_t> Triangles;
+
+    PackedMesh() = default;
+
+    PackedMesh(const float* InVertices, size_t InNumVertices, const int32_t* InTriangles, size_t InNumTriangles)
+        : NumVertices(static_cast<uint32_t>(InNumVertices))
+        , NumTriangles(static_cast<uint32_t>(InNumTriangles))
+        , Vertices(PackLittleEndian(InVertices, InNumVertices * 3))
+        , Triangles(PackLittleEndian(InTriangles, InNumTriangles * 3))
+    {}
+
+    std::vector<float> GetVertices() const {
+        return UnpackLittleEndian<float>(Vertices);
+    }
+
+    std::vector<int32_t> GetTriangles() const {
+        return UnpackLittleEndian<int32_t>(Triangles);
+    }
+
+    template <class T>
+    void pack(T& pack) {
+        ZenoSubject::pack(pack);
+        pack(NumVertices, NumTriangles, Vertices, Triangles);
+    }
+};
+
+/**
+ * @brief SubjectPatch
+ * @note  Blocks of a subject's packed data that changed since the version a client
+ *        already holds, sent in a SubjectContainer of type Patch with the subject's name.
+ */
+struct SubjectPatch : public ZenoSubject<ESubjectType::Patch> {
+    inline static constexpr uint32_t DefaultBlockSize = 4096;
+
+    int16_t/* ESubjectType */ SubjectType = 0;
+    int32_t BaseVersion = -1;
+    uint32_t Size = 0;
+    uint32_t BlockSize = DefaultBlockSize;
+    std::vector<uint32_t> Blocks;
+    std::vector<uint8_t> Data;
+
+    /**
+     * Diff two packed payloads of the same size
+     * @return false if sizes differ, the patch is left empty then
+     */
+    bool Diff(const std::vector<uint8_t>& Base, const std::vector<uint8_t>& Current) {
+        Blocks.clear();
+        Data.clear();
+        Size = static_cast<uint32_t>(Current.size());
+        if (Base.size() != Current.size()) {
+            return false;
+        }
+        for (size_t Offset = 0; Offset < Current.size(); Offset += BlockSize) {
+            const size_t Length = std::min<size_t>(BlockSize, Current.size() - Offset);
+            if (std::memcmp(Base.data() + Offset, Current.data() + Offset, Length) != 0) {
+                Blocks.push_back(static_cast<uint32_t>(Offset / BlockSize));
+                Data.insert(Data.end(), Current.begin() + Offset, Current.begin() + Offset + Length);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Apply on the payload of BaseVersion
+     * @return false if the patch doesn't fit InOutData
+     */
+    bool Apply(std::vector<uint8_t>& InOutData) const {
+        if (InOutData.size() != Size || BlockSize == 0) {
+            return false;
+        }
+        size_t Cursor = 0;
+        for (uint32_t Block : Blocks) {
+            const size_t Offset = static_cast<size_t>(Block) * BlockSize;
+            if (Offset >= Size) {
+                return false;
+            }
+            const size_t Length = std::min<size_t>(BlockSize, Size - Offset);
+            if (Cursor + Length > Data.size()) {
+                return false;
+            }
+            std::memcpy(InOutData.data() + Offset, Data.data() + Cursor, Length);
+            Cursor += Length;
+        }
+        return true;
+    }
+
+    template <class T>
+    void pack(T& pack) {
+        ZenoSubject::pack(pack);
+        pack(SubjectType, BaseVersion, Size, BlockSize, Blocks, Data);
+    }
+};
+
 enum class EParamType : int8_t {
     Invalid = -1,
     Float = 0,
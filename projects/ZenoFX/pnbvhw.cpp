@@ -1,4 +1,4 @@
-#include "LinearBvh.h"
+#include <zeno/types/LinearBvh.h>
 #include <limits>
 #include <zeno/zeno.h>
 #include <zeno/types/StringObject.h>
@@ -111,6 +111,81 @@ static void bvh_vectors_wrangle(zfx::x64::Executable *exec,
   }
 }
 
+// gathers the neighbors of each particle first and executes them SimdWidth
+// pairs at a time, every lane accumulating into its own copy of the particle
+// channels, whose changes are summed and written back once per particle; the
+// result only matches bvh_vectors_wrangle for additive updates like `@rho += ...`
+static void bvh_vectors_wrangle_batched(zfx::x64::Executable *exec,
+                                std::vector<Buffer> const &chs,
+                                std::vector<Buffer> const &chs2,
+                                std::vector<zeno::vec3f> const &pos,
+                                std::vector<zeno::vec3f> const &opos,
+                                bool isBox, float radius2,
+                                zeno::LBvh *lbvh) {
+  if (chs.size() == 0)
+    return;
+
+  constexpr int width = zfx::x64::Executable::SimdWidth;
+#pragma omp parallel
+  {
+    auto ctx = exec->make_context();
+    std::vector<int> neighbors;
+    std::vector<float> init(chs.size());
+    std::vector<float> saved(chs.size() * width);
+#pragma omp for
+    for (int i = 0; i < pos.size(); i++) {
+      neighbors.clear();
+      lbvh->iter_neighbors(pos[i], [&](int pid) {
+        if (!isBox)
+          if (lengthSquared(pos[i] - opos[pid]) > radius2)
+            return;
+        neighbors.push_back(pid);
+      });
+      if (neighbors.empty())
+        continue;
+
+      for (int k = 0; k < chs.size(); k++) {
+        if (!chs[k].which) {
+          init[k] = chs[k].base[chs[k].stride * i];
+          for (int lane = 0; lane < width; lane++)
+            ctx.channel(k)[lane] = init[k];
+        }
+      }
+      for (size_t j = 0; j < neighbors.size(); j += width) {
+        // a partial batch repeats its last pair and drops what the extra lanes did
+        int active = std::min<size_t>(width, neighbors.size() - j);
+        for (int k = 0; k < chs.size(); k++) {
+          if (chs[k].which) {
+            for (int lane = 0; lane < width; lane++) {
+              auto pid = neighbors[j + std::min(lane, active - 1)];
+              ctx.channel(k)[lane] = chs2[k].base[chs2[k].stride * pid];
+            }
+          } else if (active < width) {
+            for (int lane = active; lane < width; lane++)
+              saved[k * width + lane] = ctx.channel(k)[lane];
+          }
+        }
+        ctx.execute();
+        if (active < width) {
+          for (int k = 0; k < chs.size(); k++) {
+            if (!chs[k].which)
+              for (int lane = active; lane < width; lane++)
+                ctx.channel(k)[lane] = saved[k * width + lane];
+          }
+        }
+      }
+      for (int k = 0; k < chs.size(); k++) {
+        if (!chs[k].which) {
+          float value = init[k];
+          for (int lane = 0; lane < width; lane++)
+            value += ctx.channel(k)[lane] - init[k];
+          chs[k].base[chs[k].stride * i] = value;
+        }
+      }
+    }
+  }
+}
+
 static void bvh_vectors_wrangle_radius_two(zfx::x64::Executable *exec,
                                 std::vector<Buffer> const &chs,
                                 std::vector<Buffer> const &chs2,
@@ -185,7 +260,25 @@ static void bvh_vectors_wrangle_radius_two(zfx::x64::Executable *exec,
   }
 }
 
+// the bvh of the previous run is refitted instead of rebuilt while its quality
+// holds; the node's own "lbvh" output of the last run is dropped first, so any
+// remaining reference means a downstream node kept the tree and it is copied
+template <class... Args>
+static std::shared_ptr<zeno::LBvh> cachedBvh(zeno::INode *node,
+                                             std::shared_ptr<zeno::LBvh> &cache,
+                                             Args &&...args) {
+  node->outputs.erase("lbvh");
+  if (!cache)
+    cache = std::make_shared<zeno::LBvh>();
+  else if (cache.use_count() > 1)
+    cache = std::make_shared<zeno::LBvh>(*cache);
+  cache->refitOrBuild(std::forward<Args>(args)...);
+  return cache;
+}
+
 struct ParticlesBuildBvh : zeno::INode {
+  std::shared_ptr<zeno::LBvh> lbvh;
+
   virtual void apply() override {
     auto primNei = get_input<zeno::PrimitiveObject>("primNei");
     float radius = get_input<zeno::NumericObject>("radius")->get<float>();
@@ -193,9 +286,8 @@ struct ParticlesBuildBvh : zeno::INode {
         has_input("radiusMin")
             ? get_input<zeno::NumericObject>("radiusMin")->get<float>()
             : -1.f;
-    auto lbvh = std::make_shared<zeno::LBvh>(
-        primNei, radius, zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
-    set_output("lbvh", std::move(lbvh));
+    set_output("lbvh", cachedBvh(this, lbvh, primNei, radius, std::string{},
+                                 zeno::LBvh::element_c<zeno::LBvh::element_e::point>));
   }
 };
 
@@ -209,6 +301,8 @@ ZENDEFNODE(ParticlesBuildBvh, {
                               });
 
 struct BuildPrimitiveBvh : zeno::INode {
+  std::shared_ptr<zeno::LBvh> lbvh;
+
   virtual void apply() override {
     auto prim = get_input<zeno::PrimitiveObject>("prim");
     float thickness =
@@ -217,24 +311,19 @@ struct BuildPrimitiveBvh : zeno::INode {
             : 0.f;
     auto primType = get_param<std::string>("prim_type");
     if (primType == "auto") {
-      auto lbvh = std::make_shared<zeno::LBvh>(prim, thickness);
-      set_output("lbvh", std::move(lbvh));
+      set_output("lbvh", cachedBvh(this, lbvh, prim, thickness, std::string{}));
     } else if (primType == "point") {
-      auto lbvh = std::make_shared<zeno::LBvh>(
-          prim, thickness, zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
-      set_output("lbvh", std::move(lbvh));
+      set_output("lbvh", cachedBvh(this, lbvh, prim, thickness, std::string{},
+                                   zeno::LBvh::element_c<zeno::LBvh::element_e::point>));
     } else if (primType == "line") {
-      auto lbvh = std::make_shared<zeno::LBvh>(
-          prim, thickness, zeno::LBvh::element_c<zeno::LBvh::element_e::line>);
-      set_output("lbvh", std::move(lbvh));
+      set_output("lbvh", cachedBvh(this, lbvh, prim, thickness, std::string{},
+                                   zeno::LBvh::element_c<zeno::LBvh::element_e::line>));
     } else if (primType == "tri") {
-      auto lbvh = std::make_shared<zeno::LBvh>(
-          prim, thickness, zeno::LBvh::element_c<zeno::LBvh::element_e::tri>);
-      set_output("lbvh", std::move(lbvh));
+      set_output("lbvh", cachedBvh(this, lbvh, prim, thickness, std::string{},
+                                   zeno::LBvh::element_c<zeno::LBvh::element_e::tri>));
     } else if (primType == "quad") {
-      auto lbvh = std::make_shared<zeno::LBvh>(
-          prim, thickness, zeno::LBvh::element_c<zeno::LBvh::element_e::tet>);
-      set_output("lbvh", std::move(lbvh));
+      set_output("lbvh", cachedBvh(this, lbvh, prim, thickness, std::string{},
+                                   zeno::LBvh::element_c<zeno::LBvh::element_e::tet>));
     }
   }
 };
@@ -248,13 +337,14 @@ ZENDEFNODE(BuildPrimitiveBvh,
            });
 
 struct ParticlesBuildBvhRadius : zeno::INode {
+  std::shared_ptr<zeno::LBvh> lbvh;
+
   virtual void apply() override {
     auto prim = get_input<zeno::PrimitiveObject>("primNei");
     float radius = get_input2<float>("basicRadius");
     auto radiusAttr = get_input2<std::string>("radiusAttr");
-    auto lbvh = std::make_shared<zeno::LBvh>(
-        prim, radius, radiusAttr, zeno::LBvh::element_c<zeno::LBvh::element_e::point>);
-    set_output("lbvh", std::move(lbvh));
+    set_output("lbvh", cachedBvh(this, lbvh, prim, radius, radiusAttr,
+                                 zeno::LBvh::element_c<zeno::LBvh::element_e::point>));
   }
 };
 
@@ -941,9 +1031,11 @@ struct ParticlesNeighborBvhWrangle : zeno::INode {
       chs2[i] = iob;
     }
 
-    bvh_vectors_wrangle(exec, chs, chs2, prim->attr<zeno::vec3f>("pos"),
-                        primNei->attr<zeno::vec3f>("pos"), get_input2<bool>("is_box"),
-                        lbvh.get()->thickness * lbvh.get()->thickness, lbvh.get());
+    auto wrangle = get_input2<bool>("batched") ? bvh_vectors_wrangle_batched
+                                               : bvh_vectors_wrangle;
+    wrangle(exec, chs, chs2, prim->attr<zeno::vec3f>("pos"),
+            primNei->attr<zeno::vec3f>("pos"), get_input2<bool>("is_box"),
+            lbvh.get()->thickness * lbvh.get()->thickness, lbvh.get());
 
     set_output("prim", std::move(prim));
   }
@@ -955,6 +1047,7 @@ ZENDEFNODE(ParticlesNeighborBvhWrangle,
                 {"PrimitiveObject", "primNei"},
                 {"LBvh", "lbvh"},
                 {"bool", "is_box", "1"},
+                {"bool", "batched", "0"},
                 {"string", "zfxCode"},
                 {"DictObject:NumericObject", "params"}},
                {{"PrimitiveObject", "prim"}},
@@ -32,6 +32,10 @@ namespace {
     //   Z:/ZenusTech/Models/out000042.obj
     //
     struct StringEval : zeno::INode {
+        StringEval() {
+            bReusableTemp = true;
+        }
+
         virtual void apply() override {
             auto code = get_input2<std::string>("zfxCode");
 
@@ -8,7 +8,7 @@
 #include <openvdb/tools/Interpolation.h>
 #include <zeno/utils/variantswitch.h>
 #include <zeno/utils/arrayindex.h>
-#include <zeno/utils/perlin.h>
+#include <zeno/funcs/NoiseBatch.h>
 #include <zeno/utils/vec.h>
 #include <zeno/utils/log.h>
 #include <zeno/utils/zeno_p.h>
@@ -44,29 +44,30 @@ struct VDBPerlinNoise : INode {
     scale3d *= scale * dx;
 
     auto wrangler = [&](auto &leaf, openvdb::Index leafpos) {
-        for (auto iter = leaf.beginValueOn(); iter != leaf.endValueOn(); ++iter) {
+        using OutT = typename fuck_openvdb_vec<std::decay_t<
+            typename std::decay_t<decltype(leaf)>::ValueType>>::type;
+        std::vector<zeno::vec3f> pos;
+        pos.reserve(leaf.onVoxelCount());
+        for (auto iter = leaf.cbeginValueOn(); iter; ++iter) {
             auto coord = iter.getCoord();
-            using OutT = typename fuck_openvdb_vec<std::decay_t<
-                typename std::decay_t<decltype(leaf)>::ValueType>>::type;
-            OutT noise;
-            {
-                zeno::vec3f p(coord[0], coord[1], coord[2]);
-                p = scale3d * (p - offset);
-                OutT o;
-                if constexpr (std::is_same_v<OutT, float>) {
-                    o = PerlinNoise::perlin(p, roughness, detail);
-                } else if constexpr (std::is_same_v<OutT, zeno::vec3f>) {
-                    o = OutT(
-                        PerlinNoise::perlin(zeno::vec3f(p[0], p[1], p[2]), roughness, detail),
-                        PerlinNoise::perlin(zeno::vec3f(p[1], p[2], p[0]), roughness, detail),
-                        PerlinNoise::perlin(zeno::vec3f(p[2], p[0], p[1]), roughness, detail));
-                } else {
-                    throw makeError<TypeError>(typeid(zeno::vec3f), typeid(OutT), "outType");
-                }
-                noise = average + o * strength;
-            }
+            zeno::vec3f p(coord[0], coord[1], coord[2]);
+            pos.push_back(scale3d * (p - offset));
+        }
+        std::vector<OutT> noise(pos.size());
+        if constexpr (std::is_same_v<OutT, float>) {
+            noiseFractalPerlinBatch(pos.data(), noise.data(), pos.size(), roughness, detail);
+        } else if constexpr (std::is_same_v<OutT, zeno::vec3f>) {
+            for (int c = 0; c < 3; c++)
+                noiseFractalPerlinBatch(pos.data(), reinterpret_cast<float *>(noise.data()) + c, pos.size(),
+                                        roughness, detail, c, 3);
+        } else {
+            throw makeError<TypeError>(typeid(zeno::vec3f), typeid(OutT), "outType");
+        }
+        std::size_t i = 0;
+        for (auto iter = leaf.beginValueOn(); iter; ++iter, ++i) {
+            auto o = average + noise[i] * strength;
             iter.modifyValue([&] (auto &v) {
-                v += noise;
+                v += o;
             });
         }
     };
@@ -266,8 +266,16 @@ void killProgram() {
     killProgramJSON();
 }
 
+void initZenCacheBudget()
+{
+    QSettings settings(zsCompanyName, zsEditor);
+    size_t budgetMB = settings.value(zsCacheMemBudget).toInt();
+    zeno::getSession().globalComm->frameCacheBudget(budgetMB << 20);
+}
+
 bool initZenCache(char* pCachePath, int& cacheNum)
 {
+    initZenCacheBudget();
     QSettings settings(zsCompanyName, zsEditor);
     const QString& cachenum = settings.value("zencachenum").toString();
     bool bEnableCache = settings.value("zencache-enable").toBool();
@@ -26,6 +26,7 @@ struct LAUNCH_PARAM {
 
 void launchProgram(IGraphsModel *pModel, LAUNCH_PARAM param);
 bool initZenCache(char* cachedir, int& cacheNum);
+void initZenCacheBudget();
 void killProgram();
 
 #endif
@@ -114,7 +114,9 @@ static void getOptStr(const QString& sockType, QVariant& defl, QString& opStr)
     }
 }
 
-static void serializeGraph(IGraphsModel* pGraphsModel, const QModelIndex& subgIdx, QString const &graphIdPrefix, bool bView, RAPIDJSON_WRITER& writer, LAUNCH_PARAM launchParam, bool bNestedSubg = true)
+//pSubgDefs: if not null, subgraph nodes that are not viewed are emitted as `addSubgraphInstance`
+//referring to a shared definition, and the names of the used definitions are collected into it.
+static void serializeGraph(IGraphsModel* pGraphsModel, const QModelIndex& subgIdx, QString const &graphIdPrefix, bool bView, RAPIDJSON_WRITER& writer, LAUNCH_PARAM launchParam, bool bNestedSubg = true, QSet<QString>* pSubgDefs = nullptr)
 {
     ZASSERT_EXIT(pGraphsModel && subgIdx.isValid());
 
@@ -188,12 +190,21 @@ static void serializeGraph(IGraphsModel* pGraphsModel, const QModelIndex& subgId
             }
             else
             {
-                AddStringList({"addSubnetNode", name, ident}, writer);
-                AddStringList({"pushSubnetScope", ident}, writer);
                 const QString& prefix = nameMangling(graphIdPrefix, idx.data(ROLE_OBJID).toString());
                 bool _bView = bView && (idx.data(ROLE_OPTIONS).toInt() & OPT_VIEW);
-                serializeGraph(pGraphsModel, pGraphsModel->index(name), prefix, _bView, writer, launchParam, true);
-                AddStringList({"popSubnetScope", ident}, writer);
+                if (pSubgDefs && !_bView)
+                {
+                    //the runtime builds the inner nodes from the shared definition, named as if inlined.
+                    AddStringList({"addSubgraphInstance", name, ident, prefix}, writer);
+                    pSubgDefs->insert(name);
+                }
+                else
+                {
+                    AddStringList({"addSubnetNode", name, ident}, writer);
+                    AddStringList({"pushSubnetScope", ident}, writer);
+                    serializeGraph(pGraphsModel, pGraphsModel->index(name), prefix, _bView, writer, launchParam, true, pSubgDefs);
+                    AddStringList({"popSubnetScope", ident}, writer);
+                }
             }
         }
 
@@ -471,7 +482,22 @@ static void serializeGraph(IGraphsModel* pGraphsModel, const QModelIndex& subgId
 
 void serializeScene(IGraphsModel* pModel, RAPIDJSON_WRITER& writer, LAUNCH_PARAM param)
 {
-    serializeGraph(pModel, pModel->index("main"), "", true, writer, param, true);
+    QSet<QString> subgDefs;
+    serializeGraph(pModel, pModel->index("main"), "", true, writer, param, true, &subgDefs);
+
+    //every used subgraph is serialized once, definitions may instance other definitions.
+    QSet<QString> serialized;
+    while (serialized.size() < subgDefs.size())
+    {
+        const QSet<QString> pending = subgDefs - serialized;
+        for (const QString& subgName : pending)
+        {
+            AddStringList({"beginSubgraphDef", subgName}, writer);
+            serializeGraph(pModel, pModel->index(subgName), "", false, writer, param, true, &subgDefs);
+            AddStringList({"endSubgraphDef", subgName}, writer);
+            serialized.insert(subgName);
+        }
+    }
 }
 
 static void serializeSceneOneGraph(IGraphsModel* pModel, RAPIDJSON_WRITER& writer, QString subgName)
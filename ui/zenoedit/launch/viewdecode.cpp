@@ -62,6 +62,7 @@ struct PacketProc {
             //zeno::log_debug("PacketProc::clearGlobalStateIfNeeded: globalStateNeedClean");
             zeno::getSession().globalComm->clearState();
             zeno::getSession().globalComm->frameCache(fcPath, fcMax);
+            initZenCacheBudget();
             globalCommNeedClean = 0;
         }
         if (globalCommNeedNewFrame) {
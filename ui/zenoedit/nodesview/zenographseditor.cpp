@@ -23,6 +23,9 @@
 #include <zenomodel/include/nodesmgr.h>
 #include "settings/zenosettingsmanager.h"
 #include <zenoui/comctrl/zpathedit.h>
+#include "launch/corelaunch.h"
+#include <zeno/core/Session.h>
+#include <zeno/extra/GlobalComm.h>
 
 
 ZenoGraphsEditor::ZenoGraphsEditor(ZenoMainWindow* pMainWin)
@@ -998,12 +1001,14 @@ void ZenoGraphsEditor::onAction(QAction* pAction, const QVariantList& args, bool
         QVariant varCacheRoot = inst.getValue("zencachedir");
         QVariant varCacheNum = inst.getValue("zencachenum");
         QVariant varAutoCleanCache = inst.getValue("zencache-autoclean");
+        QVariant varMemBudget = inst.getValue(zsCacheMemBudget);
 
         bool bEnableCache = varEnableCache.isValid() ? varEnableCache.toBool() : false;
         bool bTempCacheDir = varTempCacheDir.isValid() ? varTempCacheDir.toBool() : false;
         QString cacheRootDir = varCacheRoot.isValid() ? varCacheRoot.toString() : "";
         int cacheNum = varCacheNum.isValid() ? varCacheNum.toInt() : 1;
         bool bAutoCleanCache = varAutoCleanCache.isValid() ? varAutoCleanCache.toBool() : true;
+        int memBudget = varMemBudget.isValid() ? varMemBudget.toInt() : 0;
 
         CALLBACK_SWITCH cbSwitch = [=](bool bOn) {
             zenoApp->getMainWindow()->setInDlgEventLoop(bOn); //deal with ubuntu dialog slow problem when update viewport.
@@ -1045,6 +1050,17 @@ void ZenoGraphsEditor::onAction(QAction* pAction, const QVariantList& args, bool
             pAutoCleanCache->setEnabled(state && !pTempCacheDir->isChecked());
         });
 
+        QSpinBox* pMemBudget = new QSpinBox;
+        pMemBudget->setRange(0, std::numeric_limits<int>::max());
+        pMemBudget->setSuffix(" MB");
+        pMemBudget->setSpecialValueText(tr("Unlimited"));
+        pMemBudget->setValue(memBudget);
+
+        auto stats = zeno::getSession().globalComm->cacheStats();
+        QLabel* pCacheStats = new QLabel(tr("%1 MB in %2 frames, %3 frames spilled, %4 evictions")
+            .arg((stats.memBytes + stats.decodedBytes) >> 20).arg(stats.framesInMemory)
+            .arg(stats.framesSpilled).arg(stats.evictions));
+
         QDialogButtonBox* pButtonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
 
         QDialog dlg(this);
@@ -1059,7 +1075,11 @@ void ZenoGraphsEditor::onAction(QAction* pAction, const QVariantList& args, bool
         pLayout->addWidget(pathLineEdit, 3, 1);
         pLayout->addWidget(new QLabel(tr("Cache auto clean up")), 4, 0);
         pLayout->addWidget(pAutoCleanCache, 4, 1);
-        pLayout->addWidget(pButtonBox, 5, 1);
+        pLayout->addWidget(new QLabel(tr("Memory budget")), 5, 0);
+        pLayout->addWidget(pMemBudget, 5, 1);
+        pLayout->addWidget(new QLabel(tr("Frame cache")), 6, 0);
+        pLayout->addWidget(pCacheStats, 6, 1);
+        pLayout->addWidget(pButtonBox, 7, 1);
 
         connect(pButtonBox, SIGNAL(accepted()), &dlg, SLOT(accept()));
         connect(pButtonBox, SIGNAL(rejected()), &dlg, SLOT(reject()));
@@ -1072,6 +1092,8 @@ void ZenoGraphsEditor::onAction(QAction* pAction, const QVariantList& args, bool
             inst.setValue("zencachedir", pathLineEdit->text());
             inst.setValue("zencachenum", pSpinBox->value());
             inst.setValue("zencache-autoclean", pAutoCleanCache->checkState() == Qt::Checked);
+            inst.setValue(zsCacheMemBudget, pMemBudget->value());
+            initZenCacheBudget();
         }
     }
     else if (actionType == ZenoMainWindow::ACTION_ZOOM) 
@@ -17,6 +17,7 @@ const char* const zsCacheAutoRemove = "zencache-autoremove";
 const char* const zsCacheDir= "zencachedir";
 const char* const zsCacheNum = "zencachenum";
 const char* const zsCacheAutoClean = "zencache-autoclean";
+const char* const zsCacheMemBudget = "zencache-membudget";
 const char* const zsEnableShiftChangeFOV = "viewport-EnableShiftChangeFOV";
 const char* const zsViewportPointSizeScale = "viewport-PointSizeScale";
 const char* const zsSubgraphType = "SubgraphType";
@@ -4,13 +4,16 @@
 #include <zeno/core/IObject.h>
 #include <zeno/utils/safe_dynamic_cast.h>
 #include <zeno/types/UserData.h>
+#include <zeno/utils/dynamic_bitset.h>
 #include <functional>
 #include <variant>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <set>
 #include <any>
 #include <map>
+#include <vector>
 
 namespace zeno {
 
@@ -18,12 +21,14 @@ struct Session;
 struct SubgraphNode;
 struct DirtyChecker;
 struct INode;
+struct INodeClass;
+struct SubgraphLibrary;
 
 struct Context {
-    std::set<std::string> visited;
+    dynamic_bitset visited;  // indexed by INode::nodeId, copied on every push_context
 
     inline void mergeVisited(Context const &other) {
-        visited.insert(other.visited.begin(), other.visited.end());
+        visited.merge(other.visited);
     }
 
     ZENO_API Context();
@@ -36,6 +41,7 @@ struct Graph : std::enable_shared_from_this<Graph> {
     SubgraphNode *subgraphNode = nullptr;
 
     std::map<std::string, std::unique_ptr<INode>> nodes;
+    std::vector<INode *> nodesById;  // dense INode::nodeId -> node, assigned when added
     std::set<std::string> nodesToExec;
     int beginFrameNumber = 0, endFrameNumber = 0;  // only use by runnermain.cpp
 
@@ -46,6 +52,10 @@ struct Graph : std::enable_shared_from_this<Graph> {
 
     std::unique_ptr<Context> ctx;
     std::unique_ptr<DirtyChecker> dirtyChecker;
+    std::function<void(INode *)> onNodeApplied;  // called after each node of this graph is applied, if set
+
+    mutable std::mutex tempNodesMutex;
+    mutable std::map<INodeClass const *, std::vector<std::unique_ptr<INode>>> tempNodes;  // idle bReusableTemp instances for callTempNode
 
     ZENO_API Graph();
     ZENO_API ~Graph();
@@ -60,9 +70,15 @@ struct Graph : std::enable_shared_from_this<Graph> {
     ZENO_API void applyNodesToExec();
     ZENO_API void applyNodes(std::set<std::string> const &ids);
     ZENO_API void addNode(std::string const &cls, std::string const &id);
+    ZENO_API INode *insertNode(std::string const &id, std::unique_ptr<INode> node);
     ZENO_API Graph *addSubnetNode(std::string const &id);
     ZENO_API Graph *getSubnetGraph(std::string const &id) const;
+    ZENO_API Graph *addSubgraphInstance(std::string const &id, std::shared_ptr<SubgraphLibrary const> library,
+        std::string const &defName, std::string const &prefix);
+    ZENO_API void instantiateSubgraph(std::shared_ptr<SubgraphLibrary const> const &library,
+        std::string const &defName, std::string const &prefix);
     ZENO_API bool applyNode(std::string const &id);
+    ZENO_API bool applyNode(INode *node);
     ZENO_API void completeNode(std::string const &id);
     ZENO_API void bindNodeInput(std::string const &dn, std::string const &ds,
         std::string const &sn, std::string const &ss);
@@ -72,6 +88,7 @@ struct Graph : std::enable_shared_from_this<Graph> {
     ZENO_API void setFormula(std::string const &id, std::string const &par, zany const &val);
     ZENO_API void addNodeOutput(std::string const &id, std::string const &par);
     ZENO_API zany const &getNodeOutput(std::string const &sn, std::string const &ss) const;
+    ZENO_API zany const &getNodeOutput(INode *node, std::string const &ss) const;
     ZENO_API zany getNodeInput(std::string const &sn, std::string const &ss) const;
     ZENO_API void loadGraph(const char *json);
     ZENO_API void setNodeParam(std::string const &id, std::string const &par,
@@ -27,7 +27,9 @@ public:
     INodeClass *nodeClass = nullptr;
 
     std::string myname;
+    int nodeId = -1;  // index into Graph::nodesById
     std::map<std::string, std::pair<std::string, std::string>> inputBounds;
+    std::map<std::string, INode *> inputBoundNodes;  // inputBounds resolved on first requireInput
     std::map<std::string, zany> inputs;
     std::map<std::string, zany> outputs;
     std::set<std::string> kframes;
@@ -35,6 +37,11 @@ public:
     zany muted_output;
 
     bool bTmpCache = false;
+    // set by nodes whose apply() keeps no state besides inputs and outputs, lets Graph::callTempNode reuse them
+    bool bReusableTemp = false;
+    // set by nodes whose apply() only touches its inputs and outputs, never the session's
+    // globalComm, globalState or userData; lets a parallel EndForEach run copies of them at once
+    bool bThreadSafe = false;
 
     ZENO_API INode();
     ZENO_API virtual ~INode();
@@ -66,6 +73,8 @@ public:
 
     ZENO_API bool has_input(std::string const &id) const;
     ZENO_API zany get_input(std::string const &id) const;
+    // the object held by input `id`, or nullptr if it is missing or evaluated from a keyframe or formula
+    ZENO_API IObject *get_input_direct(std::string const &id) const;
     ZENO_API void set_output(std::string const &id, zany obj);
 
     ZENO_API bool has_keyframe(std::string const &id) const;
@@ -95,6 +104,11 @@ public:
 
     template <class T>
     auto get_input2(std::string const &id) const {
+        if constexpr (!std::is_base_of_v<IObject, T>) {
+            // plain values are read in place, the message is only built on the generic path
+            if (T value; objectTryLiterial<T>(get_input_direct(id), value))
+                return value;
+        }
         return objectToLiterial<T>(get_input(id), "input socket `" + id + "` of node `" + myname + "`");
     }
 
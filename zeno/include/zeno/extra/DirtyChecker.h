@@ -5,20 +5,19 @@
 #include <zeno/utils/safe_dynamic_cast.h>
 #include <zeno/funcs/ObjectCodec.h>
 #include <zeno/types/UserData.h>
-#include <set>
-#include <string>
+#include <zeno/utils/dynamic_bitset.h>
 
 namespace zeno {
 
 struct DirtyChecker {
-    std::set<std::string> dirts;
+    dynamic_bitset dirts;  // indexed by INode::nodeId
 
-    void taintThisNode(std::string ident) {
-        dirts.insert(std::move(ident));
+    void taintThisNode(int nodeId) {
+        dirts.set(nodeId);
     }
 
-    bool amIDirty(std::string const &ident) const {
-        return dirts.find(ident) != dirts.end();
+    bool amIDirty(int nodeId) const {
+        return dirts.test(nodeId);
     }
 };
 
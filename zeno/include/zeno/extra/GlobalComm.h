@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include <functional>
+#include <filesystem>
 
 namespace zeno {
 
@@ -21,15 +22,60 @@ struct GlobalComm {
         FRAME_BROKEN
     };
 
+    struct ViewObjectFile;
+
+    // a view object that is either in memory or encoded at [offset, offset + size)
+    // of a frame cache file; get() decodes it on first touch, keeping the last few
+    // decoded objects in a small LRU so that scrubbing back and forth is cheap.
+    // the file is pinned while any handle to it lives: before it is rewritten or
+    // removed, its content is read into memory for the handles still around
+    struct ViewObjectHandle {
+        std::shared_ptr<IObject> object;
+        std::shared_ptr<ViewObjectFile> file;
+        size_t offset = 0;
+        size_t size = 0;
+
+        ZENO_API std::shared_ptr<IObject> get() const;
+    };
+    using ViewObjectHandles = std::map<std::string, ViewObjectHandle>;
+
     struct FrameData {
         ViewObjects view_objects;
+        ViewObjectHandles disk_objects; // index of the cache files, read on first load_objects
         FRAME_STATE frame_state = FRAME_UNFINISH;
+        size_t mem_bytes = 0;           // estimated size of view_objects
+        size_t last_used = 0;           // access tick, for LRU eviction
+        std::string spill_dir;          // set once view_objects were spilled over the memory budget
+        bool fully_dumped = false;      // view_objects can be loaded back from disk as they are
+        bool spilling = false;          // queued in m_pendingSpills
     };
+
+    // counters of the frame cache, for the editor
+    struct CacheStats {
+        size_t memBytes = 0;            // estimated bytes of view objects held by the frames
+        size_t budgetBytes = 0;         // 0 for no budget
+        size_t decodedBytes = 0;        // objects decoded by ViewObjectHandle::get
+        int framesInMemory = 0;
+        int framesSpilled = 0;
+        size_t evictions = 0;
+    };
+
     std::vector<FrameData> m_frames;
     int m_maxPlayFrame = 0;
     std::set<int> m_inCacheFrames;
     mutable std::mutex m_mtx;
 
+    // over maxCacheBytes, completed frames are evicted least recently used first,
+    // except those within hotFrameRadius of the frame last loaded by the viewer;
+    // frames that are not in the zencache yet are spilled to a temporary directory
+    size_t maxCacheBytes = 0;
+    int hotFrameRadius = 1;
+    int m_currentFrame = 0;
+    size_t m_accessTick = 0;
+    size_t m_evictions = 0;
+    std::string m_spillPath;
+    std::vector<int> m_pendingSpills;  // frame indices chosen by _enforceBudget, written by _spillPending
+
     int beginFrameNumber = 0;
     int endFrameNumber = 0;
     int maxCachedFrames = 1;
@@ -37,6 +83,8 @@ struct GlobalComm {
     std::string objTmpCachePath;
 
     ZENO_API void frameCache(std::string const &path, int gcmax);
+    ZENO_API void frameCacheBudget(size_t maxBytes, int hotRadius = 1);
+    ZENO_API CacheStats cacheStats() const;
     ZENO_API void initFrameRange(int beg, int end);
     ZENO_API void newFrame();
     ZENO_API void finishFrame();
@@ -51,7 +99,7 @@ struct GlobalComm {
     ZENO_API ViewObjects const *getViewObjects(const int frameid);
     ZENO_API ViewObjects const &getViewObjects();
     ZENO_API bool load_objects(const int frameid, 
-                const std::function<bool(std::map<std::string, std::shared_ptr<zeno::IObject>> const& objs)>& cb,
+                const std::function<bool(ViewObjectHandles const& objs)>& cb,
                 bool& isFrameValid);
     ZENO_API void clear_objects(const std::function<void()>& cb);
     ZENO_API bool isFrameCompleted(int frameid) const;
@@ -61,10 +109,17 @@ struct GlobalComm {
     ZENO_API std::string cachePath();
     ZENO_API bool removeCache(int frame);
     ZENO_API void removeCachePath();
-    static void toDisk(std::string cachedir, int frameid, GlobalComm::ViewObjects& objs, bool cacheLightCameraOnly, bool cacheMaterialOnly, std::string fileName = "");
+    // false if nothing was written; with waitForSpace false, a nearly full disk skips the dump instead of waiting
+    static bool toDisk(std::string cachedir, int frameid, GlobalComm::ViewObjects& objs, bool cacheLightCameraOnly, bool cacheMaterialOnly, std::string fileName = "", bool waitForSpace = true);
     static bool fromDisk(std::string cachedir, int frameid, GlobalComm::ViewObjects& objs, std::string fileName = "");
+    static bool indexDisk(std::string cachedir, int frameid, GlobalComm::ViewObjectHandles& objs);
 private:
     ViewObjects const *_getViewObjects(const int frameid);
+    ViewObjectHandles _getViewObjectHandles(const int frameid);
+    void _touchFrame(int frameIdx);
+    void _enforceBudget(int pinnedFrameIdx);
+    void _spillPending();
+    void _removeSpillPath();
 };
 
 }
@@ -7,12 +7,20 @@
 
 namespace zeno {
 
+struct SubgraphLibrary;
+
 struct SubnetNode : INode {
     std::unique_ptr<INodeClass> subnetClass;
     //std::vector<std::string> inputKeys;
     //std::vector<std::string> outputKeys;
     std::shared_ptr<Graph> const subgraph;
 
+    // set by Graph::addSubgraphInstance, the subgraph is built from this
+    // shared definition on first apply instead of being inlined in the program
+    std::shared_ptr<SubgraphLibrary const> library;
+    std::string definitionName;
+    std::string instancePrefix;
+
     ZENO_API SubnetNode();
     ZENO_API ~SubnetNode();
 
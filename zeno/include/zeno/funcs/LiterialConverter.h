@@ -59,6 +59,31 @@ inline auto objectToLiterial(std::shared_ptr<IObject> const &ptr, std::string co
     }
 }
 
+// objectToLiterial without throwing or touching the refcount, false if obj holds no T
+template <class T>
+inline bool objectTryLiterial(IObject const *obj, T &value) {
+    if constexpr (std::is_same_v<std::string, T>) {
+        auto p = dynamic_cast<StringObject const *>(obj);
+        if (p) value = p->get();
+        return p;
+    } else if constexpr (std::is_same_v<NumericValue, T>) {
+        auto p = dynamic_cast<NumericObject const *>(obj);
+        if (p) value = p->get();
+        return p;
+    } else {
+        auto p = dynamic_cast<NumericObject const *>(obj);
+        return p && std::visit([&] (auto const &val) -> bool {
+            using T1 = std::decay_t<decltype(val)>;
+            if constexpr (std::is_constructible_v<T, T1>) {
+                value = T(val);
+                return true;
+            } else {
+                return false;
+            }
+        }, p->get());
+    }
+}
+
 inline std::shared_ptr<IObject> objectFromLiterial(std::string const &value) {
     return std::make_shared<StringObject>(value);
 }
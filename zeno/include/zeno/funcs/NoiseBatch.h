@@ -0,0 +1,38 @@
+#pragma once
+
+#include <zeno/utils/api.h>
+#include <zeno/utils/vec.h>
+#include <cstddef>
+
+namespace zeno {
+
+// batched noise evaluation: out[i * outStride] = noise(p[i]) for 0 <= i < n.
+//
+// `rot` rotates the coordinates fed to the noise, 0 for (x, y, z), 1 for (y, z, x)
+// and 2 for (z, x, y), so that three calls with `out = &arr[0][c]`, `rot = c` and
+// `outStride = 3` fill a vec3f attribute the way the per-point noise nodes did.
+//
+// large batches are split over OpenMP threads, the kernels are compiled for
+// AVX-512, AVX2 and baseline x86 and picked at load time; every variant gives
+// the same bits as the scalar noise they replace.
+
+// classic Perlin noise, as `noise_perlin` of the erode nodes and `PerlinNoise1`
+ZENO_API void noisePerlinBatch(vec3f const *p, float *out, std::size_t n, int rot = 0, std::size_t outStride = 1);
+
+// 3D simplex noise, as `erode_noise_simplex`
+ZENO_API void noiseSimplexBatch(vec3f const *p, float *out, std::size_t n, int rot = 0, std::size_t outStride = 1);
+
+// cellular noise, fType 0 for F1 and 1 for F2-F1, distType 0 for Euclidean (squared),
+// 1 for Chebyshev and 2 for Manhattan
+ZENO_API void noiseWorleyBatch(vec3f const *p, float *out, std::size_t n, int fType, int distType,
+                               vec3f offset, float jitter = 1, int rot = 0, std::size_t outStride = 1);
+
+// sum of pow(lacunarity, -H * i) * perlin(frequence * pow(lacunarity, i) * p) over `octaves`
+ZENO_API void noiseFbmBatch(vec3f const *p, float *out, std::size_t n, float H, float lacunarity,
+                            float frequence, int octaves);
+
+// hashed-gradient fractal noise, as `PerlinNoise::perlin(p, power, depth)`
+ZENO_API void noiseFractalPerlinBatch(vec3f const *p, float *out, std::size_t n, float power, float depth,
+                                      int rot = 0, std::size_t outStride = 1);
+
+}
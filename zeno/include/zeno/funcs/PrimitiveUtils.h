@@ -2,6 +2,7 @@
 
 #include <zeno/utils/api.h>
 #include <zeno/types/PrimitiveObject.h>
+#include <zeno/types/PrimitiveTopology.h>
 #include <string>
 
 namespace zeno {
@@ -18,6 +19,7 @@ ZENO_API void primSepTriangles(PrimitiveObject *prim, bool smoothNormal = true,
 
 ZENO_API void primFlipFaces(PrimitiveObject *prim, bool only_face = false);
 ZENO_API void primCalcNormal(PrimitiveObject *prim, float flip = 1.0f, std::string nrmAttr = "nrm");
+ZENO_API void primCalcNormal(PrimitiveObject *prim, PrimitiveTopology const &topo, float flip = 1.0f, std::string nrmAttr = "nrm");
 //ZENO_API void primCalcInsetDir(PrimitiveObject *prim, float flip = 1.0f, std::string nrmAttr = "nrm");
 
 ZENO_API void primWireframe(PrimitiveObject *prim, bool removeFaces = false, bool toEdges = false);
@@ -39,6 +41,10 @@ ZENO_API void prim_copy_faceset_to_matid(PrimitiveObject* prim);
 
 ZENO_API void primFilterVerts(PrimitiveObject *prim, std::string tagAttr, int tagValue, bool isInversed = false, std::string revampAttrO = {}, std::string method = "verts", int* aux = nullptr, int aux_size = 0, bool use_aux = false);
 
+ZENO_API std::shared_ptr<PrimitiveTopology const> primGetTopology(PrimitiveObject const *prim);
+// the topology attached to prim if it is still up to date, null otherwise; never builds one
+ZENO_API std::shared_ptr<PrimitiveTopology const> primCachedTopology(PrimitiveObject const *prim);
+
 ZENO_API void primMarkIsland(PrimitiveObject *prim, std::string tagAttr);
 ZENO_API std::vector<std::shared_ptr<PrimitiveObject>> primUnmergeVerts(PrimitiveObject *prim, std::string tagAttr);
 ZENO_API std::vector<std::shared_ptr<PrimitiveObject>> primUnmergeFaces(PrimitiveObject *prim, std::string tagAttr);
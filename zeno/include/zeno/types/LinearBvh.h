@@ -7,7 +7,7 @@
 #include <zeno/zeno.h>
 #include <exception>
 #include <stdexcept>
-#include "SpatialUtils.hpp"
+#include <zeno/utils/SpatialUtils.h>
 #if defined(_OPENMP)
 #include <omp.h>
 #endif
@@ -27,12 +27,13 @@ struct LBvh : IObjectClone<LBvh> {
   using BvFunc = std::function<Box(Ti)>;
 
   std::weak_ptr<const PrimitiveObject> primPtr;
-  BvFunc getBv;
   std::vector<Box> sortedBvs;
   std::vector<Ti> auxIndices, levels, parents, leafIndices;
   float thickness{0};
   std::string radiusAttr{""};
   element_e eleCategory{element_e::point}; // element category
+  float quality{0}; // surfaceAreaRatio() right after the last build
+  uint64_t topoFingerprint{0}; // hash of the element vertex indices at the last build
 
   LBvh() noexcept = default;
   LBvh(const std::shared_ptr<PrimitiveObject> &prim, float thickness = 0.f) {
@@ -61,6 +62,21 @@ struct LBvh : IObjectClone<LBvh> {
 
   void refit();
 
+  /// refit in place if prim still has the same elements of the same category
+  /// (compared by topoFingerprint),
+  /// rebuild instead when that would leave surfaceAreaRatio() above maxGrowth
+  /// times the one of the last build; returns true if the tree was refitted
+  template <element_e et>
+  bool refitOrBuild(const std::shared_ptr<PrimitiveObject> &prim, float thickness, std::string radiusAttr,
+                    element_t<et>, float maxGrowth = 1.5f);
+
+  bool refitOrBuild(const std::shared_ptr<PrimitiveObject> &prim, float thickness, std::string radiusAttr,
+                    float maxGrowth = 1.5f);
+
+  /// summed surface area of the internal nodes over the one of the root,
+  /// grows as refitted boxes get looser and overlap more
+  float surfaceAreaRatio() const;
+
   static bool intersect(const Box &box, const TV &p) noexcept {
     constexpr int dim = 3;
     for (Ti d = 0; d != dim; ++d)
@@ -79,6 +95,24 @@ struct LBvh : IObjectClone<LBvh> {
   return true;
 }
 
+  /// clip [t0, t1] against the slabs of box along the line ro + t * rd
+  static bool intersect_ray(const Box &box, const TV &ro, const TV &invd, float &t0, float &t1) noexcept {
+    constexpr int dim = 3;
+    for (Ti d = 0; d != dim; ++d) {
+      float ta = (box.first[d] - ro[d]) * invd[d];
+      float tb = (box.second[d] - ro[d]) * invd[d];
+      if (ta > tb)
+        std::swap(ta, tb);
+      if (ta > t0)
+        t0 = ta;
+      if (tb < t1)
+        t1 = tb;
+      if (t0 > t1)
+        return false;
+    }
+    return true;
+  }
+
   static float distance(const Box &bv, const TV &x) {
     const auto &[mi, ma] = bv;
     TV center = (mi + ma) / 2;
@@ -172,6 +206,9 @@ struct LBvh : IObjectClone<LBvh> {
   return ws;
 }
 
+  /// hit of the line ro + t * rd with the smallest |t| in [tmin, tmax], over a tri bvh
+  float ray_intersect(TV const &ro, TV const &rd, Ti &id, float tmin, float tmax) const;
+
   std::shared_ptr<PrimitiveObject> retrievePrimitive(Ti eid) const;
   vec3f retrievePrimitiveCenter(Ti eid, const TV &w) const;
 
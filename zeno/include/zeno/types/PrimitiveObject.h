@@ -15,6 +15,7 @@ namespace zeno {
 
 struct MaterialObject;
 struct InstancingObject;
+struct PrimitiveTopology;
 /*
     Assuming points {p_i}, 0<=i<n, forms a counterclockwise polygon,
     compute the sum of the cross product of every triangle of a triangle
@@ -143,6 +144,10 @@ struct PrimitiveObject : IObjectClone<PrimitiveObject> {
     std::shared_ptr<MaterialObject> mtl;
     std::shared_ptr<InstancingObject> inst;
 
+    // adjacency cache, use primGetTopology() instead of accessing directly,
+    // it is only loaded and stored with std::atomic_load / std::atomic_store
+    mutable std::shared_ptr<PrimitiveTopology const> topo;
+
     // deprecated:
     template <class Accept = std::variant<vec3f, float>, class F>
     void foreach_attr(F &&f) {
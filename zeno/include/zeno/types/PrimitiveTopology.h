@@ -0,0 +1,70 @@
+#pragma once
+
+#include <zeno/utils/vec.h>
+#include <vector>
+#include <cstdint>
+
+namespace zeno {
+
+// half-edge adjacency over all faces of a primitive, cached in PrimitiveObject::topo
+// by primGetTopology (see zeno/funcs/PrimitiveUtils.h) and rebuilt when the
+// fingerprint of verts count, tris, quads, loops and polys changes.
+//
+// faces are numbered tris first, then quads, then polys; half-edge h of face f
+// goes from heVert[h] to heVert[next(h)], with faceStart[f] <= h < faceStart[f + 1].
+struct PrimitiveTopology {
+    uint64_t fingerprint{0};
+    int numVerts{0};
+    int numTris{0};
+    int numQuads{0};
+    int numPolys{0};
+
+    std::vector<int> faceStart;     // numFaces + 1
+    std::vector<int> heVert;        // origin vertex
+    std::vector<int> heFace;        // owning face
+    std::vector<int> heTwin;        // opposite half-edge, -1 if none
+    std::vector<int> heEdge;        // undirected edge id
+
+    std::vector<vec2i> edges;       // unique undirected edges as (min, max), sorted
+    std::vector<int> edgeStart;     // edges.size() + 1
+    std::vector<int> edgeHalfedges; // half-edges of each edge, ascending
+
+    std::vector<int> vertStart;     // numVerts + 1
+    std::vector<int> vertHalfedges; // half-edges leaving each vertex, ascending
+
+    int numFaces() const {
+        return (int)faceStart.size() - 1;
+    }
+
+    int numHalfedges() const {
+        return (int)heVert.size();
+    }
+
+    int polyFaceBase() const {
+        return numTris + numQuads;
+    }
+
+    int next(int h) const {
+        int f = heFace[h];
+        return h + 1 == faceStart[f + 1] ? faceStart[f] : h + 1;
+    }
+
+    int prev(int h) const {
+        int f = heFace[h];
+        return h == faceStart[f] ? faceStart[f + 1] - 1 : h - 1;
+    }
+
+    int dest(int h) const {
+        return heVert[next(h)];
+    }
+
+    int edgeValence(int e) const {
+        return edgeStart[e + 1] - edgeStart[e];
+    }
+
+    bool isBoundary(int h) const {
+        return heTwin[h] == -1;
+    }
+};
+
+}
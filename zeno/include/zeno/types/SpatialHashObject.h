@@ -0,0 +1,82 @@
+#pragma once
+
+#include <zeno/core/IObject.h>
+#include <zeno/utils/api.h>
+#include <zeno/utils/vec.h>
+#include <vector>
+#include <cstdint>
+
+namespace zeno {
+
+// counting-sorted spatial hash: points are bucketed by hashed cell coordinate,
+// `indices[cellStart[b] .. cellStart[b + 1])` lists the points of bucket `b`,
+// ordered by (cell, index) so that each cell forms one contiguous run.
+struct SpatialHashObject : IObjectClone<SpatialHashObject> {
+    float cellSize{1};
+    float invCellSize{1};
+    uint32_t tableMask{0};
+    uint64_t posFingerprint{0};     // positionsFingerprint() of the points it was built from
+    std::vector<int> cellStart;     // tableMask + 2 entries
+    std::vector<int> indices;       // original point index, sorted by bucket
+    std::vector<vec3f> sortedPos;   // positions in the same order as `indices`
+
+    ZENO_API void build(vec3f const *pos, std::size_t npos, float cellSize);
+
+    // order-sensitive hash of the point positions, cheaper than a rebuild
+    ZENO_API static uint64_t positionsFingerprint(vec3f const *pos, std::size_t npos);
+
+    // whether this hash was built from exactly these points with this cell size
+    bool builtFrom(vec3f const *pos, std::size_t npos, float cellSize) const {
+        return this->cellSize == cellSize && size() == npos
+            && posFingerprint == positionsFingerprint(pos, npos);
+    }
+
+    // assign each point the id of its cell, ids are dense in [0, return value)
+    ZENO_API int markCells(int *tags) const;
+
+    std::size_t size() const {
+        return indices.size();
+    }
+
+    vec3i cellOf(vec3f const &p) const {
+        return vec3i(floor(p * invCellSize));
+    }
+
+    uint32_t bucketOf(vec3i const &c) const {
+        return ((uint32_t)c[0] * 73856093u ^ (uint32_t)c[1] * 19349663u ^ (uint32_t)c[2] * 83492791u) & tableMask;
+    }
+
+    // func(int index, vec3f const &pos) for every point inside the given cell
+    template <class Func>
+    void forEachInCell(vec3i const &cell, Func const &func) const {
+        if (indices.empty()) return;
+        auto b = bucketOf(cell);
+        for (int k = cellStart[b]; k < cellStart[b + 1]; k++) {
+            auto const &p = sortedPos[k];
+            if (alltrue(cellOf(p) == cell))
+                func(indices[k], p);
+        }
+    }
+
+    // func(int index, vec3f const &pos, float dist2) for every point with |pos - center| <= radius
+    template <class Func>
+    void forEachNeighbor(vec3f const &center, float radius, Func const &func) const {
+        if (indices.empty()) return;
+        auto cmin = cellOf(center - radius);
+        auto cmax = cellOf(center + radius);
+        float r2 = radius * radius;
+        for (int z = cmin[2]; z <= cmax[2]; z++) {
+            for (int y = cmin[1]; y <= cmax[1]; y++) {
+                for (int x = cmin[0]; x <= cmax[0]; x++) {
+                    forEachInCell(vec3i(x, y, z), [&] (int i, vec3f const &p) {
+                        float d2 = lengthSquared(p - center);
+                        if (d2 <= r2)
+                            func(i, p, d2);
+                    });
+                }
+            }
+        }
+    }
+};
+
+}
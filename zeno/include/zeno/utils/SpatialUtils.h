@@ -1,5 +1,7 @@
 #pragma once
 #include <zeno/utils/vec.h>
+#include <limits>
+#include <cmath>
 
 namespace zeno {
 
@@ -27,7 +29,10 @@ inline auto dist_pp(const vec3f &a, const vec3f &b, vec3f &ws) {
 inline int dist_pe_category(const vec3f &p, const vec3f &e0,
                             const vec3f &e1) noexcept {
   const auto e = e1 - e0;
-  auto indicator = dot(e, p - e0) / lengthSquared(e);
+  auto len2 = lengthSquared(e);
+  if (len2 <= std::numeric_limits<float>::epsilon()) // degenerated edge
+    return 0;
+  auto indicator = dot(e, p - e0) / len2;
   return indicator < 0 ? 0 : (indicator > 1 ? 1 : 2);
 }
 
@@ -208,4 +213,32 @@ inline auto dist_pt(const vec3f &p, const vec3f &t0, const vec3f &t1,
   return std::sqrt(dist_pt_sqr(p, t0, t1, t2, ws));
 }
 
-} // namespace zeno
\ No newline at end of file
+//! ray-triangle
+
+/// signed ray parameter of the hit on the triangle's supporting line,
+/// infinity when the line misses the triangle
+inline float ray_tri_intersect(const vec3f &ro, const vec3f &rd, const vec3f &v0,
+                               const vec3f &v1, const vec3f &v2) {
+  const float eps = 1e-6f;
+  vec3f u = v1 - v0;
+  vec3f v = v2 - v0;
+  vec3f n = cross(u, v);
+  float b = dot(n, rd);
+  if (std::abs(b) > eps) {
+    float r = dot(n, v0 - ro) / b;
+    vec3f w = ro + r * rd - v0;
+    float uu = dot(u, u);
+    float uv = dot(u, v);
+    float vv = dot(v, v);
+    float wu = dot(w, u);
+    float wv = dot(w, v);
+    float d = 1.0f / (uv * uv - uu * vv);
+    float s = (uv * wv - vv * wu) * d;
+    float t = (uv * wu - uu * wv) * d;
+    if (-eps <= s && s <= 1 + eps && -eps <= t && s + t <= 1 + eps * 2)
+      return r;
+  }
+  return std::numeric_limits<float>::infinity();
+}
+
+} // namespace zeno
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <string>
 #include <vector>
+#include <mutex>
 #include <cassert>
 
 namespace zeno {
@@ -20,8 +21,9 @@ public:
     };
 
 private:
-    static Timer *current;
+    static thread_local Timer *current;  // nodes may run concurrently, e.g. parallel EndForEach
     static std::vector<Record> records;
+    static std::mutex records_mtx;
 
     Timer *parent = nullptr;
     ClockType::time_point beg;
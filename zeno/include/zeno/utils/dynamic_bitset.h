@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zeno {
+
+// growable set of small non-negative integers, one bit per element
+struct dynamic_bitset {
+    std::vector<std::uint64_t> words;
+
+    bool test(std::size_t i) const {
+        std::size_t w = i >> 6;
+        return w < words.size() && (words[w] >> (i & 63) & 1);
+    }
+
+    // returns false if the bit was already set
+    bool set(std::size_t i) {
+        std::size_t w = i >> 6;
+        if (w >= words.size())
+            words.resize(w + 1);
+        std::uint64_t mask = std::uint64_t(1) << (i & 63);
+        bool was = words[w] & mask;
+        words[w] |= mask;
+        return !was;
+    }
+
+    void reset(std::size_t i) {
+        std::size_t w = i >> 6;
+        if (w < words.size())
+            words[w] &= ~(std::uint64_t(1) << (i & 63));
+    }
+
+    void merge(dynamic_bitset const &other) {
+        if (words.size() < other.words.size())
+            words.resize(other.words.size());
+        for (std::size_t w = 0; w < other.words.size(); w++)
+            words[w] |= other.words[w];
+    }
+
+    void clear() {
+        words.clear();
+    }
+};
+
+}
@@ -30,7 +30,10 @@ ZENO_API Graph::~Graph() = default;
 
 ZENO_API zany const &Graph::getNodeOutput(
     std::string const &sn, std::string const &ss) const {
-    auto node = safe_at(nodes, sn, "node name").get();
+    return getNodeOutput(safe_at(nodes, sn, "node name").get(), ss);
+}
+
+ZENO_API zany const &Graph::getNodeOutput(INode *node, std::string const &ss) const {
     if (node->muted_output)
         return node->muted_output;
     return safe_at(node->outputs, ss, "output socket name of node " + node->myname);
@@ -43,30 +46,47 @@ zany Graph::getNodeInput(std::string const& sn, std::string const& ss) const {
 
 ZENO_API void Graph::clearNodes() {
     nodes.clear();
+    nodesById.clear();
+}
+
+ZENO_API INode *Graph::insertNode(std::string const &id, std::unique_ptr<INode> node) {
+    auto &slot = nodes[id];
+    if (slot)
+        throw makeError("node `" + id + "` already exists");
+    node->graph = this;
+    node->myname = id;
+    node->nodeId = (int)nodesById.size();
+    nodesById.push_back(node.get());
+    slot = std::move(node);
+    return slot.get();
 }
 
 ZENO_API void Graph::addNode(std::string const &cls, std::string const &id) {
     if (nodes.find(id) != nodes.end())
         return;  // no add twice, to prevent output object invalid
     auto cl = safe_at(session->nodeClasses, cls, "node class name").get();
-    auto node = cl->new_instance();
-    node->graph = this;
-    node->myname = id;
-    node->nodeClass = cl;
-    nodes[id] = std::move(node);
+    insertNode(id, cl->new_instance())->nodeClass = cl;
 }
 
 ZENO_API Graph *Graph::addSubnetNode(std::string const &id) {
     auto subcl = std::make_unique<ImplSubnetNodeClass>();
     auto node = subcl->new_instance();
-    node->graph = this;
-    node->myname = id;
     node->nodeClass = subcl.get();
     auto subnode = static_cast<SubnetNode *>(node.get());
     subnode->subgraph->session = this->session;
     subnode->subnetClass = std::move(subcl);
     auto subg = subnode->subgraph.get();
-    nodes[id] = std::move(node);
+    insertNode(id, std::move(node));
+    return subg;
+}
+
+ZENO_API Graph *Graph::addSubgraphInstance(std::string const &id, std::shared_ptr<SubgraphLibrary const> library,
+                                           std::string const &defName, std::string const &prefix) {
+    auto subg = addSubnetNode(id);
+    auto subnode = static_cast<SubnetNode *>(nodes.at(id).get());
+    subnode->library = std::move(library);
+    subnode->definitionName = defName;
+    subnode->instancePrefix = prefix;
     return subg;
 }
 
@@ -80,15 +100,19 @@ ZENO_API void Graph::completeNode(std::string const &id) {
 }
 
 ZENO_API bool Graph::applyNode(std::string const &id) {
-    if (ctx->visited.find(id) != ctx->visited.end()) {
+    return applyNode(safe_at(nodes, id, "node name").get());
+}
+
+ZENO_API bool Graph::applyNode(INode *node) {
+    if (!ctx->visited.set(node->nodeId)) {
         return false;
     }
-    ctx->visited.insert(id);
-    auto node = safe_at(nodes, id, "node name").get();
     GraphException::translated([&] {
         node->doApply();
     }, node->myname);
-    if (dirtyChecker && dirtyChecker->amIDirty(id)) {
+    if (onNodeApplied)
+        onNodeApplied(node);
+    if (dirtyChecker && dirtyChecker->amIDirty(node->nodeId)) {
         return true;
     }
     return false;
@@ -113,7 +137,9 @@ ZENO_API void Graph::applyNodesToExec() {
 
 ZENO_API void Graph::bindNodeInput(std::string const &dn, std::string const &ds,
         std::string const &sn, std::string const &ss) {
-    safe_at(nodes, dn, "node name")->inputBounds[ds] = std::pair(sn, ss);
+    auto node = safe_at(nodes, dn, "node name").get();
+    node->inputBounds[ds] = std::pair(sn, ss);
+    node->inputBoundNodes.erase(ds);
 }
 
 ZENO_API void Graph::setNodeInput(std::string const &id, std::string const &par,
@@ -143,11 +169,29 @@ ZENO_API std::map<std::string, zany> Graph::callSubnetNode(std::string const &id
 ZENO_API std::map<std::string, zany> Graph::callTempNode(std::string const &id,
         std::map<std::string, zany> inputs) const {
     auto cl = safe_at(session->nodeClasses, id, "node class name").get();
-    auto se = cl->new_instance();
-    se->graph = const_cast<Graph *>(this);
+    std::unique_ptr<INode> se;
+    {
+        std::lock_guard lck(tempNodesMutex);
+        if (auto it = tempNodes.find(cl); it != tempNodes.end() && !it->second.empty()) {
+            se = std::move(it->second.back());
+            it->second.pop_back();
+        }
+    }
+    if (!se) {
+        se = cl->new_instance();
+        se->graph = const_cast<Graph *>(this);
+    }
     se->inputs = std::move(inputs);
     se->doOnlyApply();
-    return std::move(se->outputs);
+    auto outputs = std::move(se->outputs);
+    if (se->bReusableTemp) {
+        // a node calling its own class again takes another instance, so the pool holds one per nesting level
+        se->inputs.clear();
+        se->outputs.clear();
+        std::lock_guard lck(tempNodesMutex);
+        tempNodes[cl].push_back(std::move(se));
+    }
+    return outputs;
 }
 
 ZENO_API void Graph::setTempCache(std::string const& id)
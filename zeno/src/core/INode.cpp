@@ -17,6 +17,9 @@
 #include <zeno/extra/GlobalState.h>
 #include <filesystem>
 #include <fstream>
+#include <string_view>
+#include <cctype>
+#include <cstdlib>
 #include <zeno/extra/GlobalComm.h>
 #include <zeno/types/PrimitiveObject.h>
 
@@ -112,12 +115,12 @@ ZENO_API void zeno::INode::writeTmpCaches()
 
 ZENO_API void INode::preApply() {
     auto& dc = graph->getDirtyChecker();
-    if (!dc.amIDirty(myname) && bTmpCache)
+    if (!dc.amIDirty(nodeId) && bTmpCache)
     {
         if (getTmpCache())
             return;
     }
-    else if (dc.amIDirty(myname) && !bTmpCache)//remove cache
+    else if (dc.amIDirty(nodeId) && !bTmpCache)//remove cache
     {
         std::string fileName = myname + ".zenocache";
         int frameid = zeno::getSession().globalState->frameid;
@@ -148,12 +151,15 @@ ZENO_API bool INode::requireInput(std::string const &ds) {
     auto it = inputBounds.find(ds);
     if (it == inputBounds.end())
         return false;
-    auto [sn, ss] = it->second;
-    if (graph->applyNode(sn)) {
+    auto const &[sn, ss] = it->second;
+    auto &srcNode = inputBoundNodes[ds];
+    if (!srcNode)
+        srcNode = safe_at(graph->nodes, sn, "node name").get();
+    if (graph->applyNode(srcNode)) {
         auto &dc = graph->getDirtyChecker();
-        dc.taintThisNode(myname);
+        dc.taintThisNode(nodeId);
     }
-    auto ref = graph->getNodeOutput(sn, ss);
+    auto ref = graph->getNodeOutput(srcNode, ss);
     inputs[ds] = ref;
     return true;
 }
@@ -201,6 +207,17 @@ ZENO_API zany INode::get_input(std::string const &id) const {
     return safe_at(inputs, id, "input socket of node `" + myname + "`");
 }
 
+ZENO_API IObject *INode::get_input_direct(std::string const &id) const {
+    auto it = inputs.find(id);
+    if (it == inputs.end())
+        return nullptr;
+    if (!kframes.empty() && has_keyframe(id))
+        return nullptr;
+    if (!formulas.empty() && has_formula(id))
+        return nullptr;
+    return it->second.get();
+}
+
 ZENO_API zany INode::resolveInput(std::string const& id) {
     if (inputBounds.find(id) != inputBounds.end()) {
         if (requireInput(id))
@@ -269,6 +286,52 @@ ZENO_API bool INode::has_formula(std::string const &id) const {
     return formulas.find(id) != formulas.end();
 }
 
+// a decimal number as the zfx tokenizer reads it, e.g. "2", "-0.5"
+static bool formula_literal_float(std::string_view code, float &value) {
+    while (!code.empty() && std::isspace((unsigned char)code.front()))
+        code.remove_prefix(1);
+    while (!code.empty() && std::isspace((unsigned char)code.back()))
+        code.remove_suffix(1);
+    std::size_t i = !code.empty() && code[0] == '-' ? 1 : 0;
+    bool has_digit = false, has_dot = false;
+    for (; i < code.size(); i++) {
+        if (std::isdigit((unsigned char)code[i]))
+            has_digit = true;
+        else if (code[i] == '.' && !has_dot)
+            has_dot = true;
+        else
+            return false;
+    }
+    if (!has_digit)
+        return false;
+    value = std::strtof(std::string(code).c_str(), nullptr);
+    return true;
+}
+
+// formulas whose value NumericEval would only echo back: a number, or vec3(...) of three numbers
+static bool formula_literal(std::string const &code, std::string const &resType, NumericValue &value) {
+    if (resType == "float") {
+        float x;
+        if (!formula_literal_float(code, x))
+            return false;
+        value = x;
+        return true;
+    }
+    std::string_view rest = code;
+    if (rest.substr(0, 5) != "vec3(" || rest.back() != ')')
+        return false;
+    rest = rest.substr(5, rest.size() - 6);
+    vec3f v;
+    for (int i = 0; i < 3; i++) {
+        auto comma = i < 2 ? rest.find(',') : rest.size();
+        if (comma == std::string_view::npos || !formula_literal_float(rest.substr(0, comma), v[i]))
+            return false;
+        rest.remove_prefix(std::min(comma + 1, rest.size()));
+    }
+    value = v;
+    return true;
+}
+
 ZENO_API zany INode::get_formula(std::string const &id) const 
 {
     auto value = safe_at(inputs, id, "input socket of node `" + myname + "`");
@@ -278,6 +341,8 @@ ZENO_API zany INode::get_formula(std::string const &id) const
         if (code.find("=") == 0)
         { 
             code.replace(0, 1, "");
+            if (code.find_first_of("{$") == std::string::npos)  // nothing for StringEval to expand
+                return objectFromLiterial(std::move(code));
             auto res = getThisGraph()->callTempNode("StringEval", { {"zfxCode", objectFromLiterial(code)} }).at("result");
             value = objectFromLiterial(std::move(res));
         }
@@ -291,6 +356,8 @@ ZENO_API zany INode::get_formula(std::string const &id) const
             else {
                 resType = "float";
             }
+            if (NumericValue literal; formula_literal(code, resType, literal))
+                return objectFromLiterial(literal);
             auto res = getThisGraph()->callTempNode("NumericEval", { {"zfxCode", objectFromLiterial(code)}, {"resType", objectFromLiterial(resType)} }).at("result");
             value = objectFromLiterial(std::move(res));
         }
@@ -6,6 +6,8 @@
 #include <zeno/extra/GraphException.h>
 #include <zeno/extra/DirtyChecker.h>
 #include <zeno/utils/logger.h>
+#include <zeno/utils/safe_at.h>
+#include <zeno/utils/Error.h>
 #include <zeno/utils/vec.h>
 #include <zeno/utils/zeno_p.h>
 #include <zeno/zeno.h>
@@ -67,68 +69,119 @@ static T generic_get(Value const &x) {
     }
 }
 
+// subgraph definitions of a program, each is a range of commands kept in the
+// parsed document and replayed into the graph of an instance on its first apply
+struct SubgraphLibrary {
+    std::shared_ptr<Document const> doc;
+    std::map<std::string, std::vector<Value const *>> defs;
+};
+
+namespace {
+
+struct GraphLoader {
+    Graph *root;
+    std::shared_ptr<SubgraphLibrary const> library;
+    SubgraphLibrary *defining = nullptr;  // only set when loading a whole program
+    std::string prefix;
+
+    std::string ident(Value const &x) const {
+        return prefix.empty() ? std::string(x.GetString()) : prefix + '/' + x.GetString();
+    }
+
+    void load(Graph *g, Value const *const *cmds, std::size_t ncmds) {
+        std::stack<Graph *> gStack;
+
+        for (std::size_t i = 0; i < ncmds; i++) {
+            Value const &di = *cmds[i];
+            std::string cmd = di[0].GetString();
+            std::string maybeNodeName = cmd == "addNode" || cmd == "addSubgraphInstance" ? ident(di[2]) : (
+                di.Size() >= 1 && di[1].IsString() ? ident(di[1]) : "(not a node)");
+            //ZENO_P(cmd);
+            //ZENO_P(maybeNodeName);
+            GraphException::translated([&] {
+                if (0) {
+                } else if (cmd == "addNode") {
+                    g->addNode(di[1].GetString(), ident(di[2]));
+                } else if (cmd == "setNodeInput") {
+                    g->setNodeInput(ident(di[1]), di[2].GetString(), generic_get<zany>(di[3]));
+                } else if (cmd == "setKeyFrame") {
+                    g->setKeyFrame(ident(di[1]), di[2].GetString(), generic_get<zany>(di[3]));
+                } else if (cmd == "setFormula") {
+                    g->setFormula(ident(di[1]), di[2].GetString(), generic_get<zany>(di[3]));
+                } else if (cmd == "setNodeParam") {
+                    g->setNodeParam(ident(di[1]), di[2].GetString(), generic_get<std::variant<int, float, std::string, zany>, false>(di[3]));
+                } else if (cmd == "bindNodeInput") {
+                    g->bindNodeInput(ident(di[1]), di[2].GetString(), ident(di[3]), di[4].GetString());
+                } else if (cmd == "completeNode") {
+                    g->completeNode(ident(di[1]));
+                } else if (cmd == "addSubnetNode") {
+                    auto newG = g->addSubnetNode(/*di[1].GetString(), */ident(di[2]));
+                } else if (cmd == "addSubgraphInstance") {
+                    g->addSubgraphInstance(ident(di[2]), library, di[1].GetString(), ident(di[3]));
+                } else if (cmd == "beginSubgraphDef") {
+                    if (!defining)
+                        throw makeError("nested subgraph definition `" + std::string(di[1].GetString()) + "`");
+                    auto &def = defining->defs[di[1].GetString()];
+                    def.clear();
+                    for (i++; i < ncmds && std::string((*cmds[i])[0].GetString()) != "endSubgraphDef"; i++)
+                        def.push_back(cmds[i]);
+                    if (i == ncmds)
+                        throw makeError("unterminated subgraph definition `" + std::string(di[1].GetString()) + "`");
+                } else if (cmd == "addNodeOutput") {
+                    g->addNodeOutput(ident(di[1]), di[2].GetString());
+                } else if (cmd == "pushSubnetScope") {
+                    gStack.push(g);
+                    g = g->getSubnetGraph(ident(di[1]));
+                } else if (cmd == "popSubnetScope") {
+                    g = gStack.top();
+                    gStack.pop();
+                } else if (cmd == "setBeginFrameNumber") {
+                    root->beginFrameNumber = di[1].GetInt();
+                } else if (cmd == "setEndFrameNumber") {
+                    root->endFrameNumber = di[1].GetInt();
+                } else if (cmd == "setNodeOption") {
+                    // skip this for compatibility
+                } else if (cmd == "markNodeChanged") {
+                    auto &dc = g->getDirtyChecker();
+                    dc.taintThisNode(g->getNode(ident(di[1]))->nodeId);
+                    //todo: mark node data change.
+                } else if (cmd == "cacheToDisk") {
+                    g->setTempCache(ident(di[1]));
+                } else {
+                    log_warn("got unexpected command: {}", cmd);
+                }
+            }, maybeNodeName);
+        }
+    }
+};
+
+}
+
 ZENO_API void Graph::loadGraph(const char *json) {
-    Document d;
-    d.Parse(json);
+    auto d = std::make_shared<Document>();
+    d->Parse(json);
 
-    if (!d.IsArray()) {
+    if (!d->IsArray()) {
         throw GraphException { "None", nullptr };
     }
 
-    Graph *g = this;
-    std::stack<Graph *> gStack;
-
-    for (int i = 0; i < d.Size(); i++) {
-        Value const &di = d[i];
-        std::string cmd = di[0].GetString();
-        const char *maybeNodeName = cmd == "addNode" ? di[2].GetString() : (
-            di.Size() >= 1 && di[1].IsString() ? di[1].GetString() : "(not a node)");
-        //ZENO_P(cmd);
-        //ZENO_P(maybeNodeName);
-        GraphException::translated([&] {
-            if (0) {
-            } else if (cmd == "addNode") {
-                g->addNode(di[1].GetString(), di[2].GetString());
-            } else if (cmd == "setNodeInput") {
-                g->setNodeInput(di[1].GetString(), di[2].GetString(), generic_get<zany>(di[3]));
-            } else if (cmd == "setKeyFrame") {
-                g->setKeyFrame(di[1].GetString(), di[2].GetString(), generic_get<zany>(di[3]));
-            } else if (cmd == "setFormula") {
-                g->setFormula(di[1].GetString(), di[2].GetString(), generic_get<zany>(di[3]));
-            } else if (cmd == "setNodeParam") {
-                g->setNodeParam(di[1].GetString(), di[2].GetString(), generic_get<std::variant<int, float, std::string, zany>, false>(di[3]));
-            } else if (cmd == "bindNodeInput") {
-                g->bindNodeInput(di[1].GetString(), di[2].GetString(), di[3].GetString(), di[4].GetString());
-            } else if (cmd == "completeNode") {
-                g->completeNode(di[1].GetString());
-            } else if (cmd == "addSubnetNode") {
-                auto newG = g->addSubnetNode(/*di[1].GetString(), */di[2].GetString());
-            } else if (cmd == "addNodeOutput") {
-                g->addNodeOutput(di[1].GetString(), di[2].GetString());
-            } else if (cmd == "pushSubnetScope") {
-                gStack.push(g);
-                g = g->getSubnetGraph(di[1].GetString());
-            } else if (cmd == "popSubnetScope") {
-                g = gStack.top();
-                gStack.pop();
-            } else if (cmd == "setBeginFrameNumber") {
-                this->beginFrameNumber = di[1].GetInt();
-            } else if (cmd == "setEndFrameNumber") {
-                this->endFrameNumber = di[1].GetInt();
-            } else if (cmd == "setNodeOption") {
-                // skip this for compatibility
-            } else if (cmd == "markNodeChanged") {
-                auto ident = di[1].GetString();
-                auto &dc = g->getDirtyChecker();
-                dc.taintThisNode(ident);
-                //todo: mark node data change.
-            } else if (cmd == "cacheToDisk") {
-                g->setTempCache(di[1].GetString());
-            } else {
-                log_warn("got unexpected command: {}", cmd);
-            }
-        }, maybeNodeName);
+    std::vector<Value const *> cmds;
+    cmds.reserve(d->Size());
+    for (auto const &di: d->GetArray()) {
+        cmds.push_back(&di);
     }
+
+    auto library = std::make_shared<SubgraphLibrary>();
+    library->doc = d;
+    GraphLoader loader{this, library, library.get()};
+    loader.load(this, cmds.data(), cmds.size());
+}
+
+ZENO_API void Graph::instantiateSubgraph(std::shared_ptr<SubgraphLibrary const> const &library,
+                                         std::string const &defName, std::string const &prefix) {
+    auto const &def = safe_at(library->defs, defName, "subgraph definition");
+    GraphLoader loader{this, library, nullptr, prefix};
+    loader.load(this, def.data(), def.size());
 }
 
 }
@@ -8,13 +8,20 @@
 #include <cassert>
 #include <zeno/types/UserData.h>
 #include <unordered_set>
+#include <list>
 #include <zeno/types/MaterialObject.h>
 #include <zeno/types/CameraObject.h>
+#include <zeno/types/PrimitiveObject.h>
+#include <zeno/types/ListObject.h>
+#include <zeno/types/DictObject.h>
+#include <chrono>
+#include <cstdlib>
 #ifdef __linux__
     #include<unistd.h>
     #include <sys/statfs.h>
 #endif
 #define MIN_DISKSPACE_MB 1024
+#define MAX_DECODED_VIEW_OBJECTS 64
 
 namespace zeno {
 
@@ -25,8 +32,150 @@ std::unordered_set<std::string> lightCameraNodes({
     });
 std::set<std::string> matNodeNames = {"ShaderFinalize", "ShaderVolume", "ShaderVolumeHomogeneous"};
 
-void GlobalComm::toDisk(std::string cachedir, int frameid, GlobalComm::ViewObjects &objs, bool cacheLightCameraOnly, bool cacheMaterialOnly, std::string fileName) {
-    if (cachedir.empty()) return;
+static size_t estimateObjectBytes(IObject const *obj) {
+    if (auto prim = dynamic_cast<PrimitiveObject const *>(obj)) {
+        size_t bytes = sizeof(PrimitiveObject);
+        auto add = [&] (auto const &attrvec) {
+            attrvec.template forall_attr<AttrAcceptAll>([&] (auto const &key, auto const &arr) {
+                bytes += arr.size() * sizeof(arr[0]);
+            });
+        };
+        add(prim->verts);
+        add(prim->points);
+        add(prim->lines);
+        add(prim->tris);
+        add(prim->quads);
+        add(prim->loops);
+        add(prim->polys);
+        add(prim->edges);
+        add(prim->uvs);
+        return bytes;
+    }
+    if (auto lst = dynamic_cast<ListObject const *>(obj)) {
+        size_t bytes = sizeof(ListObject);
+        for (auto const &val: lst->arr)
+            bytes += estimateObjectBytes(val.get());
+        return bytes;
+    }
+    if (auto dict = dynamic_cast<DictObject const *>(obj)) {
+        size_t bytes = sizeof(DictObject);
+        for (auto const &[key, val]: dict->lut)
+            bytes += estimateObjectBytes(val.get());
+        return bytes;
+    }
+    return obj ? 256 : 0;
+}
+
+// a cache file indexed by indexDisk, shared by the handles into it
+struct GlobalComm::ViewObjectFile {
+    std::filesystem::path path;
+    size_t version = 0;         // unique per indexing, so a rewritten file never hits stale LRU entries
+    std::mutex mtx;
+    bool detached = false;      // the file was rewritten or removed, read from content instead
+    std::vector<char> content;
+};
+
+static std::mutex viewFilesMtx;
+static std::map<std::filesystem::path, std::weak_ptr<GlobalComm::ViewObjectFile>> viewFiles;
+static size_t viewFileVersion = 0;
+
+static std::shared_ptr<GlobalComm::ViewObjectFile> pinViewObjectFile(std::filesystem::path const &path) {
+    std::lock_guard lck(viewFilesMtx);
+    auto &weak = viewFiles[path];
+    if (auto file = weak.lock())
+        return file;
+    auto file = std::make_shared<GlobalComm::ViewObjectFile>();
+    file->path = path;
+    file->version = ++viewFileVersion;
+    weak = file;
+    return file;
+}
+
+// call before rewriting or removing the cache files under dir: handles still pointing
+// into them get the old content read into memory, and later indexing starts afresh
+static void detachViewObjectFiles(std::filesystem::path const &dir) {
+    auto prefix = (dir / "").lexically_normal().u8string();
+    std::lock_guard lck(viewFilesMtx);
+    for (auto it = viewFiles.begin(); it != viewFiles.end();) {
+        auto file = it->second.lock();
+        if (file && it->first.lexically_normal().u8string().compare(0, prefix.size(), prefix) != 0) {
+            ++it;
+            continue;
+        }
+        if (file) {
+            std::lock_guard lck(file->mtx);
+            std::ifstream ifs(file->path, std::ios::binary | std::ios::ate);
+            if (ifs) {
+                file->content.resize((size_t)ifs.tellg());
+                ifs.seekg(0);
+                ifs.read(file->content.data(), file->content.size());
+            }
+            file->detached = true;
+        }
+        it = viewFiles.erase(it);
+    }
+}
+
+struct DecodedViewObject {
+    size_t version;
+    size_t offset;
+    std::shared_ptr<IObject> object;
+    size_t bytes;
+};
+
+static std::mutex decodedMtx;
+static std::list<DecodedViewObject> decodedObjects; // most recent first
+static size_t decodedBytes = 0;
+static size_t decodedBudget = 0;  // a quarter of the frame cache budget, 0 for none
+
+static void clearDecodedViewObjects() {
+    std::lock_guard lck(decodedMtx);
+    decodedObjects.clear();
+    decodedBytes = 0;
+}
+
+ZENO_API std::shared_ptr<IObject> GlobalComm::ViewObjectHandle::get() const {
+    if (object || !file)
+        return object;
+    std::lock_guard lck(decodedMtx);
+    auto it = std::find_if(decodedObjects.begin(), decodedObjects.end(), [&] (auto const &entry) {
+        return entry.version == file->version && entry.offset == offset;
+    });
+    if (it != decodedObjects.end()) {
+        decodedObjects.splice(decodedObjects.begin(), decodedObjects, it);
+        return it->object;
+    }
+    std::vector<char> dat(size);
+    {
+        std::lock_guard lck(file->mtx);
+        if (file->detached) {
+            if (offset > file->content.size() || size > file->content.size() - offset) {
+                log_error("zeno cache file broken (5)");
+                return nullptr;
+            }
+            std::copy_n(file->content.data() + offset, size, dat.data());
+        } else {
+            std::ifstream ifs(file->path, std::ios::binary);
+            if (!ifs.seekg(offset) || !ifs.read(dat.data(), size)) {
+                log_error("zeno cache file broken (5)");
+                return nullptr;
+            }
+        }
+    }
+    auto obj = decodeObject(dat.data(), size);
+    size_t bytes = estimateObjectBytes(obj.get());
+    decodedObjects.push_front({file->version, offset, obj, bytes});
+    decodedBytes += bytes;
+    while (decodedObjects.size() > 1 && (decodedObjects.size() > MAX_DECODED_VIEW_OBJECTS
+                                         || decodedBudget && decodedBytes > decodedBudget)) {
+        decodedBytes -= decodedObjects.back().bytes;
+        decodedObjects.pop_back();
+    }
+    return obj;
+}
+
+bool GlobalComm::toDisk(std::string cachedir, int frameid, GlobalComm::ViewObjects &objs, bool cacheLightCameraOnly, bool cacheMaterialOnly, std::string fileName, bool waitForSpace) {
+    if (cachedir.empty()) return false;
     std::filesystem::path dir = std::filesystem::u8path(cachedir + "/" + std::to_string(1000000 + frameid).substr(1));
     if (!std::filesystem::exists(dir) && !std::filesystem::create_directories(dir))
     {
@@ -120,6 +269,10 @@ void GlobalComm::toDisk(std::string cachedir, int frameid, GlobalComm::ViewObjec
     //wait in two case: 1. available space minus current frame size less than 1024MB, 2. available space less or equal than 1024MB
     while ( ((freeSpace >> 20) - MIN_DISKSPACE_MB) < (currentFrameSize >> 20)  || (freeSpace >> 20) <= MIN_DISKSPACE_MB)
     {
+        if (!waitForSpace) {
+            zeno::log_warn("Disk space almost full on {}, frame {} not dumped", std::filesystem::u8path(cachedir).string(), frameid);
+            return false;
+        }
         #ifdef __linux__
             zeno::log_critical("Disk space almost full on {}, wait for zencache remove", std::filesystem::u8path(cachedir).string());
             sleep(2);
@@ -132,6 +285,7 @@ void GlobalComm::toDisk(std::string cachedir, int frameid, GlobalComm::ViewObjec
             freeSpace = std::filesystem::space(std::filesystem::u8path(cachedir)).free;
         #endif
     }
+    detachViewObjectFiles(dir);
     for (int i = 0; i < 3; i++)
     {
         if (poses[i].size() == 0 && (cacheLightCameraOnly && i != 0 || cacheMaterialOnly && i != 1 || fileName != "" && i != 2))
@@ -144,6 +298,7 @@ void GlobalComm::toDisk(std::string cachedir, int frameid, GlobalComm::ViewObjec
         std::copy(bufCaches[i].begin(), bufCaches[i].end(), oit);
     }
     objs.clear();
+    return true;
 }
 
 bool GlobalComm::fromDisk(std::string cachedir, int frameid, GlobalComm::ViewObjects &objs, std::string fileName) {
@@ -217,6 +372,63 @@ bool GlobalComm::fromDisk(std::string cachedir, int frameid, GlobalComm::ViewObj
     return true;
 }
 
+// reads only the keys and offsets of the cache files of a frame, see ViewObjectHandle
+bool GlobalComm::indexDisk(std::string cachedir, int frameid, GlobalComm::ViewObjectHandles &objs) {
+    if (cachedir.empty())
+        return false;
+    objs.clear();
+    auto dir = std::filesystem::u8path(cachedir) / std::to_string(1000000 + frameid).substr(1);
+    for (auto const &name: {"lightCameraObj.zencache", "materialObj.zencache", "normalObj.zencache"})
+    {
+        auto path = dir / name;
+        if (!std::filesystem::exists(path))
+        {
+            continue;
+        }
+        log_debug("index cache from disk {}", path);
+
+        auto szBuffer = std::filesystem::file_size(path);
+        std::ifstream ifs(path, std::ios::binary);
+        char magic[8];
+        if (!ifs.read(magic, 8) || std::string(magic, 8) != "ZENCACHE") {
+            log_error("zeno cache file broken (1)");
+            return false;
+        }
+        std::string line;
+        if (!std::getline(ifs, line, '\a')) {
+            log_error("zeno cache file broken (2)");
+            return false;
+        }
+        size_t keyscount = std::stoi(line);
+        std::vector<std::string> keys;
+        for (int k = 0; k < keyscount; k++) {
+            if (!std::getline(ifs, line, '\a')) {
+                log_error("zeno cache file broken (3.{})", k);
+                return false;
+            }
+            keys.push_back(std::move(line));
+        }
+        std::vector<size_t> poses(keyscount + 1);
+        if (!ifs.read((char *)poses.data(), (keyscount + 1) * sizeof(size_t))) {
+            log_error("zeno cache file broken (4)");
+            return false;
+        }
+        size_t pos = ifs.tellg();
+        auto file = pinViewObjectFile(path);
+        for (int k = 0; k < keyscount; k++) {
+            if (poses[k] > szBuffer - pos || poses[k + 1] < poses[k] || poses[k + 1] > szBuffer - pos) {
+                log_error("zeno cache file broken (4.{})", k);
+                continue;
+            }
+            auto &handle = objs[keys[k]];
+            handle.file = file;
+            handle.offset = pos + poses[k];
+            handle.size = poses[k + 1] - poses[k];
+        }
+    }
+    return true;
+}
+
 ZENO_API void GlobalComm::newFrame() {
     std::lock_guard lck(m_mtx);
     log_debug("GlobalComm::newFrame {}", m_frames.size());
@@ -236,20 +448,39 @@ ZENO_API void GlobalComm::dumpFrameCache(int frameid, bool cacheLightCameraOnly,
     int frameIdx = frameid - beginFrameNumber;
     if (frameIdx >= 0 && frameIdx < m_frames.size()) {
         log_debug("dumping frame {}", frameid);
-        toDisk(cacheFramePath, frameid, m_frames[frameIdx].view_objects, cacheLightCameraOnly, cacheMaterialOnly);
+        auto &frame = m_frames[frameIdx];
+        // drop our own index first, so toDisk only has to keep the content for the viewer's handles
+        frame.disk_objects.clear();
+        bool dumped = toDisk(cacheFramePath, frameid, frame.view_objects, cacheLightCameraOnly, cacheMaterialOnly);
+        frame.fully_dumped = dumped && !cacheLightCameraOnly && !cacheMaterialOnly;
+        frame.mem_bytes = 0;
     }
 }
 
 ZENO_API void GlobalComm::addViewObject(std::string const &key, std::shared_ptr<IObject> object) {
-    std::lock_guard lck(m_mtx);
-    log_debug("GlobalComm::addViewObject {}", m_frames.size());
-    if (m_frames.empty()) throw makeError("empty frame cache");
-    m_frames.back().view_objects.try_emplace(key, std::move(object));
+    {
+        std::lock_guard lck(m_mtx);
+        log_debug("GlobalComm::addViewObject {}", m_frames.size());
+        if (m_frames.empty()) throw makeError("empty frame cache");
+        auto &frame = m_frames.back();
+        size_t bytes = estimateObjectBytes(object.get());
+        if (frame.view_objects.try_emplace(key, std::move(object)).second) {
+            frame.mem_bytes += bytes;
+            frame.fully_dumped = false;
+        }
+        _touchFrame(m_frames.size() - 1);
+        _enforceBudget(m_frames.size() - 1);
+    }
+    _spillPending();
 }
 
 ZENO_API void GlobalComm::clearState() {
     std::lock_guard lck(m_mtx);
+    clearDecodedViewObjects();
+    _removeSpillPath();
+    m_evictions = 0;
     m_frames.clear();
+    m_pendingSpills.clear();
     m_inCacheFrames.clear();
     m_maxPlayFrame = 0;
     maxCachedFrames = 1;
@@ -259,7 +490,11 @@ ZENO_API void GlobalComm::clearState() {
 ZENO_API void GlobalComm::clearFrameState()
 {
     std::lock_guard lck(m_mtx);
+    clearDecodedViewObjects();
+    _removeSpillPath();
+    m_evictions = 0;
     m_frames.clear();
+    m_pendingSpills.clear();
     m_inCacheFrames.clear();
     m_maxPlayFrame = 0;
 }
@@ -270,6 +505,136 @@ ZENO_API void GlobalComm::frameCache(std::string const &path, int gcmax) {
     maxCachedFrames = gcmax;
 }
 
+ZENO_API void GlobalComm::frameCacheBudget(size_t maxBytes, int hotRadius) {
+    {
+        std::lock_guard lck(m_mtx);
+        maxCacheBytes = maxBytes;
+        hotFrameRadius = hotRadius;
+        {
+            std::lock_guard lck(decodedMtx);
+            decodedBudget = maxBytes / 4;
+        }
+        _enforceBudget(-1);
+    }
+    _spillPending();
+}
+
+ZENO_API GlobalComm::CacheStats GlobalComm::cacheStats() const {
+    std::lock_guard lck(m_mtx);
+    CacheStats stats;
+    stats.budgetBytes = maxCacheBytes;
+    stats.evictions = m_evictions;
+    for (auto const &frame: m_frames) {
+        stats.memBytes += frame.mem_bytes;
+        stats.framesInMemory += frame.view_objects.size() != 0;
+        stats.framesSpilled += !frame.spill_dir.empty();
+    }
+    {
+        std::lock_guard lck(decodedMtx);
+        stats.decodedBytes = decodedBytes;
+    }
+    return stats;
+}
+
+void GlobalComm::_touchFrame(int frameIdx) {
+    m_frames[frameIdx].last_used = ++m_accessTick;
+}
+
+void GlobalComm::_enforceBudget(int pinnedFrameIdx) {
+    if (!maxCacheBytes)
+        return;
+    size_t total = 0;
+    for (auto const &frame: m_frames)
+        if (!frame.spilling)
+            total += frame.mem_bytes;
+    while (total > maxCacheBytes) {
+        int victim = -1;
+        for (int i = 0; i < m_frames.size(); i++) {
+            auto const &frame = m_frames[i];
+            if (!frame.mem_bytes || frame.spilling || i == pinnedFrameIdx || frame.frame_state != FRAME_COMPLETED)
+                continue;
+            if (std::abs(i + beginFrameNumber - m_currentFrame) <= hotFrameRadius)
+                continue;
+            if (victim == -1 || frame.last_used < m_frames[victim].last_used)
+                victim = i;
+        }
+        if (victim == -1)
+            break;
+        auto &frame = m_frames[victim];
+        int frameid = victim + beginFrameNumber;
+        total -= frame.mem_bytes;
+        if (frame.fully_dumped) {
+            frame.view_objects.clear();
+            frame.mem_bytes = 0;
+            m_inCacheFrames.erase(frameid);
+            m_evictions++;
+            log_debug("frame cache: evicted frame {}, {} MB left in memory", frameid, total >> 20);
+        } else {
+            // written by _spillPending once m_mtx is released
+            frame.spilling = true;
+            m_pendingSpills.push_back(victim);
+        }
+    }
+}
+
+void GlobalComm::_spillPending() {
+    struct Spill {
+        int frameIdx;
+        size_t tick;
+        ViewObjects objs;
+        bool done = false;
+    };
+    std::vector<Spill> spills;
+    std::string spillPath;
+    {
+        std::lock_guard lck(m_mtx);
+        if (m_pendingSpills.empty())
+            return;
+        if (m_spillPath.empty()) {
+            auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+            m_spillPath = (std::filesystem::temp_directory_path() / ("zenospill" + std::to_string(stamp))).u8string();
+        }
+        spillPath = m_spillPath;
+        for (int idx: m_pendingSpills) {
+            auto const &frame = m_frames[idx];
+            spills.push_back({idx, frame.last_used, frame.view_objects});
+        }
+        m_pendingSpills.clear();
+    }
+    // the objects are shared with the frames, which keep serving them meanwhile
+    for (auto &spill: spills) {
+        spill.done = toDisk(spillPath, spill.frameIdx + beginFrameNumber, spill.objs, false, false, "", false);
+    }
+    std::lock_guard lck(m_mtx);
+    for (auto const &spill: spills) {
+        // the frame may have been cleared, replaced or used again in the meantime
+        if (spill.frameIdx >= m_frames.size())
+            continue;
+        auto &frame = m_frames[spill.frameIdx];
+        frame.spilling = false;
+        if (!spill.done || frame.last_used != spill.tick || spillPath != m_spillPath)
+            continue;
+        frame.view_objects.clear();
+        frame.spill_dir = spillPath;
+        frame.fully_dumped = true;
+        frame.mem_bytes = 0;
+        m_evictions++;
+        log_debug("frame cache: spilled frame {}", spill.frameIdx + beginFrameNumber);
+    }
+}
+
+void GlobalComm::_removeSpillPath() {
+    if (m_spillPath.empty())
+        return;
+    for (auto &frame: m_frames)
+        if (frame.spill_dir == m_spillPath)
+            frame.disk_objects.clear();
+    detachViewObjectFiles(std::filesystem::u8path(m_spillPath));
+    std::error_code ec;
+    std::filesystem::remove_all(std::filesystem::u8path(m_spillPath), ec);
+    m_spillPath.clear();
+}
+
 ZENO_API void GlobalComm::initFrameRange(int beg, int end) {
     std::lock_guard lck(m_mtx);
     beginFrameNumber = beg;
@@ -298,20 +663,38 @@ ZENO_API std::pair<int, int> GlobalComm::frameRange() {
 }
 
 ZENO_API GlobalComm::ViewObjects const *GlobalComm::getViewObjects(const int frameid) {
-    std::lock_guard lck(m_mtx);
-    return _getViewObjects(frameid);
+    ViewObjects const *objs;
+    {
+        std::lock_guard lck(m_mtx);
+        objs = _getViewObjects(frameid);
+    }
+    _spillPending();
+    return objs;
 }
 
 GlobalComm::ViewObjects const* GlobalComm::_getViewObjects(const int frameid) {
     int frameIdx = frameid - beginFrameNumber;
     if (frameIdx < 0 || frameIdx >= m_frames.size())
         return nullptr;
-    if (maxCachedFrames != 0) {
+    auto &frame = m_frames[frameIdx];
+    _touchFrame(frameIdx);
+    if (!frame.spill_dir.empty()) {
+        if (!frame.mem_bytes) {
+            if (!fromDisk(frame.spill_dir, frameid, frame.view_objects))
+                return nullptr;
+            for (auto const &[key, obj]: frame.view_objects)
+                frame.mem_bytes += estimateObjectBytes(obj.get());
+            _enforceBudget(frameIdx);
+        }
+    } else if (maxCachedFrames != 0) {
         // load back one gc:
         if (!m_inCacheFrames.count(frameid)) {  // notinmem then cacheit
-            bool ret = fromDisk(cacheFramePath, frameid, m_frames[frameIdx].view_objects);
+            bool ret = fromDisk(cacheFramePath, frameid, frame.view_objects);
             if (!ret)
                 return nullptr;
+            for (auto const &[key, obj]: frame.view_objects)
+                frame.mem_bytes += estimateObjectBytes(obj.get());
+            frame.fully_dumped = true;
 
             m_inCacheFrames.insert(frameid);
             // and dump one as balance:
@@ -322,14 +705,36 @@ GlobalComm::ViewObjects const* GlobalComm::_getViewObjects(const int frameid) {
                         // so, there is no need to dump.
                         //toDisk(cacheFramePath, i, m_frames[i - beginFrameNumber].view_objects);
                         m_frames[i - beginFrameNumber].view_objects.clear();
+                        m_frames[i - beginFrameNumber].mem_bytes = 0;
                         m_inCacheFrames.erase(i);
                         break;
                     }
                 }
             }
+            _enforceBudget(frameIdx);
         }
     }
-    return &m_frames[frameIdx].view_objects;
+    return &frame.view_objects;
+}
+
+GlobalComm::ViewObjectHandles GlobalComm::_getViewObjectHandles(const int frameid) {
+    ViewObjectHandles handles;
+    int frameIdx = frameid - beginFrameNumber;
+    if (frameIdx < 0 || frameIdx >= m_frames.size())
+        return handles;
+    auto &frame = m_frames[frameIdx];
+    _touchFrame(frameIdx);
+    bool spilled = !frame.spill_dir.empty() && !frame.mem_bytes;
+    if (spilled || maxCachedFrames != 0 && !m_inCacheFrames.count(frameid)) {
+        // dumped to disk: hand out the file offsets, consumers decode what they touch
+        if (frame.disk_objects.empty())
+            indexDisk(spilled ? frame.spill_dir : cacheFramePath, frameid, frame.disk_objects);
+        return frame.disk_objects;
+    }
+    for (auto const &[key, obj]: frame.view_objects) {
+        handles[key].object = obj;
+    }
+    return handles;
 }
 
 ZENO_API GlobalComm::ViewObjects const &GlobalComm::getViewObjects() {
@@ -349,7 +754,7 @@ ZENO_API void GlobalComm::clear_objects(const std::function<void()>& callback)
 
 ZENO_API bool GlobalComm::load_objects(
         const int frameid,
-        const std::function<bool(std::map<std::string, std::shared_ptr<zeno::IObject>> const& objs)>& callback,
+        const std::function<bool(ViewObjectHandles const& objs)>& callback,
         bool& isFrameValid)
 {
     if (!callback)
@@ -366,17 +771,10 @@ ZENO_API bool GlobalComm::load_objects(
     }
 
     isFrameValid = true;
-    bool inserted = false;
-    auto const* viewObjs = _getViewObjects(frameid);
-    if (viewObjs) {
-        zeno::log_trace("load_objects: {} objects at frame {}", viewObjs->size(), frameid);
-        inserted = callback(viewObjs->m_curr);
-    }
-    else {
-        zeno::log_trace("load_objects: no objects at frame {}", frameid);
-        inserted = callback({});
-    }
-    return inserted;
+    m_currentFrame = frameid;
+    auto viewObjs = _getViewObjectHandles(frameid);
+    zeno::log_trace("load_objects: {} objects at frame {}", viewObjs.size(), frameid);
+    return callback(viewObjs);
 }
 
 ZENO_API bool GlobalComm::isFrameCompleted(int frameid) const {
@@ -436,6 +834,8 @@ ZENO_API bool GlobalComm::removeCache(int frame)
         if (hasZencacheOnly)
         {
             m_frames[frame - beginFrameNumber].frame_state = FRAME_BROKEN;
+            m_frames[frame - beginFrameNumber].disk_objects.clear();
+            detachViewObjectFiles(dirToRemove);
             std::filesystem::remove_all(dirToRemove);
             zeno::log_info("remove dir: {}", dirToRemove);
         }
@@ -454,6 +854,9 @@ ZENO_API void GlobalComm::removeCachePath()
     std::filesystem::path dirToRemove = std::filesystem::u8path(cacheFramePath);
     if (std::filesystem::exists(dirToRemove) && cacheFramePath.find(".") == std::string::npos)
     {
+        for (auto &frame: m_frames)
+            frame.disk_objects.clear();
+        detachViewObjectFiles(dirToRemove);
         std::filesystem::remove_all(dirToRemove);
         zeno::log_info("remove dir: {}", dirToRemove);
     }
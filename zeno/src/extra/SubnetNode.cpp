@@ -13,6 +13,11 @@ ZENO_API SubnetNode::SubnetNode() : subgraph(std::make_shared<Graph>())
 ZENO_API SubnetNode::~SubnetNode() = default;
 
 ZENO_API void SubnetNode::apply() {
+    if (library) {
+        auto lib = std::move(library);
+        subgraph->instantiateSubgraph(lib, definitionName, instancePrefix);
+    }
+
     for (auto const &[key, nodeid]: subgraph->subInputNodes) {
         //zeno::log_warn("input {} {}", key, nodeid);
         auto node = safe_at(subgraph->nodes, nodeid, "node name").get();
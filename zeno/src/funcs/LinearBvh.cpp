@@ -1,5 +1,6 @@
-#include "LinearBvh.h"
-#include "SpatialUtils.hpp"
+#include <zeno/types/LinearBvh.h>
+#include <zeno/para/parallel_scan.h>
+#include <zeno/utils/morton.h>
 #include <algorithm>
 #include <atomic>
 #include <exception>
@@ -12,6 +13,193 @@
 
 namespace zeno {
 
+namespace {
+
+template <size_t N>
+LBvh::Box element_box(std::vector<vec3f> const &refpos, vec<N, int> const &ids, float thickness) {
+  constexpr auto ma = std::numeric_limits<float>::max();
+  constexpr auto mi = std::numeric_limits<float>::lowest();
+  LBvh::Box bv{vec3f{ma, ma, ma}, vec3f{mi, mi, mi}};
+  for (size_t j = 0; j != N; ++j) {
+    const auto &p = refpos[ids[j]];
+    for (int d = 0; d != 3; ++d) {
+      if (p[d] - thickness < bv.first[d])
+        bv.first[d] = p[d] - thickness;
+      if (p[d] + thickness > bv.second[d])
+        bv.second[d] = p[d] + thickness;
+    }
+  }
+  return bv;
+}
+
+/// calls f with the leaf box functor of the bvh category, so the per-leaf
+/// loops of build and refit are dispatched once instead of per element
+template <class F>
+void visit_leaf_bv(LBvh const &bvh, PrimitiveObject const &prim, F &&f) {
+  using Ti = LBvh::Ti;
+  const auto &refpos = prim.attr<vec3f>("pos");
+  const float thickness = bvh.thickness;
+  switch (bvh.eleCategory) {
+  case LBvh::element_e::tet:
+    f([&quads = prim.quads.values, &refpos, thickness](Ti i) {
+      return element_box(refpos, quads[i], thickness);
+    });
+    break;
+  case LBvh::element_e::tri:
+    f([&tris = prim.tris.values, &refpos, thickness](Ti i) {
+      return element_box(refpos, tris[i], thickness);
+    });
+    break;
+  case LBvh::element_e::line:
+    f([&lines = prim.lines.values, &refpos, thickness](Ti i) {
+      return element_box(refpos, lines[i], thickness);
+    });
+    break;
+  case LBvh::element_e::point:
+    if (bvh.radiusAttr.empty()) {
+      f([&points = prim.points.values, &refpos, thickness](Ti i) {
+        const auto &p = refpos[points[i]];
+        return LBvh::Box{p - thickness, p + thickness};
+      });
+    } else {
+      f([&points = prim.points.values, &refpos, &radius = prim.verts.attr<float>(bvh.radiusAttr),
+         thickness](Ti i) {
+        const auto &p = refpos[points[i]];
+        return LBvh::Box{p - thickness - radius[i], p + thickness + radius[i]};
+      });
+    }
+    break;
+  default:
+    f([](Ti) {
+      constexpr auto ma = std::numeric_limits<float>::max();
+      constexpr auto mi = std::numeric_limits<float>::lowest();
+      return LBvh::Box{vec3f{ma, ma, ma}, vec3f{mi, mi, mi}};
+    });
+    break;
+  }
+}
+
+inline uint64_t topo_mix(uint64_t x) { // splitmix64 finalizer
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/// hash of the vertex indices of the elements of category et, a refit is
+/// only valid while this (and so the leaf -> element mapping) is unchanged
+template <LBvh::element_e et>
+uint64_t element_fingerprint(PrimitiveObject const &prim) {
+  auto hashIds = [&](auto const &arr) {
+    using T = typename std::decay_t<decltype(arr)>::value_type;
+    constexpr std::size_t n = sizeof(T) / sizeof(int);
+    auto const *p = reinterpret_cast<int const *>(arr.data());
+    const intptr_t num = arr.size() * n;
+    uint64_t hash = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : hash)
+#endif
+    for (intptr_t i = 0; i < num; ++i)
+      hash += topo_mix((uint64_t)i << 32 | (uint32_t)p[i]);
+    return topo_mix(hash ^ topo_mix(arr.size() ^ (uint64_t)prim.verts.size() << 32));
+  };
+  if constexpr (et == LBvh::element_e::tet)
+    return hashIds(prim.quads.values);
+  else if constexpr (et == LBvh::element_e::tri)
+    return hashIds(prim.tris.values);
+  else if constexpr (et == LBvh::element_e::line)
+    return hashIds(prim.lines.values);
+  else if constexpr (et == LBvh::element_e::point)
+    return hashIds(prim.points.values);
+  else
+    return 0;
+}
+
+/// number of leaves a build of category et makes out of prim, point builds
+/// fall back to one point per vertex when prim has no points
+template <LBvh::element_e et>
+LBvh::Ti count_leaves(PrimitiveObject &prim) {
+  using Ti = LBvh::Ti;
+  if constexpr (et == LBvh::element_e::tet) {
+    return prim.quads.size();
+  } else if constexpr (et == LBvh::element_e::tri) {
+    return prim.tris.size();
+  } else if constexpr (et == LBvh::element_e::line) {
+    return prim.lines.size();
+  } else if constexpr (et == LBvh::element_e::point) {
+    if (prim.points.size() > 0)
+      return prim.points.size();
+    Ti numLeaves = prim.verts.size();
+    prim.points.resize(numLeaves);
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+    for (Ti i = 0; i < numLeaves; ++i)
+      prim.points[i] = i;
+    return numLeaves;
+  } else {
+    return 0;
+  }
+}
+
+/// stable LSD radix sort by morton code, equal codes keep their ascending ids
+/// just like std::sort of the <mc, id> pairs did
+void radix_sort_records(std::vector<std::pair<LBvh::Tu, LBvh::Ti>> &records) {
+  constexpr int radixBits = 8;
+  constexpr std::size_t numBuckets = 1 << radixBits;
+  const std::size_t n = records.size();
+#if defined(_OPENMP)
+  const int maxThreads = omp_get_max_threads();
+#else
+  const int maxThreads = 1;
+#endif
+  std::vector<std::pair<LBvh::Tu, LBvh::Ti>> sorted(n);
+  std::vector<std::size_t> counts(maxThreads * numBuckets);
+
+  for (int shift = 0; shift < (int)sizeof(LBvh::Tu) * 8; shift += radixBits) {
+    bool skip = false;
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(maxThreads)
+#endif
+    {
+#if defined(_OPENMP)
+      const int numThreads = omp_get_num_threads(), tid = omp_get_thread_num();
+#else
+      const int numThreads = 1, tid = 0;
+#endif
+      const std::size_t first = n * tid / numThreads, last = n * (tid + 1) / numThreads;
+      auto *count = counts.data() + tid * numBuckets;
+      std::fill(count, count + numBuckets, 0);
+      for (std::size_t i = first; i != last; ++i)
+        ++count[(records[i].first >> shift) & (numBuckets - 1)];
+#if defined(_OPENMP)
+#pragma omp barrier
+#pragma omp single
+#endif
+      {
+        // bucket-major, thread-minor offsets keep the sort stable
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b != numBuckets; ++b) {
+          for (int t = 0; t != numThreads; ++t) {
+            auto c = counts[t * numBuckets + b];
+            counts[t * numBuckets + b] = offset;
+            offset += c;
+            if (c == n) // every code shares this digit
+              skip = true;
+          }
+        }
+      }
+      if (!skip)
+        for (std::size_t i = first; i != last; ++i)
+          sorted[count[(records[i].first >> shift) & (numBuckets - 1)]++] = records[i];
+    }
+    if (!skip)
+      records.swap(sorted);
+  }
+}
+
+} // namespace
+
 typename LBvh::BvFunc
 LBvh::getBvFunc(const std::shared_ptr<PrimitiveObject> &prim) const {
   constexpr auto ma = std::numeric_limits<float>::max();
@@ -110,38 +298,9 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
   this->primPtr = prim;
   this->thickness = thickness;
   this->radiusAttr = radiusAttr;
-  Ti numLeaves = 0; // refpos.size();
-
-  {
-    // determine element category
-    if constexpr (et == element_e::tet) {
-      this->eleCategory = element_e::tet;
-      numLeaves = prim->quads.size();
-    } else if constexpr (et == element_e::tri) {
-      this->eleCategory = element_e::tri;
-      numLeaves = prim->tris.size();
-    } else if constexpr (et == element_e::line) {
-      this->eleCategory = element_e::line;
-      numLeaves = prim->lines.size();
-    } else if constexpr (et == element_e::point) {
-      if (prim->points.size() > 0) {
-        this->eleCategory = element_e::point;
-        numLeaves = prim->points.size();
-      } else {
-        this->eleCategory = element_e::point;
-        numLeaves = prim->verts.size();
-        prim->points.resize(numLeaves);
-#if defined(_OPENMP)
-#pragma omp parallel for
-#endif
-        for (Ti i = 0; i < numLeaves; ++i)
-          prim->points[i] = i;
-      }
-    } else {
-      this->eleCategory = element_e::unknown;
-      numLeaves = 0;
-    }
-  }
+  this->eleCategory = et;
+  const Ti numLeaves = count_leaves<et>(*prim);
+  this->topoFingerprint = element_fingerprint<et>(*prim);
 
   const auto &refpos = prim->attr<vec3f>("pos");
   const Ti numNodes = numLeaves > 2 ? numLeaves + numLeaves - 1 : numLeaves;
@@ -151,16 +310,17 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
   parents.resize(numNodes);
   leafIndices.resize(numLeaves);
 
-  this->getBv = getBvFunc(prim);
-
   if (numLeaves <= 2) { // edge cases where not enough primitives to form a tree
-    for (Ti i = 0; i != numLeaves; ++i) {
-      sortedBvs[i] = getBv(i);
-      leafIndices[i] = i;
-      levels[i] = 0;
-      auxIndices[i] = i;
-      parents[i] = -1;
-    }
+    visit_leaf_bv(*this, *prim, [&](auto const &getBv) {
+      for (Ti i = 0; i != numLeaves; ++i) {
+        sortedBvs[i] = getBv(i);
+        leafIndices[i] = i;
+        levels[i] = 0;
+        auxIndices[i] = i;
+        parents[i] = -1;
+      }
+    });
+    quality = 0.f;
     return;
   }
 
@@ -216,16 +376,10 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
   std::vector<std::pair<Tu, Ti>> records(numLeaves); // <mc, id>
   /// morton codes
   auto getMortonCode = [](const TV &p) -> Tu {
-    auto expand_bits = [](Tu v) -> Tu { // expands lower 10-bits to 30 bits
-      v = (v * 0x00010001u) & 0xFF0000FFu;
-      v = (v * 0x00000101u) & 0x0F00F00Fu;
-      v = (v * 0x00000011u) & 0xC30C30C3u;
-      v = (v * 0x00000005u) & 0x49249249u;
-      return v;
-    };
-    return (expand_bits((Tu)(p[0] * 1024.f)) << (Tu)2) |
-           (expand_bits((Tu)(p[1] * 1024.f)) << (Tu)1) |
-           expand_bits((Tu)(p[2] * 1024.f));
+    // 10 bits per axis, x in the highest bit of each triple; p is in [0, 1],
+    // clamp so that p == 1 does not spill into bit 10 of the next axis
+    auto quantize = [](float v) { return std::min((Tu)(v * 1024.f), (Tu)1023); };
+    return (Tu)morton3d::encode(quantize(p[2]), quantize(p[1]), quantize(p[0]));
   };
   {
     const auto lengths = wholeBox.second - wholeBox.first;
@@ -278,7 +432,7 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
       }
     }
   }
-  std::sort(std::begin(records), std::end(records));
+  radix_sort_records(records);
 
   std::vector<Tu> splits(numLeaves);
   ///
@@ -322,6 +476,14 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
         }
 #endif
 
+  visit_leaf_bv(*this, *prim, [&](auto const &getBv) {
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+    for (Ti idx = 0; idx < numLeaves; ++idx)
+      leafBvs[idx] = getBv(records[idx].second);
+  });
+
   {
     std::vector<Ti> trunkL(numLeaves - 1);
     std::vector<Ti> trunkRc(numLeaves - 1);
@@ -329,8 +491,6 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
 #pragma omp parallel for
 #endif
     for (Ti idx = 0; idx < numLeaves; ++idx) {
-      leafBvs[idx] = getBv(records[idx].second);
-
       leafLca[idx] = -1, leafDepths[idx] = 1;
       Ti l = idx - 1, r = idx; ///< (l, r]
       bool mark{false};
@@ -400,8 +560,7 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
 
   std::vector<Ti> leafOffsets(numLeaves + 1);
   leafOffsets[0] = 0;
-  for (Ti i = 1; i <= numLeaves; ++i)
-    leafOffsets[i] = leafOffsets[i - 1] + leafDepths[i - 1];
+  parallel_inclusive_scan_sum(leafDepths.begin(), leafDepths.end(), leafOffsets.begin() + 1);
   std::vector<Ti> trunkDst(numLeaves - 1);
   /// compute trunk order
   // [levels], [parents], [trunkDst]
@@ -465,6 +624,8 @@ void LBvh::build(const std::shared_ptr<PrimitiveObject> &prim, float thickness,
     // if (leafDepth > 1) parents[dst + 1] = dst - 1;  // setup right-branch
     // brother's parent
   }
+
+  quality = surfaceAreaRatio();
 }
 
 template void
@@ -500,17 +661,18 @@ void LBvh::refit() {
   if (!prim)
     throw std::runtime_error(
         "the primitive object referenced by lbvh not available anymore");
-  const auto &refpos = prim->attr<vec3f>("pos");
 
   const auto numLeaves = getNumLeaves();
   if (numLeaves <= 2) {
-    for (Ti i = 0; i != numLeaves; ++i) {
-      sortedBvs[i] = getBv(i);
-      leafIndices[i] = i;
-      levels[i] = 0;
-      auxIndices[i] = i;
-      parents[i] = -1;
-    }
+    visit_leaf_bv(*this, *prim, [&](auto const &getBv) {
+      for (Ti i = 0; i != numLeaves; ++i) {
+        sortedBvs[i] = getBv(i);
+        leafIndices[i] = i;
+        levels[i] = 0;
+        auxIndices[i] = i;
+        parents[i] = -1;
+      }
+    });
     return;
   }
   const auto numNodes = numLeaves * 2 - 1;
@@ -522,7 +684,7 @@ void LBvh::refit() {
             refitFlags[i] = 0;
 #endif
 
-  {
+  visit_leaf_bv(*this, *prim, [&](auto const &getBv) {
 #if defined(_OPENMP)
 #pragma omp parallel for
 #endif
@@ -555,7 +717,69 @@ void LBvh::refit() {
         par = parents[par];
       }
     }
+  });
+}
+
+float LBvh::surfaceAreaRatio() const {
+  const Ti numNodes = sortedBvs.size();
+  if (getNumLeaves() <= 2)
+    return 0.f;
+  auto area = [](const Box &bv) {
+    auto e = bv.second - bv.first;
+    return 2.f * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]);
+  };
+  const float rootArea = area(sortedBvs[0]);
+  if (!(rootArea > 0.f))
+    return 0.f;
+  double sum = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : sum)
+#endif
+  for (Ti i = 0; i < numNodes; ++i)
+    if (levels[i] != 0)
+      sum += area(sortedBvs[i]);
+  return (float)(sum / rootArea);
+}
+
+template <LBvh::element_e et>
+bool LBvh::refitOrBuild(const std::shared_ptr<PrimitiveObject> &prim, float thickness, std::string radiusAttr,
+                        element_t<et> t, float maxGrowth) {
+  const Ti numLeaves = count_leaves<et>(*prim);
+  if (eleCategory == et && this->thickness == thickness && this->radiusAttr == radiusAttr &&
+      numLeaves > 2 && numLeaves == getNumLeaves() && sortedBvs.size() == getNumNodes() &&
+      element_fingerprint<et>(*prim) == topoFingerprint) {
+    this->primPtr = prim;
+    refit();
+    if (surfaceAreaRatio() <= quality * maxGrowth)
+      return true;
   }
+  build(prim, thickness, std::move(radiusAttr), t);
+  return false;
+}
+
+template bool
+LBvh::refitOrBuild<LBvh::element_e::point>(const std::shared_ptr<PrimitiveObject> &,
+                                           float, std::string, element_t<element_e::point>, float);
+template bool
+LBvh::refitOrBuild<LBvh::element_e::line>(const std::shared_ptr<PrimitiveObject> &,
+                                          float, std::string, element_t<element_e::line>, float);
+template bool
+LBvh::refitOrBuild<LBvh::element_e::tri>(const std::shared_ptr<PrimitiveObject> &,
+                                         float, std::string, element_t<element_e::tri>, float);
+template bool
+LBvh::refitOrBuild<LBvh::element_e::tet>(const std::shared_ptr<PrimitiveObject> &,
+                                         float, std::string, element_t<element_e::tet>, float);
+
+bool LBvh::refitOrBuild(const std::shared_ptr<PrimitiveObject> &prim,
+                        float thickness, std::string radiusAttr, float maxGrowth) {
+  if (prim->quads.size() > 0)
+    return refitOrBuild(prim, thickness, std::move(radiusAttr), element_c<element_e::tet>, maxGrowth);
+  else if (prim->tris.size() > 0)
+    return refitOrBuild(prim, thickness, std::move(radiusAttr), element_c<element_e::tri>, maxGrowth);
+  else if (prim->lines.size() > 0)
+    return refitOrBuild(prim, thickness, std::move(radiusAttr), element_c<element_e::line>, maxGrowth);
+  else
+    return refitOrBuild(prim, thickness, std::move(radiusAttr), element_c<element_e::point>, maxGrowth);
 }
 
 /// nearest primitive
@@ -755,6 +979,51 @@ typename LBvh::TV LBvh::find_nearest_with_uv(TV const &pos, TV const &uv, Ti &id
     return find_nearest_with_uv(pos, uv, id, dist, uvDist, distEps, element_c<element_e::point>);
 }
 
+float LBvh::ray_intersect(TV const &ro, TV const &rd, Ti &id, float tmin, float tmax) const {
+  std::shared_ptr<const PrimitiveObject> prim = primPtr.lock();
+  if (!prim)
+    throw std::runtime_error(
+        "the primitive object referenced by lbvh not available anymore");
+  if (eleCategory != element_e::tri)
+    throw std::runtime_error("ray_intersect requires a lbvh built over tris");
+  const auto &refpos = prim->attr<vec3f>("pos");
+
+  const TV invd{1 / rd[0], 1 / rd[1], 1 / rd[2]};
+  float ret = std::numeric_limits<float>::infinity();
+  // a box is worth visiting only if it may hold a hit closer than ret
+  auto reachable = [&](const Box &bv) {
+    float t0 = tmin, t1 = tmax;
+    if (!intersect_ray(bv, ro, invd, t0, t1))
+      return false;
+    float closest = t0 > 0 ? t0 : (t1 < 0 ? -t1 : 0.f);
+    return closest < std::abs(ret);
+  };
+
+  const Ti numNodes = sortedBvs.size();
+  Ti node = 0;
+  while (node != -1 && node != numNodes) {
+    Ti level = levels[node];
+    // level and node are always in sync
+    for (; level; --level, ++node)
+      if (!reachable(sortedBvs[node]))
+        break;
+    // leaf node check
+    if (level == 0) {
+      const auto eid = auxIndices[node];
+      auto tri = prim->tris[eid];
+      float t = ray_tri_intersect(ro, rd, refpos[tri[0]], refpos[tri[1]],
+                                  refpos[tri[2]]);
+      if (tmin <= t && t <= tmax && std::abs(t) < std::abs(ret)) {
+        id = eid;
+        ret = t;
+      }
+      node++;
+    } else // separate at internal nodes
+      node = auxIndices[node];
+  }
+  return ret;
+}
+
 std::shared_ptr<PrimitiveObject> LBvh::retrievePrimitive(Ti eid) const {
   std::shared_ptr<const PrimitiveObject> prim = primPtr.lock();
   if (!prim)
@@ -0,0 +1,286 @@
+#include <zeno/funcs/NoiseBatch.h>
+#include <zeno/utils/perlin.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+
+// runtime-dispatched clones of the hot loops, this file is built with -ffp-contract=off
+// (AVX-512 brings FMA, which would change the rounding of the scalar expressions) and
+// -fno-trapping-math (needed for floor to vectorize, values are unaffected)
+#if !defined(ZENO_NOISE_KERNEL) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__ELF__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define ZENO_NOISE_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef ZENO_NOISE_KERNEL
+#define ZENO_NOISE_KERNEL
+#endif
+
+// the per-point noise must be inlined into each clone for its loop to vectorize
+#if defined(__GNUC__)
+#define ZENO_NOISE_INLINE inline __attribute__((always_inline))
+#else
+#define ZENO_NOISE_INLINE inline
+#endif
+
+namespace zeno {
+namespace {
+
+constexpr std::size_t kNoiseBlock = 1024;
+
+template <class Func>
+void noise_for_blocks(std::size_t n, Func const &func) {
+    int nblocks = (int)((n + kNoiseBlock - 1) / kNoiseBlock);
+#pragma omp parallel for if (nblocks > 1)
+    for (int b = 0; b < nblocks; b++) {
+        std::size_t first = (std::size_t)b * kNoiseBlock;
+        func(first, std::min(n, first + kNoiseBlock));
+    }
+}
+
+ZENO_NOISE_INLINE float noise_coord(vec3f const *p, std::size_t i, int c) {
+    return reinterpret_cast<float const *>(p)[i * 3 + c];
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Perlin Noise
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// same results as the switch over `hash & 0xF` in the scalar versions, but
+// written as selects so that the loops calling it can be vectorized
+ZENO_NOISE_INLINE float noise_grad(int hash, float x, float y, float z) {
+    int h = hash & 0xF;
+    float a = h < 8 ? x : y;
+    float b = h < 4 ? y : h == 0xC || h == 0xE ? x : z;
+    return ((h & 1) ? -a : a) + ((h & 2) ? -b : b);
+}
+
+ZENO_NOISE_INLINE float noise_perlin(float x, float y, float z) {
+    auto const *perm = PerlinNoise1::permutation;
+    x = fract(x / 256.f) * 256.f;
+    y = fract(y / 256.f) * 256.f;
+    z = fract(z / 256.f) * 256.f;
+    int xi = (int)x & 255;
+    int yi = (int)y & 255;
+    int zi = (int)z & 255;
+    float xf = x - (int)x;
+    float yf = y - (int)y;
+    float zf = z - (int)z;
+    float u = PerlinNoise1::fade(xf);
+    float v = PerlinNoise1::fade(yf);
+    float w = PerlinNoise1::fade(zf);
+    int a = perm[xi] + yi;
+    int b = perm[xi + 1] + yi;
+    int aa = perm[a], ab = perm[a + 1];
+    int ba = perm[b], bb = perm[b + 1];
+    float x1 = mix(noise_grad(perm[aa + zi], xf, yf, zf),
+                   noise_grad(perm[ba + zi], xf - 1, yf, zf), u);
+    float x2 = mix(noise_grad(perm[ab + zi], xf, yf - 1, zf),
+                   noise_grad(perm[bb + zi], xf - 1, yf - 1, zf), u);
+    float y1 = mix(x1, x2, v);
+    x1 = mix(noise_grad(perm[aa + zi + 1], xf, yf, zf - 1),
+             noise_grad(perm[ba + zi + 1], xf - 1, yf, zf - 1), u);
+    x2 = mix(noise_grad(perm[ab + zi + 1], xf, yf - 1, zf - 1),
+             noise_grad(perm[bb + zi + 1], xf - 1, yf - 1, zf - 1), u);
+    float y2 = mix(x1, x2, v);
+    return mix(y1, y2, w);
+}
+
+ZENO_NOISE_KERNEL
+void perlin_kernel(vec3f const *p, float *out, std::size_t n, int rot, std::size_t outStride) {
+    int r0 = rot % 3, r1 = (rot + 1) % 3, r2 = (rot + 2) % 3;
+#pragma omp simd
+    for (std::size_t i = 0; i < n; i++)
+        out[i * outStride] = noise_perlin(noise_coord(p, i, r0), noise_coord(p, i, r1), noise_coord(p, i, r2));
+}
+
+ZENO_NOISE_KERNEL
+void fbm_octave_kernel(vec3f const *p, float *t, std::size_t n, float amplitude, float frequence) {
+#pragma omp simd
+    for (std::size_t i = 0; i < n; i++)
+        t[i] += amplitude * noise_perlin(frequence * p[i][0], frequence * p[i][1], frequence * p[i][2]);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Simplex Noise
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// kept as in the scalar version: zero maps to -1, callers depend on the bits
+ZENO_NOISE_INLINE int noise_fastfloor(double x) {
+    return (int)x - (x > 0 ? 0 : 1);
+}
+
+ZENO_NOISE_INLINE float noise_simplex_corner(int gi, float x, float y, float z) {
+    float t = 0.6f - x * x - y * y - z * z;
+    return t < 0 ? 0.0f : (t * t) * (t * t) * noise_grad(gi, x, y, z);
+}
+
+ZENO_NOISE_INLINE float noise_simplex(float x, float y, float z) {
+    auto const *perm = PerlinNoise1::permutation;
+    const float F3 = 1.0f / 3.0f;
+    const float G3 = 1.0f / 6.0f;
+
+    float s = (x + y + z) * F3;
+    int i = noise_fastfloor(x + double(s));
+    int j = noise_fastfloor(y + double(s));
+    int k = noise_fastfloor(z + double(s));
+    float t = (float)(i + j + k) * G3;
+    float x0 = x - ((float)i - t);
+    float y0 = y - ((float)j - t);
+    float z0 = z - ((float)k - t);
+
+    // corner offsets of the tetrahedron, the branches of the scalar version as masks
+    bool xy = x0 >= y0, yz = y0 >= z0, xz = x0 >= z0;
+    int i1 = xy && (yz || xz);
+    int j1 = !xy && yz;
+    int k1 = xy ? !yz && !xz : !yz;
+    int i2 = xy || (yz && xz);
+    int j2 = !xy || yz;
+    int k2 = xy ? !yz : !yz || !xz;
+
+    float x1 = x0 - (float)i1 + G3;
+    float y1 = y0 - (float)j1 + G3;
+    float z1 = z0 - (float)k1 + G3;
+    float x2 = x0 - (float)i2 + 2.0f * G3;
+    float y2 = y0 - (float)j2 + 2.0f * G3;
+    float z2 = z0 - (float)k2 + 2.0f * G3;
+    float x3 = x0 - 1.0f + 3.0f * G3;
+    float y3 = y0 - 1.0f + 3.0f * G3;
+    float z3 = z0 - 1.0f + 3.0f * G3;
+
+    int ii = i & 0xff;
+    int jj = j & 0xff;
+    int kk = k & 0xff;
+    int gi0 = perm[ii + perm[jj + perm[kk]]];
+    int gi1 = perm[ii + i1 + perm[jj + j1 + perm[kk + k1]]];
+    int gi2 = perm[ii + i2 + perm[jj + j2 + perm[kk + k2]]];
+    int gi3 = perm[ii + 1 + perm[jj + 1 + perm[kk + 1]]];
+
+    float n0 = noise_simplex_corner(gi0, x0, y0, z0);
+    float n1 = noise_simplex_corner(gi1, x1, y1, z1);
+    float n2 = noise_simplex_corner(gi2, x2, y2, z2);
+    float n3 = noise_simplex_corner(gi3, x3, y3, z3);
+    return 32.0f * (n0 + n1 + n2 + n3);
+}
+
+ZENO_NOISE_KERNEL
+void simplex_kernel(vec3f const *p, float *out, std::size_t n, int rot, std::size_t outStride) {
+    int r0 = rot % 3, r1 = (rot + 1) % 3, r2 = (rot + 2) % 3;
+#pragma omp simd
+    for (std::size_t i = 0; i < n; i++)
+        out[i * outStride] = noise_simplex(noise_coord(p, i, r0), noise_coord(p, i, r1), noise_coord(p, i, r2));
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Worley Noise
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// sin-hashed feature points, left scalar: a vector sin would not match libm bit for bit
+glm::vec3 noise_random3(glm::vec3 p) {
+    glm::vec3 val = sin(glm::vec3(dot(p, glm::vec3(127.1, 311.7, 74.7)),
+        dot(p, glm::vec3(269.5, 183.3, 246.1)),
+        dot(p, glm::vec3(113.5, 271.9, 124.6))));
+    val *= 43758.5453123;
+    return fract(val);
+}
+
+float noise_mydistance(glm::vec3 a, glm::vec3 b, int t) {
+    if (t == 0) {
+        float d = length(a - b);
+        return d*d;
+    }
+    else if (t == 1) {
+        float xx = abs(a.x - b.x);
+        float yy = abs(a.y - b.y);
+        float zz = abs(a.z - b.z);
+        return max(max(xx, yy), zz);
+    }
+    else {
+        float xx = abs(a.x - b.x);
+        float yy = abs(a.y - b.y);
+        float zz = abs(a.z - b.z);
+        return xx + yy + zz;
+    }
+}
+
+float noise_worley(float px, float py, float pz, int fType, int distType, glm::vec3 offset, float jitter) {
+    glm::vec3 pos = glm::vec3(px, py, pz);
+    glm::vec3 i_pos = floor(pos);
+    glm::vec3 f_pos = fract(pos);
+
+    float f1 = 9e9;
+    float f2 = f1;
+
+    for (int z = -1; z <= 1; z++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int x = -1; x <= 1; x++) {
+                glm::vec3 neighbor = glm::vec3(float(x), float(y), float(z));
+                glm::vec3 point = noise_random3(i_pos + neighbor);
+                point = (float)0.5 + (float)0.5 * sin(offset + (float)6.2831 * point);
+                point = point * jitter;
+                glm::vec3 featurePoint = neighbor + point;
+
+                float dist = noise_mydistance(featurePoint, f_pos, distType);
+                if (dist < f1) {
+                    f2 = f1; f1 = dist;
+                }
+                else if (dist < f2) {
+                    f2 = dist;
+                }
+            }
+        }
+    }
+
+    return fType == 0 ? f1 : f2 - f1;
+}
+
+}
+
+ZENO_API void noisePerlinBatch(vec3f const *p, float *out, std::size_t n, int rot, std::size_t outStride) {
+    noise_for_blocks(n, [&] (std::size_t first, std::size_t last) {
+        perlin_kernel(p + first, out + first * outStride, last - first, rot, outStride);
+    });
+}
+
+ZENO_API void noiseSimplexBatch(vec3f const *p, float *out, std::size_t n, int rot, std::size_t outStride) {
+    noise_for_blocks(n, [&] (std::size_t first, std::size_t last) {
+        simplex_kernel(p + first, out + first * outStride, last - first, rot, outStride);
+    });
+}
+
+ZENO_API void noiseWorleyBatch(vec3f const *p, float *out, std::size_t n, int fType, int distType,
+                               vec3f offset, float jitter, int rot, std::size_t outStride) {
+    int r0 = rot % 3, r1 = (rot + 1) % 3, r2 = (rot + 2) % 3;
+    glm::vec3 goffset(offset[0], offset[1], offset[2]);
+    noise_for_blocks(n, [&] (std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++)
+            out[i * outStride] = noise_worley(noise_coord(p, i, r0), noise_coord(p, i, r1), noise_coord(p, i, r2),
+                                              fType, distType, goffset, jitter);
+    });
+}
+
+ZENO_API void noiseFbmBatch(vec3f const *p, float *out, std::size_t n, float H, float lacunarity,
+                            float frequence, int octaves) {
+    noise_for_blocks(n, [&] (std::size_t first, std::size_t last) {
+        std::fill(out + first, out + last, 0.0f);
+        float freq = frequence;
+        for (int i = 0; i < octaves; i++) {
+            float amplitude = pow(lacunarity, -H * i);
+            fbm_octave_kernel(p + first, out + first, last - first, amplitude, freq);
+            freq *= lacunarity;
+        }
+    });
+}
+
+ZENO_API void noiseFractalPerlinBatch(vec3f const *p, float *out, std::size_t n, float power, float depth,
+                                      int rot, std::size_t outStride) {
+    int r0 = rot % 3, r1 = (rot + 1) % 3, r2 = (rot + 2) % 3;
+    noise_for_blocks(n, [&] (std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            vec3f q(noise_coord(p, i, r0), noise_coord(p, i, r1), noise_coord(p, i, r2));
+            out[i * outStride] = PerlinNoise::perlin(q, power, depth);
+        }
+    });
+}
+
+}
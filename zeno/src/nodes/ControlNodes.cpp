@@ -5,6 +5,11 @@
 #include <zeno/extra/ContextManaged.h>
 #include <zeno/extra/evaluate_condition.h>
 #include <zeno/utils/safe_at.h>
+#include <zeno/utils/log.h>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
 
 namespace zeno {
 
@@ -170,10 +175,212 @@ ZENDEFNODE(BeginForEach, {
     {"control"},
 });
 
+// stands in for a node evaluated outside of a parallel loop body, only serves its outputs
+struct ForEachProxyNode : zeno::INode {
+    virtual void apply() override {}
+};
+
+// per-worker copy of a loop-invariant object, so body nodes editing their inputs in place
+// don't race; objects that can't be cloned are shared as they are
+static zany cloneForWorker(zany const &obj) {
+    if (auto lst = dynamic_cast<ListObject *>(obj.get())) {
+        auto ret = std::make_shared<ListObject>();
+        ret->arr.reserve(lst->arr.size());
+        for (auto const &x: lst->arr)
+            ret->arr.push_back(cloneForWorker(x));
+        return ret;
+    }
+    if (!obj)
+        return obj;
+    auto ret = obj->clone();
+    return ret ? ret : obj;
+}
+
 struct EndForEach : EndFor {
     std::vector<zany> result;
     std::vector<zany> dropped_result;
 
+    // nodes between BeginForEach and us, plus the loop-invariant nodes they read from;
+    // false if the body holds nodes that are not marked bThreadSafe
+    bool collectLoopBody(std::string const &beginId, std::vector<std::string> &body,
+                         std::set<std::string> &externs) const {
+        std::map<std::string, bool> dependsOnBegin;
+        std::function<bool(std::string const &)> visit = [&] (std::string const &id) {
+            if (id == beginId)
+                return true;
+            if (auto it = dependsOnBegin.find(id); it != dependsOnBegin.end())
+                return it->second;
+            dependsOnBegin[id] = false;
+            bool dep = false;
+            for (auto const &[ds, bound]: safe_at(graph->nodes, id, "node name")->inputBounds) {
+                dep = visit(bound.first) || dep;
+            }
+            dependsOnBegin[id] = dep;
+            return dep;
+        };
+        for (auto const &ds: {"object", "list", "accept"}) {
+            if (auto it = inputBounds.find(ds); it != inputBounds.end() && !visit(it->second.first))
+                externs.insert(it->second.first);
+        }
+        for (auto const &[id, dep]: dependsOnBegin) {
+            if (!dep)
+                continue;
+            auto node = graph->nodes.at(id).get();
+            if (!node->bThreadSafe || node->bTmpCache) {
+                log_warn("EndForEach: `{}` is not safe to run concurrently, running `{}` serially", id, myname);
+                return false;
+            }
+            body.push_back(id);
+            for (auto const &[ds, bound]: node->inputBounds) {
+                if (bound.first != beginId && !dependsOnBegin.at(bound.first))
+                    externs.insert(bound.first);
+            }
+        }
+        return true;
+    }
+
+    // runs the iterations concurrently, each worker owns a copy of the loop body nodes
+    bool parallelApply() {
+        auto [sn, ss] = safe_at(inputBounds, "FOR", "input socket of EndForEach");
+        auto fore = dynamic_cast<BeginForEach *>(graph->nodes.at(sn).get());
+        if (!fore || inputBounds.count("accumate"))
+            return false;
+        std::vector<std::string> body;
+        std::set<std::string> externs;
+        if (!collectLoopBody(sn, body, externs))
+            return false;
+
+        graph->applyNode(sn);
+        push_context();
+        for (auto const &id: externs) {
+            graph->applyNode(id);
+        }
+
+        auto list = fore->m_list;
+        std::size_t count = list->arr.size();
+        std::size_t nworkers = std::min<std::size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+        // proxies are always up to date, start each iteration with them visited
+        Context proxiesVisited;
+        auto newWorker = [&, beginId = sn] (bool cloneExterns) {
+            auto g = std::make_shared<Graph>();
+            g->session = graph->session;
+            g->subgraphNode = graph->subgraphNode;
+            for (auto const &id: externs) {
+                auto src = graph->nodes.at(id).get();
+                auto proxy = g->insertNode(id, std::make_unique<ForEachProxyNode>());
+                proxiesVisited.visited.set(proxy->nodeId);
+                proxy->nodeClass = src->nodeClass;
+                proxy->outputs = src->outputs;
+                proxy->muted_output = src->muted_output;
+                if (cloneExterns) {
+                    for (auto &[key, obj]: proxy->outputs)
+                        obj = cloneForWorker(obj);
+                    proxy->muted_output = cloneForWorker(proxy->muted_output);
+                }
+            }
+            auto beginProxy = g->insertNode(beginId, std::make_unique<ForEachProxyNode>());
+            proxiesVisited.visited.set(beginProxy->nodeId);
+            beginProxy->outputs = fore->outputs;
+            for (auto const &id: body) {
+                auto src = graph->nodes.at(id).get();
+                auto node = g->insertNode(id, src->nodeClass->new_instance());
+                node->nodeClass = src->nodeClass;
+                node->inputBounds = src->inputBounds;
+                node->inputs = src->inputs;
+                node->kframes = src->kframes;
+                node->formulas = src->formulas;
+            }
+            for (auto const &id: body) {
+                g->completeNode(id);
+            }
+            return g;
+        };
+        // the first worker reads the objects of the main graph, as the serial loop would
+        std::vector<std::shared_ptr<Graph>> workers(nworkers);
+        for (std::size_t w = 0; w < nworkers; w++) {
+            workers[w] = newWorker(w != 0);
+        }
+
+        struct Slot {
+            bool accept = true;
+            zany object;
+            std::vector<zany> items;
+        };
+        std::vector<Slot> slots(count);
+        std::atomic<std::size_t> next{0};
+        std::size_t lastWorker = 0;
+        std::exception_ptr error;
+        std::mutex error_mtx;
+        auto runWorker = [&] (std::size_t w) {
+            auto g = workers[w].get();
+            auto begin = g->nodes.at(sn).get();
+            auto fetch = [&] (std::string const &ds) {
+                auto const &[dn, ds2] = inputBounds.at(ds);
+                g->applyNode(dn);
+                return g->getNodeOutput(dn, ds2);
+            };
+            try {
+                for (std::size_t i; (i = next.fetch_add(1)) < count;) {
+                    auto index = std::make_shared<NumericObject>();
+                    index->set((int)i);
+                    begin->outputs["index"] = std::move(index);
+                    begin->outputs["object"] = list->arr[i];
+                    g->ctx = std::make_unique<Context>(proxiesVisited);
+
+                    auto &slot = slots[i];
+                    if (inputBounds.count("accept"))
+                        slot.accept = evaluate_condition(fetch("accept").get());
+                    if (inputBounds.count("object"))
+                        slot.object = fetch("object");
+                    if (inputBounds.count("list"))
+                        slot.items = safe_dynamic_cast<ListObject>(fetch("list"), "list of EndForEach")->arr;
+                    if (i == count - 1)
+                        lastWorker = w;
+                }
+            } catch (...) {
+                std::lock_guard lck(error_mtx);
+                if (!error)
+                    error = std::current_exception();
+            }
+            g->ctx = nullptr;
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t w = 1; w < nworkers; w++) {
+            threads.emplace_back(runWorker, w);
+        }
+        if (nworkers)
+            runWorker(0);
+        for (auto &t: threads) {
+            t.join();
+        }
+        auto old_ctx = pop_context();
+        if (error)
+            std::rethrow_exception(error);
+
+        for (auto &slot: slots) {
+            auto &dst = slot.accept ? result : dropped_result;
+            if (slot.object)
+                dst.push_back(std::move(slot.object));
+            for (auto &obj: slot.items)
+                dst.push_back(std::move(obj));
+        }
+        // like the serial loop, body nodes refered from outside see the last iteration
+        if (count) {
+            auto g = workers[lastWorker].get();
+            for (auto const &id: body) {
+                auto node = graph->nodes.at(id).get();
+                node->outputs = g->nodes.at(id)->outputs;
+                node->muted_output = g->nodes.at(id)->muted_output;
+                graph->ctx->visited.set(node->nodeId);
+            }
+            fore->outputs = g->nodes.at(sn)->outputs;
+        }
+        if (old_ctx)
+            graph->ctx->mergeVisited(*old_ctx);
+        fore->m_index = count;
+        return true;
+    }
+
     virtual void post_do_apply() override {
         bool accept = true;
         if (requireInput("accept")) {
@@ -210,7 +417,8 @@ struct EndForEach : EndFor {
     }
 
     virtual void preApply() override {
-        EndFor::preApply();
+        if (!get_input2<bool>("parallel:", false) || !parallelApply())
+            EndFor::preApply();
         if (get_param<bool>("doConcat")) {
             decltype(result) newres;
             for (auto &xs: result) {
@@ -243,7 +451,7 @@ struct EndForEach : EndFor {
 ZENDEFNODE(EndForEach, {
     {"object", "list", "accumate", {"bool", "accept", "1"}, "FOR"},
     {"list", "droppedList", "accumate"},
-    {{"bool", "doConcat", "0"}},
+    {{"bool", "doConcat", "0"}, {"bool", "parallel", "0"}},
     {"control"},
 });
 
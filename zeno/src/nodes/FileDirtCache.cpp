@@ -19,7 +19,7 @@ struct CacheToDisk : zeno::INode {
         if (auto it = inputBounds.find("object"); it != inputBounds.end()) {
             auto snid = it->second.first;
             auto &dc = graph->getDirtyChecker();
-            if (dc.amIDirty(snid)) {
+            if (dc.amIDirty(graph->getNode(snid)->nodeId)) {
                 invalidateCache();
             } else {
                 if (auto cached = tryGetCached()) {
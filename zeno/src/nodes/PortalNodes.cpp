@@ -29,6 +29,10 @@ ZENDEFNODE(PortalIn, {
 });
 
 struct PortalOut : zeno::INode {
+    PortalOut() {
+        bReusableTemp = true;
+    }
+
     virtual void apply() override {
         auto name = get_param<std::string>("name");
         auto depnode = zeno::safe_at(graph->portalIns, name, "PortalIn");
@@ -14,6 +14,10 @@ namespace zeno {
 namespace {
 
 struct PrimFillAttr : INode {
+    PrimFillAttr() {
+        bThreadSafe = true;
+    }
+
     virtual void apply() override {
         auto prim = get_input<PrimitiveObject>("prim");
         auto value = get_input<NumericObject>("value");
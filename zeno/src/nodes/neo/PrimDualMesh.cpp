@@ -102,59 +102,50 @@ struct PrimDualMesh : INode {
             primPolygonate(prim.get());
         }
 
+        auto topo = primGetTopology(prim.get());
+        int polyBase = topo->polyFaceBase();
+        auto isPolyHalfedge = [&] (int h) {
+            return topo->heFace[h] >= polyBase;
+        };
+
         scope_exit<> revertoldpolysize;
+        std::vector<std::pair<int, int>> boundv2f; // (vert, face) of the boundary 2-gons, sorted by vert
         if (keepBounds) {
-            std::map<std::pair<int, int>, int> bounde2f;
-            {
-                std::vector<std::pair<int, int>> notbound;
-                for (int f = 0; f < prim->polys.size(); f++) {
-                    auto each_edge = [&] (int v1, int v2) {
-                        std::pair<int, int> key(std::min(v1, v2), std::max(v1, v2));
-                        auto [it, succ] = bounde2f.try_emplace(key, f);
-                        if (!succ) {
-                            notbound.push_back(key);
-                            it->second = -1;
-                        }
-                    };
-                    auto [start, len] = prim->polys[f];
-                    if (len >= 1) {
-                        for (int l = start; l < start + len - 1; l++) {
-                            each_edge(prim->loops[l], prim->loops[l + 1]);
-                        }
-                        each_edge(prim->loops[start + len - 1], prim->loops[start]);
-                    }
-                }
-                for (auto const &nbk: notbound)
-                    bounde2f.erase(nbk);
-            }
             auto oldpolysize = prim->polys.size();
             revertoldpolysize = scope_exit<>([prim, oldpolysize] {
                 prim->polys.resize(oldpolysize);
             });
-            for (auto const &[ev, f]: bounde2f) {
-                auto [v1, v2] = ev;
+            for (int e = 0; e < topo->edges.size(); e++) {
+                int npolyhe = 0;
+                for (int k = topo->edgeStart[e]; k < topo->edgeStart[e + 1]; k++)
+                    npolyhe += isPolyHalfedge(topo->edgeHalfedges[k]);
+                if (npolyhe != 1)
+                    continue;
+                auto [v1, v2] = topo->edges[e];
+                int f = prim->polys.size();
                 int loopbase = prim->loops.size();
                 prim->loops.push_back(v1);
                 prim->loops.push_back(v2);
                 prim->polys.emplace_back(loopbase, 2);
+                boundv2f.emplace_back(v1, f);
+                boundv2f.emplace_back(v2, f);
             }
+            std::stable_sort(boundv2f.begin(), boundv2f.end(), [] (auto const &x, auto const &y) {
+                return x.first < y.first;
+            });
         }
 
-        std::map<int, std::vector<int>> v2f;
         outprim->verts.resize(prim->polys.size());
         for (int f = 0; f < prim->polys.size(); f++) {
             meth_average<vec3f> reducer;
             auto [start, len] = prim->polys[f];
             for (int l = start; l < start + len; l++) {
-                int v = prim->loops[l];
-                reducer.add(prim->verts[v]);
-                v2f[v].push_back(f);
+                reducer.add(prim->verts[prim->loops[l]]);
             }
             outprim->verts[f] = reducer.get();
         }
 
-        std::for_each(v2f.begin(), v2f.end(), [&] (auto const &v2fent) {
-            auto const &[vid, faceids] = v2fent;
+        auto each_vert = [&] (int vid, std::vector<int> const &faceids) {
             int loopbase = outprim->loops.size();
             std::map<int, std::vector<int>> lut;
             std::map<int, int> vid2f;
@@ -213,7 +204,22 @@ struct PrimDualMesh : INode {
             dfs(dfs, lut.begin()->first);
 
             outprim->polys.emplace_back(loopbase, outprim->loops.size() - loopbase);
-        });
+        };
+
+        std::vector<int> faceids;
+        auto boundit = boundv2f.begin();
+        for (int vid = 0; vid < topo->numVerts; vid++) {
+            faceids.clear();
+            for (int k = topo->vertStart[vid]; k < topo->vertStart[vid + 1]; k++) {
+                int h = topo->vertHalfedges[k];
+                if (isPolyHalfedge(h))
+                    faceids.push_back(topo->heFace[h] - polyBase);
+            }
+            for (; boundit != boundv2f.end() && boundit->first == vid; ++boundit)
+                faceids.push_back(boundit->second);
+            if (!faceids.empty())
+                each_vert(vid, faceids);
+        }
 
         set_output("prim", std::move(outprim));
     }
@@ -4,12 +4,14 @@
 #include <zeno/types/PrimitiveUtils.h>
 #include <zeno/types/StringObject.h>
 #include <zeno/types/CurveObject.h>
+#include <zeno/types/LinearBvh.h>
 #include <zeno/utils/arrayindex.h>
 #include <zeno/utils/variantswitch.h>
 #include <zeno/extra/TempNode.h>
 #include <zeno/core/INode.h>
 #include <zeno/zeno.h>
 #include <limits>
+#include <cmath>
 
 namespace zeno {
 namespace {
@@ -24,7 +26,7 @@ static float lineUDF(vec3f a, vec3f b, vec3f p) {
     else if (apoab > aboab)
         return length(p - b);
     auto apxab = length(cross(p - a, b - a));
-    return apxab / aboab;
+    return apxab / std::sqrt(aboab);
 }
 
 static vec3f lineGrad(vec3f a, vec3f b, vec3f p) {
@@ -42,6 +44,8 @@ static vec3f lineGrad(vec3f a, vec3f b, vec3f p) {
 }
 
 struct PrimForceTrail : INode {
+    LBvh bvh;  // kept between runs, refitted while the trail topology is unchanged
+
     virtual void apply() override {
         auto prim = get_input<PrimitiveObject>("prim");
         auto trailPrim = get_input<PrimitiveObject>("trailPrim");
@@ -70,24 +74,16 @@ struct PrimForceTrail : INode {
             };
         });
 
+        bvh.refitOrBuild(trailPrim, 0.f, {}, LBvh::element_c<LBvh::element_e::line>);
+
         std::visit([&] (auto const &attractUDFCurve, auto const &driftCoordCurve) {
             auto &forceArr = prim->verts.add_attr<zeno::vec3f>(forceAttr);
             parallel_for(prim->verts.size(), [&] (size_t i) {
                 auto pos = prim->verts[i];
 
-                int finind = -1;
+                LBvh::Ti finind = -1;
                 float finudf = std::numeric_limits<float>::max();
-                for (int k = 0; k < trailPrim->lines.size(); k++) {
-                    auto line = trailPrim->lines[k];
-                    float curudf = lineUDF(
-                            trailPrim->verts[line[0]],
-                            trailPrim->verts[line[1]],
-                            pos);
-                    if (curudf < finudf) {
-                        finudf = curudf;
-                        finind = k;
-                    }
-                }
+                bvh.find_nearest(pos, finind, finudf, LBvh::element_c<LBvh::element_e::line>);
 
                 vec3f force{};
                 if (finind != -1) {
@@ -3,10 +3,9 @@
 #include <zeno/types/PrimitiveUtils.h>
 #include <zeno/types/StringObject.h>
 #include <zeno/types/NumericObject.h>
-#include <zeno/utils/tuple_hash.h>
+#include <zeno/types/SpatialHashObject.h>
 #include <zeno/para/parallel_for.h>
 #include <zeno/utils/log.h>
-#include <unordered_map>
 
 namespace zeno {
 namespace {
@@ -17,27 +16,25 @@ struct PrimMarkClose : INode {
         auto tagAttr = get_input<StringObject>("tagAttr")->get();
         float distance = get_input<NumericObject>("distance")->get<float>();
 
-        float factor = 1.0f / distance;
-        std::unordered_multimap<vec3i, int, tuple_hash, tuple_equal> lut;
-        lut.reserve(prim->verts.size());
-        for (int i = 0; i < prim->verts.size(); i++) {
-            vec3f pos = prim->verts[i];
-            vec3i posi = vec3i(floor(pos * factor));
-            lut.emplace(posi, i);
+        // a linked spatialHash is only reused if it was built from these very
+        // positions with cellSize == distance, otherwise it is stale: rebuild
+        std::shared_ptr<SpatialHashObject> hash;
+        if (has_input("spatialHash")) {
+            hash = get_input<SpatialHashObject>("spatialHash");
+            if (!hash->builtFrom(prim->verts.data(), prim->verts.size(), distance)) {
+                zeno::log_warn("PrimMarkClose: spatialHash does not match prim or distance, rebuilding");
+                hash = nullptr;
+            }
+        }
+        if (!hash) {
+            hash = std::make_shared<SpatialHashObject>();
+            hash->build(prim->verts.data(), prim->verts.size(), distance);
         }
 
         auto &tag = prim->verts.add_attr<int>(tagAttr);
-        if (lut.size()) {
-            int cnt = 0;
-            auto last_key = lut.begin()->first;
-            for (auto const &[key, idx]: lut) {
-                if (!tuple_equal{}(last_key, key)) {
-                    ++cnt;
-                    last_key = key;
-                }
-                tag[idx] = cnt;
-            }
-            zeno::log_info("PrimMarkClose: collapse from {} to {}", prim->verts.size(), cnt + 1);
+        if (tag.size()) {
+            int cnt = hash->markCells(tag.data());
+            zeno::log_info("PrimMarkClose: collapse from {} to {}", prim->verts.size(), cnt);
         }
 
         set_output("prim", std::move(prim));
@@ -50,6 +47,7 @@ ZENDEFNODE(PrimMarkClose, {
     {"PrimitiveObject", "prim"},
     {"float", "distance", "0.00001"},
     {"string", "tagAttr", "weld"},
+    {"SpatialHashObject", "spatialHash"},
     },
     {
     {"PrimitiveObject", "prim"},
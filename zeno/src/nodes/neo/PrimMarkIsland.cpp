@@ -3,8 +3,7 @@
 #include <zeno/funcs/PrimitiveUtils.h>
 #include <zeno/types/StringObject.h>
 #include <zeno/types/NumericObject.h>
-#include <zeno/utils/tuple_hash.h>
-#include <unordered_map>
+#include <numeric>
 
 namespace zeno {
 
@@ -13,46 +12,27 @@ ZENO_API void primMarkIsland(PrimitiveObject *prim, std::string tagAttr) {
     auto &tagVert = prim->add_attr<int>(tagAttr);
     auto m = tagVert.size();
     std::vector<int> found(m);
-    for (int i = 0; i < m; i++) {
-        found[i] = i;
-    }
+    std::iota(found.begin(), found.end(), 0);
     auto find = [&] (int i) {
         while (i != found[i])
-            i = found[i];
+            i = found[i] = found[found[i]];
         return i;
     };
+    auto unite = [&] (int i, int j) {
+        i = find(i);
+        j = find(j);
+        if (i < j) found[j] = i;
+        else found[i] = j;
+    };
     for (int i = 0; i < prim->lines.size(); i++) {
         auto ind = prim->lines[i];
-        int e0 = find(ind[0]);
-        int e1 = find(ind[1]);
-        found[e1] = e0;
-    }
-    for (int i = 0; i < prim->tris.size(); i++) {
-        auto ind = prim->tris[i];
-        int e0 = find(ind[0]);
-        int e1 = find(ind[1]);
-        int e2 = find(ind[2]);
-        found[e1] = e0;
-        found[e2] = e0;
-    }
-    for (int i = 0; i < prim->quads.size(); i++) {
-        auto ind = prim->quads[i];
-        int e0 = find(ind[0]);
-        int e1 = find(ind[1]);
-        int e2 = find(ind[2]);
-        int e3 = find(ind[3]);
-        found[e1] = e0;
-        found[e2] = e0;
-        found[e3] = e0;
+        unite(ind[0], ind[1]);
     }
-    for (int i = 0; i < prim->polys.size(); i++) {
-        auto [base, len] = prim->polys[i];
-        if (len <= 1) continue;
-        int e0 = find(prim->loops[base]);
-        for (int j = base + 1; j < base + len; j++) {
-            int ej = find(prim->loops[j]);
-            found[ej] = e0;
-        }
+    // faces connect exactly the vertices joined by their edges, which the
+    // cached topology already lists once each
+    auto topo = primGetTopology(prim);
+    for (auto const &e: topo->edges) {
+        unite(e[0], e[1]);
     }
     for (int i = 0; i < m; i++) {
         tagVert[i] = find(i);
@@ -3,15 +3,14 @@
 #include <zeno/types/PrimitiveObject.h>
 #include <zeno/types/StringObject.h>
 #include <zeno/types/NumericObject.h>
+#include <zeno/types/SpatialHashObject.h>
 #include <zeno/para/parallel_for.h>
 #include <zeno/para/parallel_scan.h>
 #define ZENO_NOTICKTOCK
 #include <zeno/utils/ticktock.h>
 #include <zeno/utils/variantswitch.h>
 #include <zeno/utils/wangsrng.h>
-#include <zeno/utils/tuple_hash.h>
 #include <zeno/utils/log.h>
-#include <unordered_map>
 #include <random>
 #include <cmath>
 #ifndef M_PI
@@ -33,37 +32,18 @@ static void primPossionFilter(PrimitiveObject *prim, float minRadius) {
     if (minRadius <= 0) return;
 
     TICK(possion);
-    float invRadius = 1.f / minRadius;
-    std::unordered_map<vec3i, std::vector<int>, tuple_hash, tuple_equal> lut;
-    for (int i = 0; i < prim->verts.size(); i++) {
-        vec3i ipos(prim->verts[i] * invRadius);
-        lut[ipos].push_back(i);
-    }
+    SpatialHashObject hash;
+    hash.build(prim->verts.data(), prim->verts.size(), minRadius);
 
+    float minRadius2 = minRadius * minRadius;
     std::vector<uint8_t> erased(prim->verts.size());
     for (int i = 0; i < prim->verts.size(); i++) {
         if (erased[i])
             continue;
-        vec3i ipos(prim->verts[i] * invRadius);
-        erased[i] = [&] {
-            for (int dz = -1; dz <= 1; dz++) {
-                for (int dy = -1; dy <= 1; dy++) {
-                    for (int dx = -1; dx <= 1; dx++) {
-                        auto it = lut.find(ipos + vec3i(dx, dy, dz));
-                        if (it != lut.end()) {
-                            for (int j: it->second) {
-                                if (j == i || erased[j])
-                                    continue;
-                                auto dis = prim->verts[i] - prim->verts[j];
-                                if (length(dis) < minRadius)
-                                    return true;
-                            }
-                        }
-                    }
-                }
-            }
-            return false;
-        }();
+        hash.forEachNeighbor(prim->verts[i], minRadius, [&] (int j, vec3f const &, float dis2) {
+            if (j != i && !erased[j] && dis2 < minRadius2)
+                erased[i] = 1;
+        });
     }
 
     std::vector<int> revamp(prim->verts.size());
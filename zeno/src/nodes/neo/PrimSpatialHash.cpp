@@ -0,0 +1,136 @@
+#include <zeno/zeno.h>
+#include <zeno/types/PrimitiveObject.h>
+#include <zeno/types/SpatialHashObject.h>
+#include <zeno/types/NumericObject.h>
+#include <zeno/para/parallel_for.h>
+#include <zeno/para/parallel_scan.h>
+#include <zeno/utils/tuple_hash.h>
+#include <zeno/utils/parallel_reduce.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace zeno {
+
+static uint64_t hash_mix(uint64_t x) { // splitmix64 finalizer
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+ZENO_API uint64_t SpatialHashObject::positionsFingerprint(vec3f const *pos, std::size_t npos) {
+    auto hash = parallel_reduce_array<uint64_t>(npos * 3, 0, [&] (std::size_t i) {
+        uint32_t bits;
+        std::memcpy(&bits, &pos[i / 3][i % 3], sizeof(bits));
+        return hash_mix((uint64_t)i << 32 | bits);
+    }, [] (uint64_t x, uint64_t y) { return x + y; });
+    return hash_mix(hash ^ npos);
+}
+
+ZENO_API void SpatialHashObject::build(vec3f const *pos, std::size_t npos, float cellSize) {
+    this->cellSize = cellSize;
+    this->invCellSize = 1 / cellSize;
+    this->posFingerprint = positionsFingerprint(pos, npos);
+
+    uint32_t tableSize = 1;
+    while (tableSize < npos)
+        tableSize <<= 1;
+    tableMask = tableSize - 1;
+
+    std::vector<uint32_t> keys(npos);
+    std::vector<std::atomic<int>> cursor(tableSize); // already zero-initialized
+    parallel_for(npos, [&] (std::size_t i) {
+        auto b = bucketOf(cellOf(pos[i]));
+        keys[i] = b;
+        cursor[b].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    cellStart.resize(tableSize + 1);
+    cellStart[tableSize] = parallel_exclusive_scan_sum(cursor.begin(), cursor.end(), cellStart.begin(),
+                                                       [] (std::atomic<int> const &c) {
+                                                           return c.load(std::memory_order_relaxed);
+                                                       });
+    parallel_for(tableSize, [&] (uint32_t b) {
+        cursor[b].store(cellStart[b], std::memory_order_relaxed);
+    });
+
+    indices.resize(npos);
+    parallel_for(npos, [&] (std::size_t i) {
+        indices[cursor[keys[i]].fetch_add(1, std::memory_order_relaxed)] = (int)i;
+    });
+
+    // scatter order within a bucket is racy, sort it back to (cell, index) for determinism
+    parallel_for(tableSize, [&] (uint32_t b) {
+        std::sort(indices.begin() + cellStart[b], indices.begin() + cellStart[b + 1], [&] (int i, int j) {
+            auto ci = cellOf(pos[i]), cj = cellOf(pos[j]);
+            if (tuple_less{}(ci, cj)) return true;
+            if (tuple_less{}(cj, ci)) return false;
+            return i < j;
+        });
+    });
+
+    sortedPos.resize(npos);
+    parallel_for(npos, [&] (std::size_t k) {
+        sortedPos[k] = pos[indices[k]];
+    });
+}
+
+ZENO_API int SpatialHashObject::markCells(int *tags) const {
+    if (indices.empty()) return 0;
+    std::size_t nbuckets = cellStart.size() - 1;
+
+    auto walkRuns = [&] (std::size_t b, auto const &onRun, auto const &onPoint) {
+        vec3i last{};
+        for (int k = cellStart[b]; k < cellStart[b + 1]; k++) {
+            auto c = cellOf(sortedPos[k]);
+            if (k == cellStart[b] || !alltrue(c == last)) {
+                onRun();
+                last = c;
+            }
+            onPoint(k);
+        }
+    };
+
+    std::vector<int> runs(nbuckets);
+    parallel_for(nbuckets, [&] (std::size_t b) {
+        int n = 0;
+        walkRuns(b, [&] { ++n; }, [] (int) {});
+        runs[b] = n;
+    });
+    std::vector<int> base(nbuckets);
+    int total = parallel_exclusive_scan_sum(runs.begin(), runs.end(), base.begin());
+    parallel_for(nbuckets, [&] (std::size_t b) {
+        int id = base[b] - 1;
+        walkRuns(b, [&] { ++id; }, [&] (int k) { tags[indices[k]] = id; });
+    });
+    return total;
+}
+
+namespace {
+
+struct PrimSpatialHash : INode {
+    virtual void apply() override {
+        auto prim = get_input<PrimitiveObject>("prim");
+        auto cellSize = get_input2<float>("cellSize");
+        auto hash = std::make_shared<SpatialHashObject>();
+        hash->build(prim->verts.data(), prim->verts.size(), cellSize);
+        set_output("spatialHash", std::move(hash));
+    }
+};
+
+ZENDEFNODE(PrimSpatialHash, {
+    {
+    {"PrimitiveObject", "prim"},
+    {"float", "cellSize", "0.1"},
+    },
+    {
+    {"SpatialHashObject", "spatialHash"},
+    },
+    {
+    },
+    {"primitive"},
+});
+
+}
+}
@@ -0,0 +1,173 @@
+#include <zeno/zeno.h>
+#include <zeno/funcs/PrimitiveUtils.h>
+#include <zeno/types/PrimitiveObject.h>
+#include <zeno/types/PrimitiveTopology.h>
+#include <zeno/para/parallel_for.h>
+#include <zeno/para/parallel_scan.h>
+#include <zeno/para/parallel_sort.h>
+#include <zeno/utils/parallel_reduce.h>
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <memory>
+
+namespace zeno {
+
+static uint64_t topo_mix(uint64_t x) { // splitmix64 finalizer
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+template <class T>
+static uint64_t topo_hash_array(std::vector<T> const &arr, uint64_t salt) {
+    constexpr std::size_t n = sizeof(T) / sizeof(int);
+    auto const *p = reinterpret_cast<int const *>(arr.data());
+    auto hash = parallel_reduce_array<uint64_t>(arr.size() * n, 0, [&] (std::size_t i) {
+        return topo_mix(((uint64_t)i << 32 | (uint32_t)p[i]) ^ salt);
+    }, [] (uint64_t x, uint64_t y) { return x + y; });
+    return topo_mix(hash ^ topo_mix(arr.size() + salt));
+}
+
+static uint64_t primTopologyFingerprint(PrimitiveObject const *prim) {
+    uint64_t fp = topo_mix(prim->verts.size());
+    fp ^= topo_hash_array(prim->tris.values, 1);
+    fp ^= topo_hash_array(prim->quads.values, 2);
+    fp ^= topo_hash_array(prim->loops.values, 3);
+    fp ^= topo_hash_array(prim->polys.values, 4);
+    return fp;
+}
+
+static std::shared_ptr<PrimitiveTopology> primBuildTopology(PrimitiveObject const *prim) {
+    auto topo = std::make_shared<PrimitiveTopology>();
+    int nt = topo->numTris = prim->tris.size();
+    int nq = topo->numQuads = prim->quads.size();
+    int np = topo->numPolys = prim->polys.size();
+    int nv = topo->numVerts = prim->verts.size();
+    int nf = nt + nq + np;
+
+    auto faceLen = [&] (int f) {
+        return f < nt ? 3 : f < nt + nq ? 4 : prim->polys[f - nt - nq][1];
+    };
+    auto faceCorner = [&] (int f, int c) {
+        return f < nt ? prim->tris[f][c] : f < nt + nq ? prim->quads[f - nt][c]
+            : prim->loops[prim->polys[f - nt - nq][0] + c];
+    };
+
+    auto &faceStart = topo->faceStart;
+    faceStart.resize(nf + 1);
+    faceStart[nf] = parallel_exclusive_scan_sum(counter_iterator<int>(0), counter_iterator<int>(nf),
+                                                faceStart.begin(), faceLen);
+    int nh = faceStart[nf];
+
+    auto &heVert = topo->heVert;
+    auto &heFace = topo->heFace;
+    heVert.resize(nh);
+    heFace.resize(nh);
+    parallel_for(nf, [&] (int f) {
+        for (int h = faceStart[f], c = 0; h < faceStart[f + 1]; h++, c++) {
+            heVert[h] = faceCorner(f, c);
+            heFace[h] = f;
+        }
+    });
+
+    /// undirected edges: sort half-edges by (min, max) vertex key
+    std::vector<uint64_t> keys(nh);
+    parallel_for(nh, [&] (int h) {
+        uint32_t a = heVert[h], b = topo->dest(h);
+        keys[h] = a < b ? (uint64_t)a << 32 | b : (uint64_t)b << 32 | a;
+    });
+    auto &edgeHalfedges = topo->edgeHalfedges;
+    edgeHalfedges.resize(nh);
+    std::iota(edgeHalfedges.begin(), edgeHalfedges.end(), 0);
+    parallel_sort(edgeHalfedges.begin(), edgeHalfedges.end(), [&] (int h1, int h2) {
+        return keys[h1] != keys[h2] ? keys[h1] < keys[h2] : h1 < h2;
+    });
+
+    std::vector<int> runId(nh);
+    int ne = parallel_exclusive_scan_sum(counter_iterator<int>(0), counter_iterator<int>(nh),
+                                         runId.begin(), [&] (int k) {
+        return (int)(k == 0 || keys[edgeHalfedges[k]] != keys[edgeHalfedges[k - 1]]);
+    });
+    auto &edges = topo->edges;
+    auto &edgeStart = topo->edgeStart;
+    auto &heEdge = topo->heEdge;
+    edges.resize(ne);
+    edgeStart.resize(ne + 1);
+    edgeStart[ne] = nh;
+    heEdge.resize(nh);
+    parallel_for(nh, [&] (int k) {
+        int h = edgeHalfedges[k];
+        bool isHead = k == 0 || keys[h] != keys[edgeHalfedges[k - 1]];
+        int e = runId[k] - !isHead;
+        if (isHead) {
+            edgeStart[e] = k;
+            edges[e] = vec2i(keys[h] >> 32, keys[h] & 0xffffffffu);
+        }
+        heEdge[h] = e;
+    });
+
+    auto &heTwin = topo->heTwin;
+    heTwin.resize(nh);
+    parallel_for(ne, [&] (int e) {
+        for (int k = edgeStart[e]; k < edgeStart[e + 1]; k++) {
+            int h = edgeHalfedges[k];
+            int twin = -1;
+            for (int k2 = edgeStart[e]; k2 < edgeStart[e + 1]; k2++) {
+                int h2 = edgeHalfedges[k2];
+                if (h2 != h && heVert[h2] == topo->dest(h) && topo->dest(h2) == heVert[h]) {
+                    twin = h2;
+                    break;
+                }
+            }
+            heTwin[h] = twin;
+        }
+    });
+
+    /// outgoing half-edges of each vertex
+    auto &vertStart = topo->vertStart;
+    auto &vertHalfedges = topo->vertHalfedges;
+    std::vector<std::atomic<int>> cursor(nv); // already zero-initialized
+    parallel_for(nh, [&] (int h) {
+        cursor[heVert[h]].fetch_add(1, std::memory_order_relaxed);
+    });
+    vertStart.resize(nv + 1);
+    vertStart[nv] = parallel_exclusive_scan_sum(cursor.begin(), cursor.end(), vertStart.begin(),
+                                                [] (std::atomic<int> const &c) {
+                                                    return c.load(std::memory_order_relaxed);
+                                                });
+    parallel_for(nv, [&] (int v) {
+        cursor[v].store(vertStart[v], std::memory_order_relaxed);
+    });
+    vertHalfedges.resize(nh);
+    parallel_for(nh, [&] (int h) {
+        vertHalfedges[cursor[heVert[h]].fetch_add(1, std::memory_order_relaxed)] = h;
+    });
+    parallel_for(nv, [&] (int v) {
+        std::sort(vertHalfedges.begin() + vertStart[v], vertHalfedges.begin() + vertStart[v + 1]);
+    });
+
+    return topo;
+}
+
+ZENO_API std::shared_ptr<PrimitiveTopology const> primCachedTopology(PrimitiveObject const *prim) {
+    auto topo = std::atomic_load(&prim->topo);
+    if (topo && topo->fingerprint == primTopologyFingerprint(prim))
+        return topo;
+    return nullptr;
+}
+
+ZENO_API std::shared_ptr<PrimitiveTopology const> primGetTopology(PrimitiveObject const *prim) {
+    // prim->topo may be read and replaced by several nodes at once, e.g. from
+    // parallel ForEach workers sharing one input, so only touch it atomically
+    auto fp = primTopologyFingerprint(prim);
+    if (auto topo = std::atomic_load(&prim->topo); topo && topo->fingerprint == fp)
+        return topo;
+    auto topo = primBuildTopology(prim);
+    topo->fingerprint = fp;
+    std::atomic_store(&prim->topo, std::shared_ptr<PrimitiveTopology const>(topo));
+    return topo;
+}
+
+}
@@ -25,6 +25,10 @@ ZENO_API void primScale(PrimitiveObject *prim, vec3f const &scale) {
 namespace {
 
 struct PrimTranslate : INode {
+    PrimTranslate() {
+        bThreadSafe = true;
+    }
+
     virtual void apply() override {
         auto prim = get_input<PrimitiveObject>("prim");
         auto offset = get_input2<zeno::vec3f>("offset");
@@ -46,6 +50,10 @@ ZENDEFNODE(PrimTranslate, {
                           });
 
 struct PrimScale : INode {
+    PrimScale() {
+        bThreadSafe = true;
+    }
+
     virtual void apply() override {
         auto prim = get_input<PrimitiveObject>("prim");
         auto scale = get_input2<zeno::vec3f>("scale");
@@ -15,6 +15,9 @@ decltype(auto) remove_bool(T const &t) {
 }
 
 struct NumericOperator : zeno::INode {
+    NumericOperator() {
+        bThreadSafe = true;
+    }
 
     template <class T, class ...>
     using _left_t = T;
@@ -28,6 +28,11 @@ template <typename DstT, typename SrcT> constexpr auto reinterpret_bits(SrcT &&v
   }
 ZENO_API void primCalcNormal(zeno::PrimitiveObject* prim, float flip, std::string nrmAttr)
 {
+    // gather through the topology if one is already attached, but don't build
+    // one just for this: a prim created every frame would always miss
+    if (auto topo = primCachedTopology(prim))
+        return primCalcNormal(prim, *topo, flip, std::move(nrmAttr));
+
     auto &nrm = prim->add_attr<zeno::vec3f>(nrmAttr);
     auto &pos = prim->verts.values;
 
@@ -131,7 +136,46 @@ ZENO_API void primCalcNormal(zeno::PrimitiveObject* prim, float flip, std::strin
         nrm[i] = flip * normalizeSafe(nrm[i]);
     }
 }
+
+ZENO_API void primCalcNormal(zeno::PrimitiveObject* prim, PrimitiveTopology const &topology, float flip, std::string nrmAttr)
+{
+    auto &nrm = prim->add_attr<zeno::vec3f>(nrmAttr);
+    auto &pos = prim->verts.values;
+
+    // gather the corner normals around each vertex from the topology instead
+    // of scattering them with atomic adds, corners are visited in face order
+    // (tris, quads, polys) so the sums stay deterministic
+    auto const *topo = &topology;
+    auto const &heVert = topo->heVert;
+    auto const &faceStart = topo->faceStart;
+    int numTris = topo->numTris;
+
+#if defined(_OPENMP) && defined(__GNUG__)
+#pragma omp parallel for
+#endif
+    for (intptr_t v = 0; v < (intptr_t)nrm.size(); v++) {
+        auto n = zeno::vec3f(0);
+        for (int k = topo->vertStart[v]; k < topo->vertStart[v + 1]; k++) {
+            int h = topo->vertHalfedges[k];
+            int f = topo->heFace[h];
+            if (f < numTris) {
+                int h0 = faceStart[f];
+                auto p0 = pos[heVert[h0]];
+                n += cross(pos[heVert[h0 + 1]] - p0, pos[heVert[h0 + 2]] - p0);
+            } else {
+                int h1 = topo->next(h);
+                auto p0 = pos[heVert[h]];
+                n += cross(pos[heVert[h1]] - p0, pos[heVert[topo->next(h1)]] - p0);
+            }
+        }
+        nrm[v] = flip * normalizeSafe(n);
+    }
+}
 struct PrimitiveCalcNormal : zeno::INode {
+    PrimitiveCalcNormal() {
+        bThreadSafe = true;
+    }
+
     virtual void apply() override {
         auto prim = get_input<PrimitiveObject>("prim");
         auto nrmAttr = get_input<StringObject>("nrmAttr")->get();
@@ -200,6 +200,10 @@ ZENDEFNODE(TransformPrimitive, {
 // euler rot order: roll-pitch-yaw
 // euler rot unit use degrees
 struct PrimitiveTransform : zeno::INode {
+    PrimitiveTransform() {
+        bThreadSafe = true;
+    }
+
     static glm::vec3 mapplypos(glm::mat4 const &matrix, glm::vec3 const &vector) {
         auto vector4 = matrix * glm::vec4(vector, 1.0f);
         return glm::vec3(vector4) / vector4.w;
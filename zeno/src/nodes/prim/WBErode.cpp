@@ -123,29 +123,54 @@ ZENDEFNODE(erode_value2cond,
                    "erode",
                }});
 
+// color order of the 8 red/black sub-iterations of one erosion iteration
+static void erode_rand_color_perm(int iterations, int iter, int perm[8]) {
+    std::uniform_real_distribution<float> distr(0.0, 1.0);
+    for (int i = 0; i < 8; i++)
+        perm[i] = i + 1;
+    for (int i = 0; i < 8; i++)
+    {
+        vec2f vec;
+        std::mt19937 mt(iterations * iter * 8 * i + i);
+        vec[0] = distr(mt);
+        vec[1] = distr(mt);
+
+        int idx1 = floor(vec[0] * 8);
+        int idx2 = floor(vec[1] * 8);
+        idx1 = idx1 == 8 ? 7 : idx1;
+        idx2 = idx2 == 8 ? 7 : idx2;
+
+        int temp = perm[idx1];
+        perm[idx1] = perm[idx2];
+        perm[idx2] = temp;
+    }
+}
+
+// random (+-1, +-1) direction of the axial or diagonal sub-iterations
+static void erode_rand_dirs(int iterations, int iter, int dirs[2]) {
+    std::uniform_real_distribution<float> distr(0.0, 1.0);
+    for (int i = 0; i < 2; i++)
+    {
+        std::mt19937 mt(iterations * iter * 2 * i + i);
+        float rand_val = distr(mt);
+        if (rand_val > 0.5)
+        {
+            dirs[i] = 1;
+        }
+        else
+        {
+            dirs[i] = -1;
+        }
+    }
+}
+
 struct erode_rand_color : INode {
     void apply() override {
-        std::uniform_real_distribution<float> distr(0.0, 1.0);
         auto iterations = get_input<NumericObject>("iterations")->get<int>();
         auto iter       = get_input<NumericObject>("iter")->get<int>();
 
-        int perm[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
-        for (int i = 0; i < 8; i++)
-        {
-            vec2f vec;
-            std::mt19937 mt(iterations * iter * 8 * i + i);
-            vec[0] = distr(mt);
-            vec[1] = distr(mt);
-
-            int idx1 = floor(vec[0] * 8);
-            int idx2 = floor(vec[1] * 8);
-            idx1 = idx1 == 8 ? 7 : idx1;
-            idx2 = idx2 == 8 ? 7 : idx2;
-
-            int temp = perm[idx1];
-            perm[idx1] = perm[idx2];
-            perm[idx2] = temp;
-        }
+        int perm[8];
+        erode_rand_color_perm(iterations, iter, perm);
 
         auto list = std::make_shared<zeno::ListObject>();
         for (int i = 0; i < 8; i++)
@@ -178,24 +203,11 @@ ZENDEFNODE(erode_rand_color,
 struct erode_rand_dir : INode {
     void apply() override {
 
-        std::uniform_real_distribution<float> distr(0.0, 1.0);
         auto iterations = get_input<NumericObject>("iterations")->get<int>();
         auto iter       = get_input<NumericObject>("iter")->get<int>();
 
-        int dirs[] = { -1, -1 };
-        for (int i = 0; i < 2; i++)
-        {
-            std::mt19937 mt(iterations * iter * 2 * i + i);
-            float rand_val = distr(mt);
-            if (rand_val > 0.5)
-            {
-                dirs[i] = 1;
-            }
-            else
-            {
-                dirs[i] = -1;
-            }
-        }
+        int dirs[2];
+        erode_rand_dirs(iterations, iter, dirs);
 
         auto list = std::make_shared<zeno::ListObject>();
         for (int i = 0; i < 2; i++)
@@ -1056,6 +1068,261 @@ ZENDEFNODE(erode_tumble_material_v1,
                    "erode",
                }});
 
+// granular slump, shared by erode_tumble_material_v2/v3 and erode_granular_slump
+struct erode_slump_params {
+    int nx, nz;
+    float cellSize;
+    float seed;
+    int openborder;
+    float gridbias;
+    float repose_angle;
+    float quant_amt;
+    float flow_rate;
+};
+
+// one sub-iteration of an active cell: moves material between the cell and its (dx, dz)
+// neighbour, reading levels from temp_material and writing both cells in material
+template <bool CalcFlow>
+static void erode_slump_cell(erode_slump_params const &p, int id_x, int id_z, int color, int dx, int dz, int iterseed,
+                            float const *height, float const *temp_material, float *material,
+                            float const *stabilitymask, vec3f *flowdir) {
+    int nx = p.nx;
+    int nz = p.nz;
+    int openborder = p.openborder;
+    float quant_amt = p.quant_amt;
+
+    int idx = Pos2Idx(id_x, id_z, nx);
+    int bound_x = nx;
+    int bound_z = nz;
+    int clamp_x = bound_x - 1;
+    int clamp_z = bound_z - 1;
+
+    float flow_rate = clamp(p.flow_rate, 0.0f, 1.0f);
+
+    float diff_x = 0.0f;
+    float diff_z = 0.0f;
+
+    float i_material = temp_material[idx];
+    float i_height = height[idx];
+
+    int samplex = clamp(id_x + dx, 0, clamp_x);
+    int samplez = clamp(id_z + dz, 0, clamp_z);
+    int validsource = (samplex == id_x + dx) && (samplez == id_z + dz);
+    if (!validsource)
+        return;
+
+    int j_idx = Pos2Idx(samplex, samplez, nx);
+
+    float j_material = temp_material[j_idx];
+    float j_height = height[j_idx];
+
+    float _repose_angle = p.repose_angle;
+    _repose_angle = clamp(_repose_angle, 0.0f, 90.0f);
+    float delta_x = p.cellSize * (dx && dz ? 1.4142136f : 1.0f);
+    float static_diff = _repose_angle < 90.0f ? tan(_repose_angle * M_PI / 180.0) * delta_x : 1e10f;
+    float m_diff = (j_height + j_material) - (i_height + i_material);
+    int cidx = 0;
+    int cidz = 0;
+
+    float c_height = 0.0f;
+    float c_material = 0.0f;
+    float n_material = 0.0f;
+
+    int c_idx = 0;
+    int n_idx = 0;
+
+    int dx_check = 0;
+    int dz_check = 0;
+
+    if (m_diff > 0.0f)
+    {
+        cidx = samplex;
+        cidz = samplez;
+
+        c_height = j_height;
+        c_material = j_material;
+        n_material = i_material;
+
+        c_idx = j_idx;
+        n_idx = idx;
+
+        dx_check = -dx;
+        dz_check = -dz;
+    }
+    else
+    {
+        cidx = id_x;
+        cidz = id_z;
+
+        c_height = i_height;
+        c_material = i_material;
+        n_material = j_material;
+
+        c_idx = idx;
+        n_idx = j_idx;
+
+        dx_check = dx;
+        dz_check = dz;
+    }
+
+    float sum_diffs[] = { 0.0f, 0.0f };
+    float dir_probs[] = { 0.0f, 0.0f };
+    float dir_prob = 0.0f;
+    for (int diff_idx = 0; diff_idx < 2; diff_idx++)
+    {
+        for (int tmp_dz = -1; tmp_dz <= 1; tmp_dz++)
+        {
+            for (int tmp_dx = -1; tmp_dx <= 1; tmp_dx++)
+            {
+                if (!tmp_dx && !tmp_dz)
+                    continue;
+
+                int tmp_samplex = clamp(cidx + tmp_dx, 0, clamp_x);
+                int tmp_samplez = clamp(cidz + tmp_dz, 0, clamp_z);
+                int tmp_validsource = (tmp_samplex == (cidx + tmp_dx)) && (tmp_samplez == (cidz + tmp_dz));
+                tmp_validsource = tmp_validsource || !openborder;
+                int tmp_j_idx = Pos2Idx(tmp_samplex, tmp_samplez, nx);
+
+                float n_material = tmp_validsource ? temp_material[tmp_j_idx] : 0.0f;
+                float n_height = height[tmp_j_idx];
+                float tmp_h_diff = n_height - (c_height);
+                float tmp_m_diff = (n_height + n_material) - (c_height + c_material);
+                float tmp_diff = diff_idx == 0 ? tmp_h_diff : tmp_m_diff;
+                float _gridbias = p.gridbias;
+                _gridbias = clamp(_gridbias, -1.0f, 1.0f);
+
+                if (tmp_dx && tmp_dz)
+                    tmp_diff *= clamp(1.0f - _gridbias, 0.0f, 1.0f) / 1.4142136f;
+                else
+                    tmp_diff *= clamp(1.0f + _gridbias, 0.0f, 1.0f);
+
+                if (tmp_diff <= 0.0f)
+                {
+                    if ((dx_check == tmp_dx) && (dz_check == tmp_dz))
+                        dir_probs[diff_idx] = tmp_diff;
+
+                    if (diff_idx && dir_prob > tmp_diff)
+                        dir_prob = tmp_diff;
+
+                    sum_diffs[diff_idx] += tmp_diff;
+                }
+            }
+        }
+
+        if (diff_idx && (dir_prob > 0.001f || dir_prob < -0.001f))
+            dir_prob = dir_probs[diff_idx] / dir_prob;
+
+        if (sum_diffs[diff_idx] > 0.001f || sum_diffs[diff_idx] < -0.001f)
+            dir_probs[diff_idx] = dir_probs[diff_idx] / sum_diffs[diff_idx];
+    }
+
+    float movable_mat = (m_diff < 0.0f) ? -m_diff : m_diff;
+    float stability_val = 0.0f;
+    stability_val = clamp(stabilitymask[c_idx], 0.0f, 1.0f);
+
+    if (stability_val > 0.01f)
+        movable_mat = clamp(movable_mat * (1.0f - stability_val) * 0.5f, 0.0f, c_material);
+    else
+        movable_mat = clamp((movable_mat - static_diff) * 0.5f, 0.0f, c_material);
+
+    float l_rat = dir_probs[1];
+    if (quant_amt > 0.001)
+        movable_mat = clamp(quant_amt * ceil((movable_mat * l_rat) / quant_amt), 0.0f, c_material);
+    else
+        movable_mat *= l_rat;
+
+    float diff = (m_diff > 0.0f) ? movable_mat : -movable_mat;
+
+    int cond = 0;
+    if (dir_prob >= 1.0f)
+        cond = 1;
+    else
+    {
+        dir_prob = dir_prob * dir_prob * dir_prob * dir_prob;
+        unsigned int cutoff = (unsigned int)(dir_prob * 4294967295.0);
+        unsigned int randval = erode_random(p.seed, (idx + nx * nz) * 8 + color + iterseed);
+        cond = randval < cutoff;
+    }
+
+    if (!cond)
+        diff = 0.0f;
+
+    diff *= flow_rate;
+
+    if constexpr (CalcFlow) {
+        diff_x += (float)dx * diff;
+        diff_z += (float)dz * diff;
+        diff_x *= -1.0f;
+        diff_z *= -1.0f;
+    }
+
+    float abs_diff = (diff < 0.0f) ? -diff : diff;
+    material[c_idx] = c_material - abs_diff;
+    material[n_idx] = n_material + abs_diff;
+
+    if constexpr (CalcFlow) {
+        float abs_c_x = flowdir[c_idx][0];
+        abs_c_x = (abs_c_x < 0.0f) ? -abs_c_x : abs_c_x;
+        float abs_c_z = flowdir[c_idx][2];
+        abs_c_z = (abs_c_z < 0.0f) ? -abs_c_z : abs_c_z;
+        flowdir[c_idx][0] += diff_x * 1.0f / (1.0f + abs_c_x);
+        flowdir[c_idx][2] += diff_z * 1.0f / (1.0f + abs_c_z);
+    }
+}
+
+// visit the active cells of a color, a row of every other cell or every other row
+template <class Func>
+static void erode_for_color(int nx, int nz, int color, Func const &func) {
+    bool by_row = color == 1 || color == 3;
+    int z0 = color == 1 ? 1 : 0;
+    int zs = by_row ? 2 : 1;
+    int x0 = !by_row && (color == 2 || color == 5 || color == 6) ? 1 : 0;
+    int xs = by_row ? 1 : 2;
+
+#pragma omp parallel for
+    for (int id_z = z0; id_z < nz; id_z += zs)
+    {
+        for (int id_x = x0; id_x < nx; id_x += xs)
+        {
+            func(id_x, id_z);
+        }
+    }
+}
+
+// one red/black sub-iteration over the whole grid, the active cells of a color
+// touch disjoint cell pairs so they can be processed in any order; if mirror is
+// given, the written cells are copied back to it, keeping it equal to material
+template <bool CalcFlow>
+static void erode_slump_step(erode_slump_params const &p, int iter, int color, int const p_dirs[2], int const x_dirs[2],
+                             float const *height, float const *temp_material, float *material,
+                             float const *stabilitymask, vec3f *flowdir, float *mirror = nullptr) {
+    if (color < 1 || color > 8)
+        return;
+    int iterseed = iter * 134775813;
+    int dxs[] = { 0, p_dirs[0], 0, p_dirs[0], x_dirs[0], x_dirs[1], x_dirs[0], x_dirs[1] };
+    int dzs[] = { p_dirs[1], 0, p_dirs[1], 0, x_dirs[0],-x_dirs[1], x_dirs[0],-x_dirs[1] };
+    int dx = dxs[color - 1];
+    int dz = dzs[color - 1];
+
+    erode_for_color(p.nx, p.nz, color, [&] (int id_x, int id_z) {
+        erode_slump_cell<CalcFlow>(p, id_x, id_z, color, dx, dz, iterseed,
+                                   height, temp_material, material, stabilitymask, flowdir);
+    });
+
+    if (mirror) {
+        erode_for_color(p.nx, p.nz, color, [&] (int id_x, int id_z) {
+            int samplex = id_x + dx;
+            int samplez = id_z + dz;
+            if (samplex < 0 || samplex >= p.nx || samplez < 0 || samplez >= p.nz)
+                return;
+            int idx = Pos2Idx(id_x, id_z, p.nx);
+            int j_idx = Pos2Idx(samplex, samplez, p.nx);
+            mirror[idx] = material[idx];
+            mirror[j_idx] = material[j_idx];
+        });
+    }
+}
+
 // granular slump                                   用于子图：Erode_Slump_Debris             granular
 struct erode_tumble_material_v2 : INode {
     void apply() override {
@@ -1120,192 +1387,11 @@ struct erode_tumble_material_v2 : INode {
         // 计算
         ////////////////////////////////////////////////////////////////////////////////////////
 
-#pragma omp parallel for
-        for (int id_z = 0; id_z < nz; id_z++)
-        {
-            for (int id_x = 0; id_x < nx; id_x++)
-            {
-                int iterseed = iter * 134775813;
-                int color = perm[i];
-
-                int is_red = ((id_z & 1) == 1) && (color == 1);
-                int is_green = ((id_x & 1) == 1) && (color == 2);
-                int is_blue = ((id_z & 1) == 0) && (color == 3);
-                int is_yellow = ((id_x & 1) == 0) && (color == 4);
-                int is_x_turn_x = ((id_x & 1) == 1) && ((color == 5) || (color == 6));
-                int is_x_turn_y = ((id_x & 1) == 0) && ((color == 7) || (color == 8));
-                int dxs[] = { 0, p_dirs[0], 0, p_dirs[0], x_dirs[0], x_dirs[1], x_dirs[0], x_dirs[1] };
-                int dzs[] = { p_dirs[1], 0, p_dirs[1], 0, x_dirs[0],-x_dirs[1], x_dirs[0],-x_dirs[1] };
-
-                if (is_red || is_green || is_blue || is_yellow || is_x_turn_x || is_x_turn_y)
-                {
-                    int idx = Pos2Idx(id_x, id_z, nx);
-                    int dx = dxs[color - 1];
-                    int dz = dzs[color - 1];
-                    int bound_x = nx;
-                    int bound_z = nz;
-                    int clamp_x = bound_x - 1;
-                    int clamp_z = bound_z - 1;
-
-                    flow_rate = clamp(flow_rate, 0.0f, 1.0f);
-
-                    float i_material = _temp_material[idx];
-                    float i_height = _height[idx];
-
-                    int samplex = clamp(id_x + dx, 0, clamp_x);
-                    int samplez = clamp(id_z + dz, 0, clamp_z);
-                    int validsource = (samplex == id_x + dx) && (samplez == id_z + dz);
-
-                    if (validsource)
-                    {
-                        int same_node = !validsource;
-
-                        validsource = validsource || !openborder;
-
-                        int j_idx = Pos2Idx(samplex, samplez, nx);
-
-                        float j_material = validsource ? _temp_material[j_idx] : 0.0f;
-                        float j_height = _height[j_idx];
-
-                        float _repose_angle = repose_angle;
-                        _repose_angle = clamp(_repose_angle, 0.0f, 90.0f);
-                        float delta_x = cellSize * (dx && dz ? 1.4142136f : 1.0f);
-                        float static_diff = _repose_angle < 90.0f ? tan(_repose_angle * M_PI / 180.0) * delta_x : 1e10f;
-                        float m_diff = (j_height + j_material) - (i_height + i_material);
-                        int cidx = 0;
-                        int cidz = 0;
-
-                        float c_height = 0.0f;
-                        float c_material = 0.0f;
-                        float n_material = 0.0f;
-
-                        int c_idx = 0;
-                        int n_idx = 0;
-
-                        int dx_check = 0;
-                        int dz_check = 0;
-
-                        if (m_diff > 0.0f)
-                        {
-                            cidx = samplex;
-                            cidz = samplez;
-
-                            c_height = j_height;
-                            c_material = j_material;
-                            n_material = i_material;
-
-                            c_idx = j_idx;
-                            n_idx = idx;
-
-                            dx_check = -dx;
-                            dz_check = -dz;
-                        }
-                        else
-                        {
-                            cidx = id_x;
-                            cidz = id_z;
-
-                            c_height = i_height;
-                            c_material = i_material;
-                            n_material = j_material;
-
-                            c_idx = idx;
-                            n_idx = j_idx;
-
-                            dx_check = dx;
-                            dz_check = dz;
-                        }
-
-                        float sum_diffs[] = { 0.0f, 0.0f };
-                        float dir_probs[] = { 0.0f, 0.0f };
-                        float dir_prob = 0.0f;
-                        for (int diff_idx = 0; diff_idx < 2; diff_idx++)
-                        {
-                            for (int tmp_dz = -1; tmp_dz <= 1; tmp_dz++)
-                            {
-                                for (int tmp_dx = -1; tmp_dx <= 1; tmp_dx++)
-                                {
-                                    if (!tmp_dx && !tmp_dz)
-                                        continue;
-
-                                    int tmp_samplex = clamp(cidx + tmp_dx, 0, clamp_x);
-                                    int tmp_samplez = clamp(cidz + tmp_dz, 0, clamp_z);
-                                    int tmp_validsource = (tmp_samplex == (cidx + tmp_dx)) && (tmp_samplez == (cidz + tmp_dz));
-                                    tmp_validsource = tmp_validsource || !openborder;
-                                    int tmp_j_idx = Pos2Idx(tmp_samplex, tmp_samplez, nx);
-
-                                    float n_material = tmp_validsource ? _temp_material[tmp_j_idx] : 0.0f;
-                                    float n_height = _height[tmp_j_idx];
-                                    float tmp_h_diff = n_height - (c_height);
-                                    float tmp_m_diff = (n_height + n_material) - (c_height + c_material);
-                                    float tmp_diff = diff_idx == 0 ? tmp_h_diff : tmp_m_diff;
-                                    float _gridbias = gridbias;
-                                    _gridbias = clamp(_gridbias, -1.0f, 1.0f);
-
-                                    if (tmp_dx && tmp_dz)
-                                        tmp_diff *= clamp(1.0f - _gridbias, 0.0f, 1.0f) / 1.4142136f;
-                                    else
-                                        tmp_diff *= clamp(1.0f + _gridbias, 0.0f, 1.0f);
-
-                                    if (tmp_diff <= 0.0f)
-                                    {
-                                        if ((dx_check == tmp_dx) && (dz_check == tmp_dz))
-                                            dir_probs[diff_idx] = tmp_diff;
-
-                                        if (diff_idx && dir_prob > tmp_diff)
-                                            dir_prob = tmp_diff;
-
-                                        sum_diffs[diff_idx] += tmp_diff;
-                                    }
-                                }
-                            }
-
-                            if (diff_idx && (dir_prob > 0.001f || dir_prob < -0.001f))
-                                dir_prob = dir_probs[diff_idx] / dir_prob;
-
-                            if (sum_diffs[diff_idx] > 0.001f || sum_diffs[diff_idx] < -0.001f)
-                                dir_probs[diff_idx] = dir_probs[diff_idx] / sum_diffs[diff_idx];
-                        }
-
-                        float movable_mat = (m_diff < 0.0f) ? -m_diff : m_diff;
-                        float stability_val = 0.0f;
-                        stability_val = clamp(stabilitymask[c_idx], 0.0f, 1.0f);
-
-                        if (stability_val > 0.01f)
-                            movable_mat = clamp(movable_mat * (1.0f - stability_val) * 0.5f, 0.0f, c_material);
-                        else
-                            movable_mat = clamp((movable_mat - static_diff) * 0.5f, 0.0f, c_material);
-
-                        float l_rat = dir_probs[1];
-                        if (quant_amt > 0.001)
-                            movable_mat = clamp(quant_amt * ceil((movable_mat * l_rat) / quant_amt), 0.0f, c_material);
-                        else
-                            movable_mat *= l_rat;
-
-                        float diff = (m_diff > 0.0f) ? movable_mat : -movable_mat;
-
-                        int cond = 0;
-                        if (dir_prob >= 1.0f)
-                            cond = 1;
-                        else
-                        {
-                            dir_prob = dir_prob * dir_prob * dir_prob * dir_prob;
-                            unsigned int cutoff = (unsigned int)(dir_prob * 4294967295.0);
-                            unsigned int randval = erode_random(seed, (idx + nx * nz) * 8 + color + iterseed);
-                            cond = randval < cutoff;
-                        }
-
-                        if (!cond || same_node)
-                            diff = 0.0f;
-
-                        diff *= flow_rate;
-                        float abs_diff = (diff < 0.0f) ? -diff : diff;
-                        _material[c_idx] = c_material - abs_diff;
-                        _material[n_idx] = n_material + abs_diff;
-                    }
-                }
-            }
-        }
+        erode_slump_params params{nx, nz, cellSize, seed, openborder, gridbias, repose_angle, quant_amt, flow_rate};
+        int p_dir[] = { p_dirs[0], p_dirs[1] };
+        int x_dir[] = { x_dirs[0], x_dirs[1] };
+        erode_slump_step<false>(params, iter, perm[i], p_dir, x_dir, _height.data(), _temp_material.data(),
+                                _material.data(), stabilitymask.data(), nullptr);
 
         set_output("HeightField", std::move(terrain));
     }
@@ -1414,232 +1500,142 @@ struct erode_tumble_material_v3 : INode {
         // 计算
         ////////////////////////////////////////////////////////////////////////////////////////
 
-#pragma omp parallel for
-        for (int id_z = 0; id_z < nz; id_z++)
-        {
-            for (int id_x = 0; id_x < nx; id_x++)
-            {
-                int iterseed = iter * 134775813;
-                int color = perm[i];
-
-                int is_red = ((id_z & 1) == 1) && (color == 1);
-                int is_green = ((id_x & 1) == 1) && (color == 2);
-                int is_blue = ((id_z & 1) == 0) && (color == 3);
-                int is_yellow = ((id_x & 1) == 0) && (color == 4);
-                int is_x_turn_x = ((id_x & 1) == 1) && ((color == 5) || (color == 6));
-                int is_x_turn_y = ((id_x & 1) == 0) && ((color == 7) || (color == 8));
-                int dxs[] = {0, p_dirs[0], 0, p_dirs[0], x_dirs[0], x_dirs[1], x_dirs[0], x_dirs[1]};
-                int dzs[] = {p_dirs[1], 0, p_dirs[1], 0, x_dirs[0], -x_dirs[1], x_dirs[0], -x_dirs[1]};
-
-                if (is_red || is_green || is_blue || is_yellow || is_x_turn_x || is_x_turn_y) {
-                    int idx = Pos2Idx(id_x, id_z, nx);
-                    int dx = dxs[color - 1];
-                    int dz = dzs[color - 1];
-                    int bound_x = nx;
-                    int bound_z = nz;
-                    int clamp_x = bound_x - 1;
-                    int clamp_z = bound_z - 1;
-
-                    flow_rate = clamp(flow_rate, 0.0f, 1.0f);
-
-                    // CALC_FLOW
-                    float diff_x = 0.0f;
-                    float diff_z = 0.0f;
-
-                    float i_material = _temp_material[idx];
-                    float i_height = height[idx];
-
-                    int samplex = clamp(id_x + dx, 0, clamp_x);
-                    int samplez = clamp(id_z + dz, 0, clamp_z);
-                    int validsource = (samplex == id_x + dx) && (samplez == id_z + dz);
-
-                    if (validsource)
-                    {
-                        int same_node = !validsource;
-
-                        validsource = validsource || !openborder;
-
-                        int j_idx = Pos2Idx(samplex, samplez, nx);
-
-                        float j_material = validsource ? _temp_material[j_idx] : 0.0f;
-                        float j_height = height[j_idx];
-
-                        float _repose_angle = repose_angle;
-                        _repose_angle = clamp(_repose_angle, 0.0f, 90.0f);
-                        float delta_x = cellSize * (dx && dz ? 1.4142136f : 1.0f);
-
-                        float static_diff = _repose_angle < 90.0f ? tan(_repose_angle * M_PI / 180.0) * delta_x : 1e10f;
-
-                        float m_diff = (j_height + j_material) - (i_height + i_material);
-
-                        int cidx = 0;
-                        int cidz = 0;
-
-                        float c_height = 0.0f;
-                        float c_material = 0.0f;
-                        float n_material = 0.0f;
-
-                        int c_idx = 0;
-                        int n_idx = 0;
-
-                        int dx_check = 0;
-                        int dz_check = 0;
-
-                        if (m_diff > 0.0f) {
-                            cidx = samplex;
-                            cidz = samplez;
-
-                            c_height = j_height;
-                            c_material = j_material;
-                            n_material = i_material;
-
-                            c_idx = j_idx;
-                            n_idx = idx;
-
-                            dx_check = -dx;
-                            dz_check = -dz;
-                        } else {
-                            cidx = id_x;
-                            cidz = id_z;
-
-                            c_height = i_height;
-                            c_material = i_material;
-                            n_material = j_material;
-
-                            c_idx = idx;
-                            n_idx = j_idx;
-
-                            dx_check = dx;
-                            dz_check = dz;
-                        }
-
-                        float sum_diffs[] = {0.0f, 0.0f};
-                        float dir_probs[] = {0.0f, 0.0f};
-                        float dir_prob = 0.0f;
-                        for (int diff_idx = 0; diff_idx < 2; diff_idx++) {
-                            for (int tmp_dz = -1; tmp_dz <= 1; tmp_dz++) {
-                                for (int tmp_dx = -1; tmp_dx <= 1; tmp_dx++) {
-                                    if (!tmp_dx && !tmp_dz)
-                                        continue;
-
-                                    int tmp_samplex = clamp(cidx + tmp_dx, 0, clamp_x);
-                                    int tmp_samplez = clamp(cidz + tmp_dz, 0, clamp_z);
-                                    int tmp_validsource = (tmp_samplex == (cidx + tmp_dx)) && (tmp_samplez == (cidz + tmp_dz));
-
-                                    tmp_validsource = tmp_validsource || !openborder;
-                                    int tmp_j_idx = Pos2Idx(tmp_samplex, tmp_samplez, nx);
-
-                                    float n_material = tmp_validsource ? _temp_material[tmp_j_idx] : 0.0f;
-                                    float n_height = height[tmp_j_idx];
-                                    float tmp_h_diff = n_height - (c_height);
-                                    float tmp_m_diff = (n_height + n_material) - (c_height + c_material);
-                                    float tmp_diff = diff_idx == 0 ? tmp_h_diff : tmp_m_diff;
-                                    float _gridbias = gridbias;
-
-                                    _gridbias = clamp(_gridbias, -1.0f, 1.0f);
-
-                                    if (tmp_dx && tmp_dz)
-                                        tmp_diff *= clamp(1.0f - _gridbias, 0.0f, 1.0f) / 1.4142136f;
-                                    else
-                                        tmp_diff *= clamp(1.0f + _gridbias, 0.0f, 1.0f);
-
-                                    if (tmp_diff <= 0.0f)
-                                    {
-                                        if ((dx_check == tmp_dx) && (dz_check == tmp_dz))
-                                            dir_probs[diff_idx] = tmp_diff;
-
-                                        if (diff_idx && dir_prob > tmp_diff)
-                                            dir_prob = tmp_diff;
-
-                                        sum_diffs[diff_idx] += tmp_diff;
-                                    }
-                                }
-                            }
+        erode_slump_params params{nx, nz, cellSize, seed, openborder, gridbias, repose_angle, quant_amt, flow_rate};
+        int p_dir[] = { p_dirs[0], p_dirs[1] };
+        int x_dir[] = { x_dirs[0], x_dirs[1] };
+        erode_slump_step<true>(params, iter, perm[i], p_dir, x_dir, height.data(), _temp_material.data(),
+                               _material.data(), stabilitymask.data(), flowdir.data());
 
-                            if (diff_idx && (dir_prob > 0.001f || dir_prob < -0.001f))
-                                dir_prob = dir_probs[diff_idx] / dir_prob;
+        set_output("prim_2DGrid", std::move(terrain));
+    }
+};
+ZENDEFNODE(erode_tumble_material_v3,
+           {/* inputs: */ {
+                   "prim_2DGrid",
 
-                            if (sum_diffs[diff_idx] > 0.001f || sum_diffs[diff_idx] < -0.001f)
-                                dir_probs[diff_idx] = dir_probs[diff_idx] / sum_diffs[diff_idx];
-                        }
+                   {"string", "stabilitymask", "_stability"},
+                   {"ListObject", "perm"},
+                   {"ListObject", "p_dirs"},
+                   {"ListObject", "x_dirs"},
 
-                        float movable_mat = (m_diff < 0.0f) ? -m_diff : m_diff;
-                        float stability_val = 0.0f;
-                        stability_val = clamp(stabilitymask[c_idx], 0.0f, 1.0f);
+                   {"float", "seed", "15231.3"},
+                   {"int", "iterations", "0"},
+                   {"int", "iter", "0"},
+                   {"int", "i", "0"},
 
-                        if (stability_val > 0.01f)
-                            movable_mat = clamp(movable_mat * (1.0f - stability_val) * 0.5f, 0.0f, c_material);
-                        else
-                            movable_mat = clamp((movable_mat - static_diff) * 0.5f, 0.0f, c_material);
+                   {"int", "openborder", "0"},
+                   {"float", "gridbias", "0.0"},
 
-                        float l_rat = dir_probs[1];
-                        if (quant_amt > 0.001)
-                            movable_mat = clamp(quant_amt * ceil((movable_mat * l_rat) / quant_amt), 0.0f, c_material);
-                        else
-                            movable_mat *= l_rat;
+                   // 崩塌流淌相关
+                   {"float", "repose_angle", "0.0"},
+                   {"float", "quant_amt", "0.0"},
+                   {"float", "flow_rate", "1.0"},
+               },
+               /* outputs: */
+               {
+                   "prim_2DGrid",
+               },
+               /* params: */
+               {
+                   //{"string", "stabilitymask", "_stability"},
+               },
+               /* category: */
+               {
+                   "erode",
+               }});
 
-                        float diff = (m_diff > 0.0f) ? movable_mat : -movable_mat;
+// granular slump (+ flow) running the whole iteration schedule of the Erode_Slump_Debris /
+// Erode_Granular_Slump_Flow subgraphs in one node, with the same results as driving
+// erode_tumble_material_v2/v3 from foreach loops
+struct erode_granular_slump : INode {
+    void apply() override {
 
-                        int cond = 0;
-                        if (dir_prob >= 1.0f)
-                            cond = 1;
-                        else {
-                            dir_prob = dir_prob * dir_prob * dir_prob * dir_prob;
-                            unsigned int cutoff = (unsigned int)(dir_prob * 4294967295.0);
-                            unsigned int randval = erode_random(seed, (idx + nx * nz) * 8 + color + iterseed);
-                            cond = randval < cutoff;
-                        }
+        // 初始化网格
+        auto terrain = get_input<PrimitiveObject>("prim_2DGrid");
+        int nx, nz;
+        auto &ud = terrain->userData();
+        if ((!ud.has<int>("nx")) || (!ud.has<int>("nz")))
+            zeno::log_error("no such UserData named '{}' and '{}'.", "nx", "nz");
+        nx = ud.get2<int>("nx");
+        nz = ud.get2<int>("nz");
+        auto &pos = terrain->verts;
+        vec3f p0 = pos[0];
+        vec3f p1 = pos[1];
+        float cellSize = length(p1 - p0);
 
-                        if (!cond || same_node)
-                            diff = 0.0f;
+        // 获取面板参数
+        auto gridbias = get_input2<float>("gridbias");
+        auto repose_angle = get_input2<float>("repose_angle");
+        auto quant_amt = get_input2<float>("quant_amt");
+        auto flow_rate = get_input2<float>("flow_rate");
+        auto seed = get_input2<float>("seed");
+        auto iterations = get_input2<int>("iterations");
+        auto openborder = get_input2<int>("openborder");
+        auto calc_flow = get_input2<bool>("calc_flow");
 
-                        diff *= flow_rate;
+        // 初始化网格属性
+        auto stablilityMaskName = get_input2<std::string>("stabilitymask");
+        if (!terrain->verts.has_attr(stablilityMaskName)) {
+            auto &_sta = terrain->verts.add_attr<float>(stablilityMaskName);
+            std::fill(_sta.begin(), _sta.end(), 0.0);
+        }
+        auto &stabilitymask = terrain->verts.attr<float>(stablilityMaskName);
 
-                        // CALC_FLOW
-                        diff_x += (float)dx * diff;
-                        diff_z += (float)dz * diff;
-                        diff_x *= -1.0f;
-                        diff_z *= -1.0f;
+        auto heightLayer = get_input2<std::string>("height_layer");
+        auto materialLayer = get_input2<std::string>("material_layer");
+        if (!terrain->verts.has_attr(heightLayer) ||
+            !terrain->verts.has_attr(materialLayer)) {
+            zeno::log_error("Node [erode_granular_slump], no such data layer named '{}' or '{}'.",
+                            heightLayer, materialLayer);
+        }
+        auto &height = terrain->verts.attr<float>(heightLayer);
+        auto &material = terrain->verts.attr<float>(materialLayer);
+        vec3f *flowdir = nullptr;
+        if (calc_flow) {
+            if (!terrain->verts.has_attr("flowdir"))
+                terrain->verts.add_attr<vec3f>("flowdir");
+            flowdir = terrain->verts.attr<vec3f>("flowdir").data();
+        }
 
-                        float abs_diff = (diff < 0.0f) ? -diff : diff;
-                        _material[c_idx] = c_material - abs_diff;
-                        _material[n_idx] = n_material + abs_diff;
-
-                        // CALC_FLOW
-                        float abs_c_x = flowdir[c_idx][0];
-                        abs_c_x = (abs_c_x < 0.0f) ? -abs_c_x : abs_c_x;
-                        float abs_c_z = flowdir[c_idx][2];
-                        abs_c_z = (abs_c_z < 0.0f) ? -abs_c_z : abs_c_z;
-                        flowdir[c_idx][0] += diff_x * 1.0f / (1.0f + abs_c_x);
-                        flowdir[c_idx][2] += diff_z * 1.0f / (1.0f + abs_c_z);
-                    }
-                }
+        // 计算: temp_material is kept equal to material between sub-iterations by
+        // copying back only the cells written, instead of the whole layer
+        erode_slump_params params{nx, nz, cellSize, seed, openborder, gridbias, repose_angle, quant_amt, flow_rate};
+        std::vector<float> temp_material(material.begin(), material.end());
+        for (int iter = 1; iter <= iterations; iter++) {
+            int perm[8], p_dirs[2], x_dirs[2];
+            erode_rand_color_perm(iterations, iter, perm);
+            erode_rand_dirs(iterations, iter, p_dirs);
+            erode_rand_dirs(iterations * 10, iter, x_dirs);
+            for (int i = 0; i < 8; i++) {
+                if (calc_flow)
+                    erode_slump_step<true>(params, iter, perm[i], p_dirs, x_dirs, height.data(), temp_material.data(),
+                                           material.data(), stabilitymask.data(), flowdir, temp_material.data());
+                else
+                    erode_slump_step<false>(params, iter, perm[i], p_dirs, x_dirs, height.data(), temp_material.data(),
+                                            material.data(), stabilitymask.data(), nullptr, temp_material.data());
             }
         }
 
         set_output("prim_2DGrid", std::move(terrain));
     }
 };
-ZENDEFNODE(erode_tumble_material_v3,
+ZENDEFNODE(erode_granular_slump,
            {/* inputs: */ {
                    "prim_2DGrid",
 
+                   {"string", "height_layer", "height"},
+                   {"string", "material_layer", "debris"},
                    {"string", "stabilitymask", "_stability"},
-                   {"ListObject", "perm"},
-                   {"ListObject", "p_dirs"},
-                   {"ListObject", "x_dirs"},
+                   {"bool", "calc_flow", "0"},
 
+                   {"int", "iterations", "10"},
                    {"float", "seed", "15231.3"},
-                   {"int", "iterations", "0"},
-                   {"int", "iter", "0"},
-                   {"int", "i", "0"},
-
                    {"int", "openborder", "0"},
                    {"float", "gridbias", "0.0"},
 
                    // 崩塌流淌相关
-                   {"float", "repose_angle", "0.0"},
-                   {"float", "quant_amt", "0.0"},
+                   {"float", "repose_angle", "15.0"},
+                   {"float", "quant_amt", "0.25"},
                    {"float", "flow_rate", "1.0"},
                },
                /* outputs: */
@@ -1648,7 +1644,6 @@ ZENDEFNODE(erode_tumble_material_v3,
                },
                /* params: */
                {
-                   //{"string", "stabilitymask", "_stability"},
                },
                /* category: */
                {
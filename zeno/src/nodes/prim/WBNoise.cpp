@@ -5,6 +5,7 @@
 #include <zeno/zeno.h>
 #include <zeno/types/PrimitiveObject.h>
 #include <zeno/types/UserData.h>
+#include <zeno/funcs/NoiseBatch.h>
 #include <zeno/utils/log.h>
 #include <glm/gtx/quaternion.hpp>
 #include <cmath>
@@ -129,6 +130,26 @@ float noise_perlin(float x, float y, float z)
     return mix(y1, y2, w);
 }
 
+// fills a noise attribute from a batch evaluator `batch(float *out, int rot, std::size_t outStride)`,
+// vec3f attributes get the three coordinate rotations as their components
+template <class Arr, class Batch>
+void noise_fill_attr(Arr &arr, Batch const &batch) {
+    using T = std::decay_t<decltype(arr[0])>;
+    if constexpr (std::is_same_v<T, vec3f>) {
+        for (int c = 0; c < 3; c++)
+            batch(reinterpret_cast<float *>(arr.data()) + c, c, 3);
+    }
+    else if constexpr (std::is_same_v<T, float>) {
+        batch(arr.data(), 0, 1);
+    }
+    else {
+        std::vector<float> tmp(arr.size());
+        batch(tmp.data(), 0, 1);
+        for (size_t i = 0; i < arr.size(); i++)
+            arr[i] = tmp[i];
+    }
+}
+
 struct erode_noise_perlin : INode {
     void apply() override {
         auto terrain = get_input<PrimitiveObject>("prim_2DGrid");
@@ -149,21 +170,9 @@ struct erode_noise_perlin : INode {
 
 
         terrain->attr_visit(attrName, [&](auto& arr) {
-#pragma omp parallel for
-            for (int i = 0; i < arr.size(); i++)
-            {
-                if constexpr (is_decay_same_v<decltype(arr[i]), vec3f>)
-                {
-                    float x = noise_perlin(vec3fAttr[i][0], vec3fAttr[i][1], vec3fAttr[i][2]);
-                    float y = noise_perlin(vec3fAttr[i][1], vec3fAttr[i][2], vec3fAttr[i][0]);
-                    float z = noise_perlin(vec3fAttr[i][2], vec3fAttr[i][0], vec3fAttr[i][1]);
-                    arr[i] = vec3f(x, y, z);
-                }
-                else
-                {
-                    arr[i] = noise_perlin(vec3fAttr[i][0], vec3fAttr[i][1], vec3fAttr[i][2]);
-                }
-            }
+            noise_fill_attr(arr, [&](float* out, int rot, std::size_t stride) {
+                noisePerlinBatch(vec3fAttr.data(), out, arr.size(), rot, stride);
+                });
             });
 
         set_output("prim_2DGrid", get_input("prim_2DGrid"));
@@ -201,28 +210,6 @@ const int noise_simplex[][4] = {
     {2,1,0,3},{0,0,0,0},{0,0,0,0},{0,0,0,0},{3,1,0,2},{0,0,0,0},{3,2,0,1},{3,2,1,0}
 };
 
-float noise_sGrad3(int hash, float x, float y, float z) {
-    switch (hash & 0xF) {
-    case 0x0: return  x + y;
-    case 0x1: return -x + y;
-    case 0x2: return  x - y;
-    case 0x3: return -x - y;
-    case 0x4: return  x + z;
-    case 0x5: return -x + z;
-    case 0x6: return  x - z;
-    case 0x7: return -x - z;
-    case 0x8: return  y + z;
-    case 0x9: return -y + z;
-    case 0xA: return  y - z;
-    case 0xB: return -y - z;
-    case 0xC: return  y + x;
-    case 0xD: return -y + z;
-    case 0xE: return  y - x;
-    case 0xF: return -y - z;
-    default: return 0;
-    }
-}
-
 float noise_sGrad4(int hash, float x, float y, float z, float w) {
     switch (hash & 0x1F) {
     case 0x00: return  y + z + w;
@@ -264,125 +251,6 @@ float noise_sGrad4(int hash, float x, float y, float z, float w) {
     }
 }
 
-// 3D Perlin simplex noise
-// @param[in] x float coordinate
-// @param[in] y float coordinate
-// @param[in] z float coordinate
-// @return Noise value in the range[-1; 1], value of 0 on all integer coordinates.
-float noise_simplexNoise3(float x, float y, float z) {
-    float n0, n1, n2, n3; // Noise contributions from the four corners
-
-    // Skewing/Unskewing factors for 3D
-    static const float F3 = 1.0f / 3.0f;
-    static const float G3 = 1.0f / 6.0f;
-
-    // Skew the input space to determine which simplex cell we're in
-    float s = (x + y + z) * F3; // Very nice and simple skew factor for 3D
-    int i = noise_fastfloor(x + double(s));
-    int j = noise_fastfloor(y + double(s));
-    int k = noise_fastfloor(z + double(s));
-    float t = (float)(i + j + k) * G3;
-    float X0 = (float)i - t; // Unskew the cell origin back to (x,y,z) space
-    float Y0 = (float)j - t;
-    float Z0 = (float)k - t;
-    float x0 = x - X0; // The x,y,z distances from the cell origin
-    float y0 = y - Y0;
-    float z0 = z - Z0;
-
-    // For the 3D case, the simplex shape is a slightly irregular tetrahedron.
-    // Determine which simplex we are in.
-    int i1, j1, k1; // Offsets for second corner of simplex in (i,j,k) coords
-    int i2, j2, k2; // Offsets for third corner of simplex in (i,j,k) coords
-    if (x0 >= y0) {
-        if (y0 >= z0) {
-            i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; // X Y Z order
-        }
-        else if (x0 >= z0) {
-            i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; // X Z Y order
-        }
-        else {
-            i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; // Z X Y order
-        }
-    }
-    else { // x0<y0
-        if (y0 < z0) {
-            i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; // Z Y X order
-        }
-        else if (x0 < z0) {
-            i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; // Y Z X order
-        }
-        else {
-            i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; // Y X Z order
-        }
-    }
-
-    // A step of (1,0,0) in (i,j,k) means a step of (1-c,-c,-c) in (x,y,z),
-    // a step of (0,1,0) in (i,j,k) means a step of (-c,1-c,-c) in (x,y,z), and
-    // a step of (0,0,1) in (i,j,k) means a step of (-c,-c,1-c) in (x,y,z), where
-    // c = 1/6.
-    float x1 = x0 - (float)i1 + G3; // Offsets for second corner in (x,y,z) coords
-    float y1 = y0 - (float)j1 + G3;
-    float z1 = z0 - (float)k1 + G3;
-    float x2 = x0 - (float)i2 + 2.0f * G3; // Offsets for third corner in (x,y,z) coords
-    float y2 = y0 - (float)j2 + 2.0f * G3;
-    float z2 = z0 - (float)k2 + 2.0f * G3;
-    float x3 = x0 - 1.0f + 3.0f * G3; // Offsets for last corner in (x,y,z) coords
-    float y3 = y0 - 1.0f + 3.0f * G3;
-    float z3 = z0 - 1.0f + 3.0f * G3;
-
-    // Wrap the integer indices at 256, to avoid indexing permutation[] out of bounds
-    int ii = i & 0xff;
-    int jj = j & 0xff;
-    int kk = k & 0xff;
-
-    // Work out the hashed gradient indices of the four simplex corners
-    int gi0 = noise_permutation[ii + noise_permutation[jj + noise_permutation[kk]]];
-    int gi1 = noise_permutation[ii + i1 + noise_permutation[jj + j1 + noise_permutation[kk + k1]]];
-    int gi2 = noise_permutation[ii + i2 + noise_permutation[jj + j2 + noise_permutation[kk + k2]]];
-    int gi3 = noise_permutation[ii + 1 + noise_permutation[jj + 1 + noise_permutation[kk + 1]]];
-
-    // Calculate the contribution from the four corners
-    float t0 = 0.6f - x0 * x0 - y0 * y0 - z0 * z0;
-    //    float t0 = 0.5f - x0*x0 - y0*y0 - z0*z0;
-    if (t0 < 0) {
-        n0 = 0.0;
-    }
-    else {
-        t0 *= t0;
-        n0 = t0 * t0 * noise_sGrad3(gi0, x0, y0, z0);
-    }
-    float t1 = 0.6f - x1 * x1 - y1 * y1 - z1 * z1;
-    //    float t1 = 0.5f - x1*x1 - y1*y1 - z1*z1;
-    if (t1 < 0) {
-        n1 = 0.0;
-    }
-    else {
-        t1 *= t1;
-        n1 = t1 * t1 * noise_sGrad3(gi1, x1, y1, z1);
-    }
-    float t2 = 0.6f - x2 * x2 - y2 * y2 - z2 * z2;
-    //    float t2 = 0.5f - x2*x2 - y2*y2 - z2*z2;
-    if (t2 < 0) {
-        n2 = 0.0;
-    }
-    else {
-        t2 *= t2;
-        n2 = t2 * t2 * noise_sGrad3(gi2, x2, y2, z2);
-    }
-    float t3 = 0.6f - x3 * x3 - y3 * y3 - z3 * z3;
-    //    float t3 = 0.5f - x3*x3 - y3*y3 - z3*z3;
-    if (t3 < 0) {
-        n3 = 0.0;
-    }
-    else {
-        t3 *= t3;
-        n3 = t3 * t3 * noise_sGrad3(gi3, x3, y3, z3);
-    }
-    // Add contributions from each corner to get the final noise value.
-    // The result is scaled to stay just inside [-1,1]
-    return 32.0f * (n0 + n1 + n2 + n3);
-}
-
 // 4D Perlin simplex noise
 // @param[in] x float coordinate
 // @param[in] y float coordinate
@@ -548,20 +416,9 @@ struct erode_noise_simplex : INode {
         auto& pos = terrain->verts.attr<zeno::vec3f>(posLikeAttrName);
 
         terrain->attr_visit(attrName, [&](auto& arr) {
-#pragma omp parallel for
-            for (int i = 0; i < arr.size(); i++)
-            {
-                if constexpr (is_decay_same_v<decltype(arr[i]), vec3f>) {
-                    float x = noise_simplexNoise3(pos[i][0], pos[i][1], pos[i][2]);
-                    float y = noise_simplexNoise3(pos[i][1], pos[i][2], pos[i][0]);
-                    float z = noise_simplexNoise3(pos[i][2], pos[i][0], pos[i][1]);
-                    arr[i] = vec3f(x, y, z);
-                }
-                else
-                {
-                    arr[i] = noise_simplexNoise3(pos[i][0], pos[i][1], pos[i][2]);
-                }
-            }
+            noise_fill_attr(arr, [&](float* out, int rot, std::size_t stride) {
+                noiseSimplexBatch(pos.data(), out, arr.size(), rot, stride);
+                });
             });
 
         set_output("prim_2DGrid", get_input("prim_2DGrid"));
@@ -1372,70 +1229,6 @@ ZENDEFNODE(Noise_gabor_2d, {/* inputs: */ {
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Worley Noise
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-glm::vec3 noise_random3(glm::vec3 p) {
-    glm::vec3 val = sin(glm::vec3(dot(p, glm::vec3(127.1, 311.7, 74.7)),
-        dot(p, glm::vec3(269.5, 183.3, 246.1)),
-        dot(p, glm::vec3(113.5, 271.9, 124.6))));
-    val *= 43758.5453123;
-    return fract(val);
-}
-
-float noise_mydistance(glm::vec3 a, glm::vec3 b, int t) {
-    if (t == 0) {
-        float d = length(a - b);
-        return d*d;
-    }
-    else if (t == 1) {
-        float xx = abs(a.x - b.x);
-        float yy = abs(a.y - b.y);
-        float zz = abs(a.z - b.z);
-        return max(max(xx, yy), zz);
-    }
-    else {
-        float xx = abs(a.x - b.x);
-        float yy = abs(a.y - b.y);
-        float zz = abs(a.z - b.z);
-        return xx + yy + zz;
-    }
-}
-
-float noise_WorleyNoise3(float px, float py, float pz, int fType, int distType, float offsetX, float offsetY, float offsetZ, float jitter = 1) {
-    glm::vec3 pos = glm::vec3(px, py, pz);
-    glm::vec3 offset = glm::vec3(offsetX, offsetY, offsetZ);
-    glm::vec3 i_pos = floor(pos);
-    glm::vec3 f_pos = fract(pos);
-
-    float f1 = 9e9;
-    float f2 = f1;
-
-    for (int z = -1; z <= 1; z++) {
-        for (int y = -1; y <= 1; y++) {
-            for (int x = -1; x <= 1; x++) {
-                glm::vec3 neighbor = glm::vec3(float(x), float(y), float(z));
-                glm::vec3 point = noise_random3(i_pos + neighbor);
-                point = (float)0.5 + (float)0.5 * sin(offset + (float)6.2831 * point);
-                point = point * jitter;
-                glm::vec3 featurePoint = neighbor + point; 
-
-                float dist = noise_mydistance(featurePoint, f_pos, distType);
-                if (dist < f1) {
-                    f2 = f1; f1 = dist;
-                }
-                else if (dist < f2) {
-                    f2 = dist;
-                }
-            }
-        }
-    }
-
-    if (fType == 0) {
-        return f1;
-    }
-    else {
-        return f2 - f1;
-    }
-}
-
 struct erode_noise_worley : INode {
     void apply() override {
         auto terrain = get_input<PrimitiveObject>("prim_2DGrid");
@@ -1476,21 +1269,9 @@ struct erode_noise_worley : INode {
         }
 
         terrain->attr_visit(attrName, [&](auto& arr) {
-#pragma omp parallel for
-            for (int i = 0; i < arr.size(); i++)
-            {
-                if constexpr (is_decay_same_v<decltype(arr[i]), vec3f>)
-                {
-                    float x = noise_WorleyNoise3(pos[i][0], pos[i][1], pos[i][2], fType, distType, offset[0], offset[1], offset[2], jitter);
-                    float y = noise_WorleyNoise3(pos[i][1], pos[i][2], pos[i][0], fType, distType, offset[0], offset[1], offset[2], jitter);
-                    float z = noise_WorleyNoise3(pos[i][2], pos[i][0], pos[i][1], fType, distType, offset[0], offset[1], offset[2], jitter);
-                    arr[i] = vec3f(x, y, z);
-                }
-                else
-                {
-                    arr[i] = noise_WorleyNoise3(pos[i][0], pos[i][1], pos[i][2], fType, distType, offset[0], offset[1], offset[2], jitter);
-                }
-            }
+            noise_fill_attr(arr, [&](float* out, int rot, std::size_t stride) {
+                noiseWorleyBatch(pos.data(), out, arr.size(), fType, distType, offset, jitter, rot, stride);
+                });
             });
 
         set_output("prim_2DGrid", get_input("prim_2DGrid"));
@@ -1775,27 +1556,23 @@ ZENDEFNODE(erode_hybridMultifractal_v3,
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Domain Warping
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-float noise_fbm(vec3f pos, float H, float lacunarity, float frequence, float amplitude, int Octaves)
+// q = (fbm(pos), fbm(pos + (1.7, 2.8, 9.2)), fbm(pos + (5.2, 8.3, 1.3))), result fbm(pos + 4 * q)
+void noise_domainWarpingV1(vec3f const* pos, float* out, int n, float H, float frequence, int numOctaves)
 {
-    //float G = exp2(-H);    // float G = 0.5;
-    float t = 0.0;
-    for (int i = 0; i < Octaves; i++)
-    {
-        amplitude = pow(lacunarity, -H * i);
-        t += amplitude * noise_perlin(frequence * pos[0], frequence * pos[1], frequence * pos[2]);
-        //frequence *= 2.0;
-        frequence *= lacunarity;
-        //amplitude *= G;
+    const vec3f shift[3] = {vec3f(0.0, 0.0, 0.0), vec3f(1.7, 2.8, 9.2), vec3f(5.2, 8.3, 1.3)};
+    std::vector<vec3f> w(n);
+    std::vector<float> q[3];
+    for (int c = 0; c < 3; c++) {
+#pragma omp parallel for
+        for (int i = 0; i < n; i++)
+            w[i] = pos[i] + shift[c];
+        q[c].resize(n);
+        noiseFbmBatch(w.data(), q[c].data(), n, H, 2.0f, frequence, numOctaves);
     }
-    return t;
-}
-
-float noise_domainWarpingV1(vec3f pos, float H, float frequence, float amplitude, int numOctaves)
-{
-    vec3f q = vec3f(noise_fbm(pos + vec3f(0.0, 0.0, 0.0), H, 2.0f, frequence, amplitude, numOctaves),
-        noise_fbm(pos + vec3f(1.7, 2.8, 9.2), H, 2.0f, frequence, amplitude, numOctaves),
-        noise_fbm(pos + vec3f(5.2, 8.3, 1.3), H, 2.0f, frequence, amplitude, numOctaves));
-    return noise_fbm(pos + 4.0 * q, H, 2.0f, frequence, amplitude, numOctaves);
+#pragma omp parallel for
+    for (int i = 0; i < n; i++)
+        w[i] = pos[i] + 4.0 * vec3f(q[0][i], q[1][i], q[2][i]);
+    noiseFbmBatch(w.data(), out, n, H, 2.0f, frequence, numOctaves);
 }
 
 struct erode_domainWarping_v1 : INode {
@@ -1804,7 +1581,6 @@ struct erode_domainWarping_v1 : INode {
 
         auto H = get_input<NumericObject>("fbmH")->get<float>();
         auto frequence = get_input<NumericObject>("fbmFrequence")->get<float>();
-        auto amplitude = get_input<NumericObject>("fbmAmplitude")->get<float>();
         auto numOctaves = get_input<NumericObject>("fbmNumOctaves")->get<int>();
 
         auto attrName = get_param<std::string>("attrName");
@@ -1815,17 +1591,17 @@ struct erode_domainWarping_v1 : INode {
             else if (attrType == "float") prim->add_attr<float>(attrName);
         }
 
+        // the warp does not depend on the component, vec3f attributes get it broadcast
+        std::vector<float> warp(pos.size());
+        noise_domainWarpingV1(pos.data(), warp.data(), pos.size(), H, frequence, numOctaves);
         prim->attr_visit(attrName, [&](auto& arr) {
 #pragma omp parallel for
             for (int i = 0; i < arr.size(); i++) {
                 if constexpr (is_decay_same_v<decltype(arr[i]), vec3f>) {
-                    float x = noise_domainWarpingV1(pos[i], H, frequence, amplitude, numOctaves);
-                    float y = noise_domainWarpingV1(pos[i], H, frequence, amplitude, numOctaves);
-                    float z = noise_domainWarpingV1(pos[i], H, frequence, amplitude, numOctaves);
-                    arr[i] = vec3f(x, y, z);
+                    arr[i] = vec3f(warp[i], warp[i], warp[i]);
                 }
                 else {
-                    arr[i] = noise_domainWarpingV1(pos[i], H, frequence, amplitude, numOctaves);
+                    arr[i] = warp[i];
                 }
             }
             });
@@ -1849,17 +1625,31 @@ ZENDEFNODE(erode_domainWarping_v1,
             "erode",
         } });
 
-float noise_domainWarpingV2(vec3f pos, float H, float frequence, float amplitude, int numOctaves)
+// q as in v1, r = fbm(pos + 4 * q + shift) for another three shifts, result fbm(pos + 4 * r)
+void noise_domainWarpingV2(vec3f const* pos, float* out, int n, float H, float frequence, int numOctaves)
 {
-    vec3f q = vec3f(noise_fbm(pos + vec3f(0.0, 0.0, 0.0), H, 2.0f, frequence, amplitude, numOctaves),
-        noise_fbm(pos + vec3f(1.7, 2.8, 9.2), H, 2.0f, frequence, amplitude, numOctaves),
-        noise_fbm(pos + vec3f(5.2, 8.3, 1.3), H, 2.0f, frequence, amplitude, numOctaves));
-
-    vec3f r = vec3f(noise_fbm(pos + 4.0 * q + vec3f(2.8, 9.2, 1.7), H, 2.0f, frequence, amplitude, numOctaves),
-        noise_fbm(pos + 4.0 * q + vec3f(9.2, 1.7, 2.8), H, 2.0f, frequence, amplitude, numOctaves),
-        noise_fbm(pos + 4.0 * q + vec3f(1.3, 5.2, 8.3), H, 2.0f, frequence, amplitude, numOctaves));
-
-    return noise_fbm(pos + 4.0 * r, H, 2.0f, frequence, amplitude, numOctaves);
+    const vec3f qshift[3] = {vec3f(0.0, 0.0, 0.0), vec3f(1.7, 2.8, 9.2), vec3f(5.2, 8.3, 1.3)};
+    const vec3f rshift[3] = {vec3f(2.8, 9.2, 1.7), vec3f(9.2, 1.7, 2.8), vec3f(1.3, 5.2, 8.3)};
+    std::vector<vec3f> w(n);
+    std::vector<float> q[3], r[3];
+    for (int c = 0; c < 3; c++) {
+#pragma omp parallel for
+        for (int i = 0; i < n; i++)
+            w[i] = pos[i] + qshift[c];
+        q[c].resize(n);
+        noiseFbmBatch(w.data(), q[c].data(), n, H, 2.0f, frequence, numOctaves);
+    }
+    for (int c = 0; c < 3; c++) {
+#pragma omp parallel for
+        for (int i = 0; i < n; i++)
+            w[i] = pos[i] + 4.0 * vec3f(q[0][i], q[1][i], q[2][i]) + rshift[c];
+        r[c].resize(n);
+        noiseFbmBatch(w.data(), r[c].data(), n, H, 2.0f, frequence, numOctaves);
+    }
+#pragma omp parallel for
+    for (int i = 0; i < n; i++)
+        w[i] = pos[i] + 4.0 * vec3f(r[0][i], r[1][i], r[2][i]);
+    noiseFbmBatch(w.data(), out, n, H, 2.0f, frequence, numOctaves);
 }
 
 struct erode_domainWarping_v2 : INode {
@@ -1870,7 +1660,6 @@ struct erode_domainWarping_v2 : INode {
 
         auto H = get_input<NumericObject>("fbmH")->get<float>();
         auto frequence = get_input<NumericObject>("fbmFrequence")->get<float>();
-        auto amplitude = get_input<NumericObject>("fbmAmplitude")->get<float>();
         auto numOctaves = get_input<NumericObject>("fbmNumOctaves")->get<int>();
 
         auto attrName = get_param<std::string>("attrName");
@@ -1881,17 +1670,17 @@ struct erode_domainWarping_v2 : INode {
             else if (attrType == "float") prim->add_attr<float>(attrName);
         }
 
+        // the warp does not depend on the component, vec3f attributes get it broadcast
+        std::vector<float> warp(pos.size());
+        noise_domainWarpingV2(pos.data(), warp.data(), pos.size(), H, frequence, numOctaves);
         prim->attr_visit(attrName, [&](auto& arr) {
 #pragma omp parallel for
             for (int i = 0; i < arr.size(); i++) {
                 if constexpr (is_decay_same_v<decltype(arr[i]), vec3f>) {
-                    float x = noise_domainWarpingV2(pos[i], H, frequence, amplitude, numOctaves);
-                    float y = noise_domainWarpingV2(pos[i], H, frequence, amplitude, numOctaves);
-                    float z = noise_domainWarpingV2(pos[i], H, frequence, amplitude, numOctaves);
-                    arr[i] = vec3f(x, y, z);
+                    arr[i] = vec3f(warp[i], warp[i], warp[i]);
                 }
                 else {
-                    arr[i] = noise_domainWarpingV2(pos[i], H, frequence, amplitude, numOctaves);
+                    arr[i] = warp[i];
                 }
             }
             });
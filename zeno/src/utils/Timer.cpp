@@ -22,11 +22,13 @@ void Timer::_destroy(Timer::ClockType::time_point &&end) {
     auto diff = end - beg;
     int us = std::chrono::duration_cast
         <std::chrono::microseconds>(diff).count();
+    std::lock_guard lck(records_mtx);
     records.emplace_back(std::move(tag), us);
 }
 
-Timer *Timer::current = nullptr;
+thread_local Timer *Timer::current = nullptr;
 std::vector<Timer::Record> Timer::records;
+std::mutex Timer::records_mtx;
 
 std::string Timer::getLog() {
     if (records.size() == 0) {
@@ -5,6 +5,7 @@
 #include <zeno/utils/PolymorphicMap.h>
 #include <zeno/utils/disable_copy.h>
 #include <zeno/core/IObject.h>
+#include <zeno/extra/GlobalComm.h>
 #include <string>
 #include <memory>
 #include <map>
@@ -12,26 +13,32 @@
 namespace zenovis {
 
 struct ObjectsManager : zeno::disable_copy {
-    zeno::MapStablizer<zeno::PolymorphicMap<std::map<
+    mutable zeno::MapStablizer<zeno::PolymorphicMap<std::map<
         std::string, std::shared_ptr<zeno::IObject>>>> objects;
+    // loaded under new keys but not decoded yet, see decode_pending
+    mutable zeno::GlobalComm::ViewObjectHandles pendingObjects;
 
-    std::map<std::string, std::shared_ptr<zeno::IObject>> lightObjects;
+    mutable std::map<std::string, std::shared_ptr<zeno::IObject>> lightObjects;
     bool needUpdateLight = true;
 
     template <class T = void>
     auto pairs() const {
+        decode_pending();
         return objects.pairs<T>();
     }
 
     template <class T = void>
     auto pairsShared() const {
+        decode_pending();
         return objects.pairsShared<T>();
     }
 
     ObjectsManager();
     ~ObjectsManager();
     void clear_objects();
-    bool load_objects(std::map<std::string, std::shared_ptr<zeno::IObject>> const &objs);
+    // only keeps the handles of keys not loaded yet, they are decoded on first use
+    bool load_objects(zeno::GlobalComm::ViewObjectHandles const &objs);
+    void decode_pending() const;
 
     std::optional<zeno::IObject*> get(std::string nid);
 };
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <zeno/utils/vec.h>
+
+namespace zeno {
+struct PrimitiveObject;
+struct PrimitiveTopology;
+}
+
+namespace zenovis {
+
+// CPU side of the primitive graphic, without any GL calls.
+//
+// a prep is shared by every primitive whose faces, lines, points and point count
+// are equal, so scrubbing a cache with fixed topology reuses the
+// edge lists, triangulation and index buffers, and re-derives or re-packs a channel
+// only when the hash of its inputs differs from the one recorded with it.
+struct PrimMeshPrep {
+    // copy of the index arrays, a prim whose arrays compare equal to them gets this prep
+    struct Snapshot {
+        std::size_t numVerts{};
+        int subdivLevels{};
+        std::vector<int> points;
+        std::vector<zeno::vec2i> lines;
+        std::vector<zeno::vec3i> tris;
+        std::vector<zeno::vec4i> quads;
+        std::vector<zeno::vec2i> polys;
+        std::vector<int> loops;
+        std::vector<int> loopUvs;
+    } snapshot;
+
+    // topology-derived
+    bool polyEdgesReady{};
+    std::vector<int> polyEdges;         // point pairs along the sides of polys with more than 3 corners
+    std::vector<int> polyUvEdges;       // the same sides over loops.attr<int>("uvs"), if present
+    std::shared_ptr<zeno::PrimitiveTopology const> halfedges; // of the faces before subdivision
+    std::vector<zeno::vec3i> triCorners; // (3i, 3i+1, 3i+2), index buffer of the per-corner layout
+
+    // primTriangulateQuads + primTriangulate of the faces as they are after subdivision,
+    // valid while the counts it was made from still match
+    bool trisReady{};
+    std::array<std::size_t, 4> trisMadeFrom{}; // tris, quads, polys and loops count
+    std::vector<zeno::vec3i> quadTris;      // two per quad
+    std::vector<zeno::vec3i> polyTris;      // fans of the polys with 3 corners or more
+    std::vector<int> polyTriFaces;          // poly of each of polyTris
+    std::vector<zeno::vec3i> polyTriLoops;  // loops of the corners of each of polyTris
+    std::vector<zeno::vec2i> polyLines;     // polys with 2 corners
+
+    // hash of this frame's pos before subdivision, set by primMeshHashPositions;
+    // subdivided and triangulated positions only depend on it and the topology
+    std::uint64_t posKey{};
+
+    // derived from attributes, tagged with the hash of their inputs
+    std::uint64_t nrmKey{};
+    std::vector<zeno::vec3f> nrm;
+    std::uint64_t tangKey{};
+    std::vector<zeno::vec3f> tang;
+
+    // pos, clr, nrm, uv and tang gathered to the three corners of each triangle
+    enum { CornerPos, CornerClr, CornerNrm, CornerUv, CornerTang, NumCornerChannels };
+    std::array<std::uint64_t, NumCornerChannels> cornerKeys{};
+    std::array<std::vector<zeno::vec3f>, NumCornerChannels> corners;
+};
+
+// the prep of the topology of prim, kept for the few most recently used topologies
+std::shared_ptr<PrimMeshPrep> getPrimMeshPrep(zeno::PrimitiveObject const *prim);
+
+// sets prep.posKey, call once per frame before prim is subdivided or triangulated
+void primMeshHashPositions(PrimMeshPrep &prep, zeno::PrimitiveObject const *prim);
+
+// edges of non-triangle polys for the wireframe and uv overlays, before triangulation
+void primMeshPolyEdges(PrimMeshPrep &prep, zeno::PrimitiveObject const *prim);
+
+// primCalcNormal(prim) over the cached half-edges, reusing the last normals if pos did not change
+void primMeshNormals(PrimMeshPrep &prep, zeno::PrimitiveObject *prim);
+
+// same result as primTriangulateQuads(prim) followed by primTriangulate(prim), but the
+// triangle and line indices are copied from the cache and only attributes are gathered
+void primMeshTriangulate(PrimMeshPrep &prep, zeno::PrimitiveObject *prim);
+
+// per-triangle tris.attr("tang") from pos and tris uv0, uv1 and uv2
+void primMeshTrianglesTangent(PrimMeshPrep &prep, zeno::PrimitiveObject *prim);
+
+// fills prep.corners and prep.triCorners for a triangulated prim with tris uvs
+void primMeshTriangleCorners(PrimMeshPrep &prep, zeno::PrimitiveObject const *prim);
+
+} // namespace zenovis
@@ -10,37 +10,45 @@ namespace zenovis {
 ObjectsManager::ObjectsManager() = default;
 ObjectsManager::~ObjectsManager() = default;
 
-bool ObjectsManager::load_objects(std::map<std::string, std::shared_ptr<zeno::IObject>> const &objs) {
+bool ObjectsManager::load_objects(zeno::GlobalComm::ViewObjectHandles const &objs) {
     bool inserted = false;
     auto ins = objects.insertPass();
 
-    bool changed_light = false;
-    for (auto const &[key, obj] : objs) {
+    zeno::GlobalComm::ViewObjectHandles pending;
+    for (auto const &[key, handle] : objs) {
         if (ins.may_emplace(key)) {
-            changed_light = true;
+            pending.try_emplace(key, handle);
+            if (!pendingObjects.count(key))
+                inserted = true;
         }
     }
-    if(changed_light){
+    if (!pending.empty()) {
         lightObjects.clear();
     }
-    for (auto const &[key, obj] : objs) {
-        if (ins.may_emplace(key)) {
-            if (auto prim_in = dynamic_cast<zeno::PrimitiveObject *>(obj.get())) {
-                auto isRealTimeObject = prim_in->userData().get2<int>("isRealTimeObject", 0);
-                if(isRealTimeObject){
-                    //printf("loading light object %s\n", key.c_str());
-                    lightObjects[key] = obj;
-                }
+    pendingObjects = std::move(pending);
+    return inserted;
+}
+
+void ObjectsManager::decode_pending() const {
+    for (auto const &[key, handle] : pendingObjects) {
+        auto obj = handle.get();
+        if (!obj)
+            continue;
+        if (auto prim_in = dynamic_cast<zeno::PrimitiveObject *>(obj.get())) {
+            auto isRealTimeObject = prim_in->userData().get2<int>("isRealTimeObject", 0);
+            if(isRealTimeObject){
+                //printf("loading light object %s\n", key.c_str());
+                lightObjects[key] = obj;
             }
-            ins.try_emplace(key, std::move(obj));
-            inserted = true;
         }
+        objects.m_curr.try_emplace(key, std::move(obj));
     }
-    return inserted;
+    pendingObjects.clear();
 }
 
 void ObjectsManager::clear_objects() {
     objects.clear();
+    pendingObjects.clear();
     lightObjects.clear();
 }
 
@@ -104,7 +104,7 @@ bool Scene::loadFrameObjects(int frameid) {
     auto &ud = zeno::getSession().userData();
     ud.set2<int>("frameid", std::move(frameid));
 
-    const auto& cbLoadObjs = [this](std::map<std::string, std::shared_ptr<zeno::IObject>> const& objs) -> bool {
+    const auto& cbLoadObjs = [this](zeno::GlobalComm::ViewObjectHandles const& objs) -> bool {
         return this->objectsMan->load_objects(objs);
     };
     bool isFrameValid = false;
@@ -14,6 +14,7 @@
 #include <zenovis/DrawOptions.h>
 #include <zenovis/Scene.h>
 #include <zenovis/bate/IGraphic.h>
+#include <zenovis/bate/PrimMeshPrep.h>
 #include <zenovis/ShaderManager.h>
 #include <zenovis/opengl/buffer.h>
 #include <zenovis/opengl/shader.h>
@@ -116,62 +117,6 @@ static void parseLinesDrawBuffer(zeno::PrimitiveObject *prim, ZhxxDrawObject &ob
     }
 }
 
-static void computeTrianglesTangent(zeno::PrimitiveObject *prim) {
-    const auto &tris = prim->tris;
-    const auto &pos = prim->attr<zeno::vec3f>("pos");
-    auto const &nrm = prim->attr<zeno::vec3f>("nrm");
-    auto &tang = prim->tris.add_attr<zeno::vec3f>("tang");
-    bool has_uv =
-        tris.has_attr("uv0") && tris.has_attr("uv1") && tris.has_attr("uv2");
-    //printf("!!has_uv = %d\n", has_uv);
-    const zeno::vec3f *uv0_data = nullptr;
-    const zeno::vec3f *uv1_data = nullptr;
-    const zeno::vec3f *uv2_data = nullptr;
-    if(has_uv)
-    {
-        uv0_data = tris.attr<zeno::vec3f>("uv0").data();
-        uv1_data = tris.attr<zeno::vec3f>("uv1").data();
-        uv2_data = tris.attr<zeno::vec3f>("uv2").data();
-    }
-#pragma omp parallel for
-    for (auto i = 0; i < prim->tris.size(); ++i) {
-        if (has_uv) {
-            const auto &pos0 = pos[tris[i][0]];
-            const auto &pos1 = pos[tris[i][1]];
-            const auto &pos2 = pos[tris[i][2]];
-            auto uv0 = uv0_data[i];
-            auto uv1 = uv1_data[i];
-            auto uv2 = uv2_data[i];
-
-            auto edge0 = pos1 - pos0;
-            auto edge1 = pos2 - pos0;
-            auto deltaUV0 = uv1 - uv0;
-            auto deltaUV1 = uv2 - uv0;
-
-            auto f = 1.0f / (deltaUV0[0] * deltaUV1[1] -
-                             deltaUV1[0] * deltaUV0[1] + 1e-5);
-
-            zeno::vec3f tangent;
-            tangent[0] = f * (deltaUV1[1] * edge0[0] - deltaUV0[1] * edge1[0]);
-            tangent[1] = f * (deltaUV1[1] * edge0[1] - deltaUV0[1] * edge1[1]);
-            tangent[2] = f * (deltaUV1[1] * edge0[2] - deltaUV0[1] * edge1[2]);
-            //printf("%f %f %f\n", tangent[0], tangent[1], tangent[3]);
-            auto tanlen = zeno::length(tangent);
-            tangent *(1.f / (tanlen + 1e-8));
-            /*if (std::abs(tanlen) < 1e-8) {//fix by BATE
-                zeno::vec3f n = nrm[tris[i][0]], unused;
-                zeno::pixarONB(n, tang[i], unused);//TODO calc this in shader?
-            } else {
-                tang[i] = tangent * (1.f / tanlen);
-            }*/
-            tang[i] = tangent;
-        } else {
-            tang[i] = zeno::vec3f(0);
-            //zeno::vec3f n = nrm[tris[i][0]], unused;
-            //zeno::pixarONB(n, tang[i], unused);
-        }
-    }
-}
 #if 0
 static void parseTrianglesDrawBufferCompress(zeno::PrimitiveObject *prim, ZhxxDrawObject &obj) {
     //TICK(parse);
@@ -257,71 +202,21 @@ static void parseTrianglesDrawBufferCompress(zeno::PrimitiveObject *prim, ZhxxDr
     /* TOCK(bindebo); */
 }
 #endif
-static void parseTrianglesDrawBuffer(zeno::PrimitiveObject *prim, ZhxxDrawObject &obj) {
+static void parseTrianglesDrawBuffer(zeno::PrimitiveObject *prim, PrimMeshPrep &prep, ZhxxDrawObject &obj) {
     /* TICK(parse); */
-    auto const &pos = prim->attr<zeno::vec3f>("pos");
-    auto const &clr = prim->attr<zeno::vec3f>("clr");
-    auto const &nrm = prim->attr<zeno::vec3f>("nrm");
-    auto const &tris = prim->tris;
-
-    obj.count = tris.size();
+    primMeshTriangleCorners(prep, prim);
+    obj.count = prim->tris.size();
     obj.vbos.resize(5);
-    std::vector<zeno::vec3i> trisdata(obj.count);
-    auto &tang = prim->tris.attr<zeno::vec3f>("tang");
-    std::vector<zeno::vec3f> _pos(obj.count * 3);
-    std::vector<zeno::vec3f> _clr(obj.count * 3);
-    std::vector<zeno::vec3f> _nrm(obj.count * 3);
-    std::vector<zeno::vec3f> _uv(obj.count * 3);
-    std::vector<zeno::vec3f> _tang(obj.count * 3);
-
-#pragma omp parallel for
-    for (auto i = 0; i < obj.count; i++) {
-        _pos[i * 3 + 0] = pos[tris[i][0]];
-        _pos[i * 3 + 1] = pos[tris[i][1]];
-        _pos[i * 3 + 2] = pos[tris[i][2]];
-
-        _clr[i * 3 + 0] = clr[tris[i][0]];
-        _clr[i * 3 + 1] = clr[tris[i][1]];
-        _clr[i * 3 + 2] = clr[tris[i][2]];
-
-        _nrm[i * 3 + 0] = nrm[tris[i][0]];
-        _nrm[i * 3 + 1] = nrm[tris[i][1]];
-        _nrm[i * 3 + 2] = nrm[tris[i][2]];
-
-        _tang[i * 3 + 0] = tang[i];
-        _tang[i * 3 + 1] = tang[i];
-        _tang[i * 3 + 2] = tang[i];
-
-        trisdata[i] = zeno::vec3i(i * 3, i * 3 + 1, i * 3 + 2);
+    for (int c = 0; c < PrimMeshPrep::NumCornerChannels; c++) {
+        auto const &data = prep.corners[c];
+        obj.vbos[c] = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
+        obj.vbos[c]->bind_data(data.data(), data.size() * sizeof(data[0]));
     }
-    bool has_uv =
-            tris.has_attr("uv0") && tris.has_attr("uv1") && tris.has_attr("uv2");
-    if (has_uv) {
-        auto &uv0 = tris.attr<zeno::vec3f>("uv0");
-        auto &uv1 = tris.attr<zeno::vec3f>("uv1");
-        auto &uv2 = tris.attr<zeno::vec3f>("uv2");
-        for (auto i = 0; i < obj.count; i++) {
-            _uv[i * 3 + 0] = uv0[i];
-            _uv[i * 3 + 1] = uv1[i];
-            _uv[i * 3 + 2] = uv2[i];
-        }
-    }
-
-    obj.vbos[0] = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
-    obj.vbos[0]->bind_data(_pos.data(), _pos.size() * sizeof(_pos[0]));
-    obj.vbos[1] = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
-    obj.vbos[1]->bind_data(_clr.data(), _clr.size() * sizeof(_clr[0]));
-    obj.vbos[2] = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
-    obj.vbos[2]->bind_data(_nrm.data(), _nrm.size() * sizeof(_nrm[0]));
-    obj.vbos[3] = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
-    obj.vbos[3]->bind_data(_uv.data(), _uv.size() * sizeof(_uv[0]));
-    obj.vbos[4] = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
-    obj.vbos[4]->bind_data(_tang.data(), _tang.size() * sizeof(_tang[0]));
     /* TOCK(bindvbo); */
     /* TICK(bindebo); */
     if (obj.count) {
         obj.ebo = std::make_unique<Buffer>(GL_ELEMENT_ARRAY_BUFFER);
-        obj.ebo->bind_data(&(trisdata[0]), obj.count * sizeof(trisdata[0]));
+        obj.ebo->bind_data(prep.triCorners.data(), obj.count * sizeof(prep.triCorners[0]));
     }
     /* TOCK(bindebo); */
 }
@@ -363,72 +258,32 @@ struct ZhxxGraphicPrimitive final : IGraphicDraw {
         invisible = prim->userData().get2<bool>("invisible", 0);
         zeno::log_trace("rendering primitive size {}", prim->size());
 
-        {
-            bool any_not_triangle = false;
-            for (const auto &[b, c]: prim->polys) {
-                if (c > 3) {
-                    any_not_triangle = true;
-                }
-            }
-            if (any_not_triangle) {
-                std::vector<int> edge_list;
-                auto add_edge = [&](int a, int b) {
-                    int p0 = prim->loops[a];
-                    int p1 = prim->loops[b];
-                    edge_list.push_back(p0);
-                    edge_list.push_back(p1);
-                };
-                for (const auto &[b, c]: prim->polys) {
-                    for (auto i = 2; i < c; i++) {
-                        if (i == 2) {
-                            add_edge(b, b + 1);
-                        }
-                        add_edge(b + i - 1, b + i);
-                        if (i == c - 1) {
-                            add_edge(b, b + i);
-                        }
-                    }
-                }
-                polyEdgeObj.count = edge_list.size();
-                polyEdgeObj.ebo = std::make_unique<Buffer>(GL_ELEMENT_ARRAY_BUFFER);
-                polyEdgeObj.ebo->bind_data(edge_list.data(), edge_list.size() * sizeof(edge_list[0]));
-                auto vbo = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
-                vbo->bind_data(prim->verts.data(), prim->verts.size() * sizeof(prim->verts[0]));
-                polyEdgeObj.vbos.push_back(std::move(vbo));
-                polyEdgeObj.prog = get_edge_program();
-            }
-            if (any_not_triangle && prim->loops.attr_is<int>("uvs")) {
-                std::vector<zeno::vec3f> uv_data;
-                std::vector<int> uv_list;
-                auto &uvs = prim->loops.attr<int>("uvs");
-                auto add_uv = [&](int a, int b) {
-                    int p0 = uvs[a];
-                    int p1 = uvs[b];
-                    uv_list.push_back(p0);
-                    uv_list.push_back(p1);
-                };
-                for (const auto &[b, c]: prim->polys) {
-                    for (auto i = 2; i < c; i++) {
-                        if (i == 2) {
-                            add_uv(b, b + 1);
-                        }
-                        add_uv(b + i - 1, b + i);
-                        if (i == c - 1) {
-                            add_uv(b, b + i);
-                        }
-                    }
-                }
-                polyUvObj.count = uv_list.size();
-                polyUvObj.ebo = std::make_unique<Buffer>(GL_ELEMENT_ARRAY_BUFFER);
-                polyUvObj.ebo->bind_data(uv_list.data(), uv_list.size() * sizeof(uv_list[0]));
-                auto vbo = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
-                for (const auto &uv: prim->uvs) {
-                    uv_data.emplace_back(uv[0], uv[1], 0);
-                }
-                vbo->bind_data(uv_data.data(), uv_data.size() * sizeof(uv_data[0]));
-                polyUvObj.vbos.push_back(std::move(vbo));
-                polyUvObj.prog = get_edge_program();
+        auto prep = getPrimMeshPrep(prim);
+        primMeshHashPositions(*prep, prim);
+        primMeshPolyEdges(*prep, prim);
+        if (!prep->polyEdges.empty()) {
+            auto const &edge_list = prep->polyEdges;
+            polyEdgeObj.count = edge_list.size();
+            polyEdgeObj.ebo = std::make_unique<Buffer>(GL_ELEMENT_ARRAY_BUFFER);
+            polyEdgeObj.ebo->bind_data(edge_list.data(), edge_list.size() * sizeof(edge_list[0]));
+            auto vbo = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
+            vbo->bind_data(prim->verts.data(), prim->verts.size() * sizeof(prim->verts[0]));
+            polyEdgeObj.vbos.push_back(std::move(vbo));
+            polyEdgeObj.prog = get_edge_program();
+        }
+        if (!prep->polyUvEdges.empty()) {
+            auto const &uv_list = prep->polyUvEdges;
+            std::vector<zeno::vec3f> uv_data;
+            polyUvObj.count = uv_list.size();
+            polyUvObj.ebo = std::make_unique<Buffer>(GL_ELEMENT_ARRAY_BUFFER);
+            polyUvObj.ebo->bind_data(uv_list.data(), uv_list.size() * sizeof(uv_list[0]));
+            auto vbo = std::make_unique<Buffer>(GL_ARRAY_BUFFER);
+            for (const auto &uv: prim->uvs) {
+                uv_data.emplace_back(uv[0], uv[1], 0);
             }
+            vbo->bind_data(uv_data.data(), uv_data.size() * sizeof(uv_data[0]));
+            polyUvObj.vbos.push_back(std::move(vbo));
+            polyUvObj.prog = get_edge_program();
         }
 
         if (!prim->attr_is<zeno::vec3f>("pos")) {
@@ -460,7 +315,7 @@ struct ZhxxGraphicPrimitive final : IGraphicDraw {
         if (thePrmHasFaces && need_computeNormal) {
             /* std::cout << "computing normal\n"; */
             zeno::log_trace("computing normal");
-            zeno::primCalcNormal(&*prim, 1);
+            primMeshNormals(*prep, &*prim);
         }
         if (int subdlevs = prim->userData().get2<int>("delayedSubdivLevels", 0)) {
             // todo: zhxx, should comp normal after subd or before?
@@ -478,8 +333,7 @@ struct ZhxxGraphicPrimitive final : IGraphicDraw {
         }
         if (thePrmHasFaces) {
             zeno::log_trace("demoting faces");
-            zeno::primTriangulateQuads(&*prim);
-            zeno::primTriangulate(&*prim);//will further loop.attr("uv") to tris.attr("uv0")...
+            primMeshTriangulate(*prep, &*prim);//will further loop.attr("uv") to tris.attr("uv0")...
         }
 #else
         zeno::primSepTriangles(&*prim, true, true);//TODO: rm keepTriFaces
@@ -600,8 +454,8 @@ struct ZhxxGraphicPrimitive final : IGraphicDraw {
                                       tris_count * sizeof(prim->tris[0]));
 
             } else {
-                computeTrianglesTangent(&*prim);
-                parseTrianglesDrawBuffer(&*prim, triObj);
+                primMeshTrianglesTangent(*prep, &*prim);
+                parseTrianglesDrawBuffer(&*prim, *prep, triObj);
             }
 
             bool findCamera = false;
@@ -0,0 +1,361 @@
+#include <zenovis/bate/PrimMeshPrep.h>
+#include <zeno/types/PrimitiveObject.h>
+#include <zeno/types/UserData.h>
+#include <zeno/funcs/PrimitiveUtils.h>
+#include <zeno/utils/parallel_reduce.h>
+#include <zeno/para/parallel_scan.h>
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <mutex>
+
+namespace zenovis {
+
+static constexpr std::size_t kMaxCachedTopologies = 8;
+
+static std::uint64_t prep_mix(std::uint64_t x) { // splitmix64 finalizer
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+template <class T>
+static std::uint64_t prep_hash_array(std::vector<T> const &arr, std::uint64_t salt) {
+    static_assert(sizeof(T) % sizeof(std::uint32_t) == 0);
+    constexpr std::size_t n = sizeof(T) / sizeof(std::uint32_t);
+    auto const *p = reinterpret_cast<std::uint32_t const *>(arr.data());
+    auto hash = zeno::parallel_reduce_array<std::uint64_t>(arr.size() * n, 0, [&] (std::size_t i) {
+        return prep_mix(((std::uint64_t)i << 32 | p[i]) ^ salt);
+    }, [] (std::uint64_t x, std::uint64_t y) { return x + y; });
+    return prep_mix(hash ^ prep_mix(arr.size() + salt));
+}
+
+static std::vector<int> const &prep_loop_uvs(zeno::PrimitiveObject const *prim) {
+    static std::vector<int> const none;
+    return prim->loops.attr_is<int>("uvs") ? prim->loops.attr<int>("uvs") : none;
+}
+
+template <class T>
+static bool prep_same_array(std::vector<T> const &a, std::vector<T> const &b) {
+    return a.size() == b.size() && (a.empty() || !std::memcmp(a.data(), b.data(), a.size() * sizeof(T)));
+}
+
+static bool prep_same_topology(PrimMeshPrep::Snapshot const &snap, zeno::PrimitiveObject const *prim) {
+    return snap.numVerts == prim->verts.size()
+        && snap.subdivLevels == prim->userData().get2<int>("delayedSubdivLevels", 0)
+        && prep_same_array(snap.points, prim->points.values)
+        && prep_same_array(snap.lines, prim->lines.values)
+        && prep_same_array(snap.tris, prim->tris.values)
+        && prep_same_array(snap.quads, prim->quads.values)
+        && prep_same_array(snap.polys, prim->polys.values)
+        && prep_same_array(snap.loops, prim->loops.values)
+        && prep_same_array(snap.loopUvs, prep_loop_uvs(prim));
+}
+
+std::shared_ptr<PrimMeshPrep> getPrimMeshPrep(zeno::PrimitiveObject const *prim) {
+    static std::mutex mtx;
+    static std::list<std::shared_ptr<PrimMeshPrep>> lru; // most recent first
+    auto use = [&] (auto it) {
+        lru.splice(lru.begin(), lru, it);
+        return lru.front();
+    };
+    // comparing bails out at the first differing size or byte
+    std::lock_guard lck(mtx);
+    auto it = std::find_if(lru.begin(), lru.end(), [&] (auto const &prep) {
+        return prep_same_topology(prep->snapshot, prim);
+    });
+    if (it != lru.end())
+        return use(it);
+    auto prep = std::make_shared<PrimMeshPrep>();
+    auto &snap = prep->snapshot;
+    snap.numVerts = prim->verts.size();
+    snap.subdivLevels = prim->userData().get2<int>("delayedSubdivLevels", 0);
+    snap.points = prim->points.values;
+    snap.lines = prim->lines.values;
+    snap.tris = prim->tris.values;
+    snap.quads = prim->quads.values;
+    snap.polys = prim->polys.values;
+    snap.loops = prim->loops.values;
+    snap.loopUvs = prep_loop_uvs(prim);
+    lru.push_front(prep);
+    if (lru.size() > kMaxCachedTopologies)
+        lru.pop_back();
+    return prep;
+}
+
+void primMeshHashPositions(PrimMeshPrep &prep, zeno::PrimitiveObject const *prim) {
+    prep.posKey = prep_hash_array(prim->verts.values, 11);
+}
+
+void primMeshPolyEdges(PrimMeshPrep &prep, zeno::PrimitiveObject const *prim) {
+    if (prep.polyEdgesReady)
+        return;
+    prep.polyEdgesReady = true;
+    prep.polyEdges.clear();
+    prep.polyUvEdges.clear();
+    bool any_not_triangle = std::any_of(prim->polys.begin(), prim->polys.end(), [] (auto const &poly) {
+        return poly[1] > 3;
+    });
+    if (!any_not_triangle)
+        return;
+    auto add_edges = [&] (std::vector<int> &edge_list, auto const &ids) {
+        auto add_edge = [&] (int a, int b) {
+            edge_list.push_back(ids[a]);
+            edge_list.push_back(ids[b]);
+        };
+        for (const auto &[b, c]: prim->polys) {
+            for (auto i = 2; i < c; i++) {
+                if (i == 2) {
+                    add_edge(b, b + 1);
+                }
+                add_edge(b + i - 1, b + i);
+                if (i == c - 1) {
+                    add_edge(b, b + i);
+                }
+            }
+        }
+    };
+    add_edges(prep.polyEdges, prim->loops.values);
+    if (prim->loops.attr_is<int>("uvs"))
+        add_edges(prep.polyUvEdges, prim->loops.attr<int>("uvs"));
+}
+
+void primMeshNormals(PrimMeshPrep &prep, zeno::PrimitiveObject *prim) {
+    if (prep.nrmKey == prep.posKey && prep.nrm.size() == prim->verts.size()) {
+        prim->add_attr<zeno::vec3f>("nrm") = prep.nrm;
+        return;
+    }
+    if (!prep.halfedges)
+        prep.halfedges = zeno::primGetTopology(prim);
+    zeno::primCalcNormal(prim, *prep.halfedges, 1);
+    prep.nrm = prim->attr<zeno::vec3f>("nrm");
+    prep.nrmKey = prep.posKey;
+}
+
+static void prep_build_triangulation(PrimMeshPrep &prep, zeno::PrimitiveObject const *prim) {
+    auto const &quads = prim->quads;
+    prep.quadTris.resize(quads.size() * 2);
+#pragma omp parallel for
+    for (intptr_t i = 0; i < quads.size(); i++) {
+        auto quad = quads[i];
+        prep.quadTris[i * 2 + 0] = zeno::vec3i(quad[0], quad[1], quad[2]);
+        prep.quadTris[i * 2 + 1] = zeno::vec3i(quad[0], quad[2], quad[3]);
+    }
+
+    auto const &polys = prim->polys;
+    auto const &loops = prim->loops;
+    std::vector<zeno::vec2i> scansum(polys.size());
+    auto redsum = zeno::parallel_exclusive_scan_sum(polys.begin(), polys.end(), scansum.begin(), [&] (auto &ind) {
+        return zeno::vec2i(ind[1] >= 3 ? ind[1] - 2 : 0, ind[1] == 2 ? 1 : 0);
+    });
+    prep.polyTris.resize(redsum[0]);
+    prep.polyTriFaces.resize(redsum[0]);
+    prep.polyTriLoops.resize(redsum[0]);
+    prep.polyLines.resize(redsum[1]);
+#pragma omp parallel for
+    for (intptr_t i = 0; i < polys.size(); i++) {
+        auto [start, len] = polys[i];
+        if (len >= 3) {
+            int k = scansum[i][0];
+            for (int j = 2; j < len; j++, k++) {
+                auto corners = zeno::vec3i(start, start + j - 1, start + j);
+                prep.polyTris[k] = zeno::vec3i(loops[corners[0]], loops[corners[1]], loops[corners[2]]);
+                prep.polyTriFaces[k] = i;
+                prep.polyTriLoops[k] = corners;
+            }
+        } else if (len == 2) {
+            prep.polyLines[scansum[i][1]] = zeno::vec2i(loops[start], loops[start + 1]);
+        }
+    }
+
+    prep.trisMadeFrom = {prim->tris.size(), quads.size(), polys.size(), loops.size()};
+    prep.trisReady = true;
+}
+
+void primMeshTriangulate(PrimMeshPrep &prep, zeno::PrimitiveObject *prim) {
+    std::array<std::size_t, 4> counts{prim->tris.size(), prim->quads.size(), prim->polys.size(), prim->loops.size()};
+    if (!prep.trisReady || prep.trisMadeFrom != counts)
+        prep_build_triangulation(prep, prim);
+
+    // as primTriangulateQuads: quads only carry matid over, -1 if they have none
+    if (auto nq = prim->quads.size()) {
+        auto base = prim->tris.size();
+        prim->tris.resize(base + nq * 2);
+        std::copy(prep.quadTris.begin(), prep.quadTris.end(), prim->tris.begin() + base);
+        auto &matid = prim->tris.add_attr<int>("matid");
+        if (prim->quads.attr_is<int>("matid")) {
+            auto const &quadMatid = prim->quads.attr<int>("matid");
+            for (std::size_t i = 0; i < nq; i++)
+                matid[base + i * 2] = matid[base + i * 2 + 1] = quadMatid[i];
+        } else {
+            std::fill(matid.begin() + base, matid.end(), -1);
+        }
+        prim->quads.clear();
+    }
+
+    // as primTriangulate with uvs, lines and attributes
+    if (prim->polys.size()) {
+        auto tribase = prim->tris.size();
+        auto linebase = prim->lines.size();
+        prim->tris.resize(tribase + prep.polyTris.size());
+        prim->lines.resize(linebase + prep.polyLines.size());
+        std::copy(prep.polyTris.begin(), prep.polyTris.end(), prim->tris.begin() + tribase);
+        std::copy(prep.polyLines.begin(), prep.polyLines.end(), prim->lines.begin() + linebase);
+
+        if (prim->loops.has_attr("uvs") && prim->uvs.size() > 0) {
+            auto const &loop_uv = prim->loops.attr<int>("uvs");
+            auto const &uvs = prim->uvs;
+            auto &uv0 = prim->tris.add_attr<zeno::vec3f>("uv0");
+            auto &uv1 = prim->tris.add_attr<zeno::vec3f>("uv1");
+            auto &uv2 = prim->tris.add_attr<zeno::vec3f>("uv2");
+            auto uv_at = [&] (int loop) {
+                auto uv = uvs[loop_uv[loop]];
+                return zeno::vec3f(uv[0], uv[1], 0);
+            };
+#pragma omp parallel for
+            for (intptr_t k = 0; k < prep.polyTriLoops.size(); k++) {
+                auto corners = prep.polyTriLoops[k];
+                uv0[tribase + k] = uv_at(corners[0]);
+                uv1[tribase + k] = uv_at(corners[1]);
+                uv2[tribase + k] = uv_at(corners[2]);
+            }
+        }
+
+        prim->polys.foreach_attr<zeno::AttrAcceptAll>([&] (auto const &key, auto &arr) {
+            using T = std::decay_t<decltype(arr[0])>;
+            auto &attr = prim->tris.add_attr<T>(key);
+            for (std::size_t k = 0; k < prep.polyTriFaces.size(); k++)
+                attr[tribase + k] = arr[prep.polyTriFaces[k]];
+        });
+        prim->loops.clear_with_attr();
+        prim->polys.clear_with_attr();
+        prim->uvs.clear_with_attr();
+    }
+}
+
+static std::uint64_t prep_hash_tris_uv(zeno::PrimitiveObject const *prim) {
+    auto const &tris = prim->tris;
+    return prep_hash_array(tris.attr<zeno::vec3f>("uv0"), 12)
+         ^ prep_hash_array(tris.attr<zeno::vec3f>("uv1"), 13)
+         ^ prep_hash_array(tris.attr<zeno::vec3f>("uv2"), 14);
+}
+
+void primMeshTrianglesTangent(PrimMeshPrep &prep, zeno::PrimitiveObject *prim) {
+    const auto &tris = prim->tris;
+    bool has_uv =
+        tris.has_attr("uv0") && tris.has_attr("uv1") && tris.has_attr("uv2");
+    auto key = prep.posKey ^ (has_uv ? prep_hash_tris_uv(prim) : 16);
+    auto &tang = prim->tris.add_attr<zeno::vec3f>("tang");
+    if (prep.tangKey == key && prep.tang.size() == tris.size()) {
+        tang = prep.tang;
+        return;
+    }
+
+    const auto &pos = prim->attr<zeno::vec3f>("pos");
+    const zeno::vec3f *uv0_data = nullptr;
+    const zeno::vec3f *uv1_data = nullptr;
+    const zeno::vec3f *uv2_data = nullptr;
+    if (has_uv) {
+        uv0_data = tris.attr<zeno::vec3f>("uv0").data();
+        uv1_data = tris.attr<zeno::vec3f>("uv1").data();
+        uv2_data = tris.attr<zeno::vec3f>("uv2").data();
+    }
+#pragma omp parallel for
+    for (auto i = 0; i < prim->tris.size(); ++i) {
+        if (has_uv) {
+            const auto &pos0 = pos[tris[i][0]];
+            const auto &pos1 = pos[tris[i][1]];
+            const auto &pos2 = pos[tris[i][2]];
+            auto uv0 = uv0_data[i];
+            auto uv1 = uv1_data[i];
+            auto uv2 = uv2_data[i];
+
+            auto edge0 = pos1 - pos0;
+            auto edge1 = pos2 - pos0;
+            auto deltaUV0 = uv1 - uv0;
+            auto deltaUV1 = uv2 - uv0;
+
+            auto f = 1.0f / (deltaUV0[0] * deltaUV1[1] -
+                             deltaUV1[0] * deltaUV0[1] + 1e-5);
+
+            zeno::vec3f tangent;
+            tangent[0] = f * (deltaUV1[1] * edge0[0] - deltaUV0[1] * edge1[0]);
+            tangent[1] = f * (deltaUV1[1] * edge0[1] - deltaUV0[1] * edge1[1]);
+            tangent[2] = f * (deltaUV1[1] * edge0[2] - deltaUV0[1] * edge1[2]);
+            tang[i] = tangent;
+        } else {
+            tang[i] = zeno::vec3f(0);
+        }
+    }
+    prep.tang = tang;
+    prep.tangKey = key;
+}
+
+void primMeshTriangleCorners(PrimMeshPrep &prep, zeno::PrimitiveObject const *prim) {
+    auto const &tris = prim->tris;
+    std::size_t count = tris.size();
+
+    if (prep.triCorners.size() != count) {
+        prep.triCorners.resize(count);
+#pragma omp parallel for
+        for (intptr_t i = 0; i < count; i++) {
+            prep.triCorners[i] = zeno::vec3i(i * 3, i * 3 + 1, i * 3 + 2);
+        }
+    }
+
+    // re-packs channel c from a per-point attribute unless its hash is unchanged
+    auto pack_points = [&] (int c, std::vector<zeno::vec3f> const &arr) {
+        auto key = c == PrimMeshPrep::CornerPos ? prep.posKey : prep_hash_array(arr, 20 + c);
+        auto &out = prep.corners[c];
+        if (prep.cornerKeys[c] == key && out.size() == count * 3)
+            return;
+        out.resize(count * 3);
+#pragma omp parallel for
+        for (intptr_t i = 0; i < count; i++) {
+            out[i * 3 + 0] = arr[tris[i][0]];
+            out[i * 3 + 1] = arr[tris[i][1]];
+            out[i * 3 + 2] = arr[tris[i][2]];
+        }
+        prep.cornerKeys[c] = key;
+    };
+    pack_points(PrimMeshPrep::CornerPos, prim->attr<zeno::vec3f>("pos"));
+    pack_points(PrimMeshPrep::CornerClr, prim->attr<zeno::vec3f>("clr"));
+    pack_points(PrimMeshPrep::CornerNrm, prim->attr<zeno::vec3f>("nrm"));
+
+    {
+        auto key = prep_hash_tris_uv(prim);
+        auto &out = prep.corners[PrimMeshPrep::CornerUv];
+        if (prep.cornerKeys[PrimMeshPrep::CornerUv] != key || out.size() != count * 3) {
+            auto &uv0 = tris.attr<zeno::vec3f>("uv0");
+            auto &uv1 = tris.attr<zeno::vec3f>("uv1");
+            auto &uv2 = tris.attr<zeno::vec3f>("uv2");
+            out.resize(count * 3);
+#pragma omp parallel for
+            for (intptr_t i = 0; i < count; i++) {
+                out[i * 3 + 0] = uv0[i];
+                out[i * 3 + 1] = uv1[i];
+                out[i * 3 + 2] = uv2[i];
+            }
+            prep.cornerKeys[PrimMeshPrep::CornerUv] = key;
+        }
+    }
+
+    {
+        auto &tang = tris.attr<zeno::vec3f>("tang");
+        auto key = prep_hash_array(tang, 25);
+        auto &out = prep.corners[PrimMeshPrep::CornerTang];
+        if (prep.cornerKeys[PrimMeshPrep::CornerTang] != key || out.size() != count * 3) {
+            out.resize(count * 3);
+#pragma omp parallel for
+            for (intptr_t i = 0; i < count; i++) {
+                out[i * 3 + 0] = tang[i];
+                out[i * 3 + 1] = tang[i];
+                out[i * 3 + 2] = tang[i];
+            }
+            prep.cornerKeys[PrimMeshPrep::CornerTang] = key;
+        }
+    }
+}
+
+} // namespace zenovis
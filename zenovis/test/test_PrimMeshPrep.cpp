@@ -0,0 +1,137 @@
+// feeds two frames of a mesh with the same topology through the cached CPU-side
+// preparation of the primitive graphic, and checks every buffer of the second
+// (cached) frame against one built from scratch by the plain zeno functions
+#include <zenovis/bate/PrimMeshPrep.h>
+#include <zeno/types/PrimitiveObject.h>
+#include <zeno/funcs/PrimitiveUtils.h>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+
+using namespace zenovis;
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+static std::shared_ptr<zeno::PrimitiveObject> makeFrame(float t) {
+    auto prim = std::make_shared<zeno::PrimitiveObject>();
+    int n = 16;
+    prim->verts.resize(n * n);
+    auto &clr = prim->verts.add_attr<zeno::vec3f>("clr");
+    for (int i = 0; i < n * n; i++) {
+        prim->verts[i] = zeno::vec3f(i % n, i / n, std::sin(i * 0.37f + t));
+        clr[i] = zeno::vec3f(t, i % 3, 1);
+    }
+    for (int y = 0; y + 1 < n; y++) {
+        for (int x = 0; x + 1 < n; x++) {
+            int a = y * n + x;
+            if (x < 5) {
+                prim->tris.push_back(zeno::vec3i(a, a + 1, a + n));
+                prim->tris.push_back(zeno::vec3i(a + 1, a + n + 1, a + n));
+            } else if (x < 10) {
+                prim->quads.push_back(zeno::vec4i(a, a + 1, a + n + 1, a + n));
+            } else {
+                int base = prim->loops.size();
+                for (int v: {a, a + 1, a + n + 1, a + n})
+                    prim->loops.push_back(v);
+                prim->polys.push_back(zeno::vec2i(base, 4));
+            }
+        }
+    }
+    int base = prim->loops.size();
+    prim->loops.push_back(0);
+    prim->loops.push_back(n * n - 1);
+    prim->polys.push_back(zeno::vec2i(base, 2));
+
+    prim->quads.add_attr<int>("matid");
+    for (int i = 0; i < prim->quads.size(); i++)
+        prim->quads.attr<int>("matid")[i] = i % 4;
+    auto &faceId = prim->polys.add_attr<float>("faceId");
+    for (int i = 0; i < prim->polys.size(); i++)
+        faceId[i] = i + t;
+    auto &loopUvs = prim->loops.add_attr<int>("uvs");
+    prim->uvs.resize(prim->loops.size());
+    for (int i = 0; i < prim->loops.size(); i++) {
+        loopUvs[i] = i;
+        prim->uvs[i] = zeno::vec2f(i * 0.01f, t);
+    }
+    return prim;
+}
+
+// the CPU side of ZhxxGraphicPrimitive's constructor for a prim with faces
+static void prepare(PrimMeshPrep &prep, zeno::PrimitiveObject *prim) {
+    primMeshHashPositions(prep, prim);
+    primMeshPolyEdges(prep, prim);
+    primMeshNormals(prep, prim);
+    primMeshTriangulate(prep, prim);
+    primMeshTrianglesTangent(prep, prim);
+    primMeshTriangleCorners(prep, prim);
+}
+
+// zeno::vec compares element-wise, so compare the arrays bytewise instead
+template <class T>
+static bool same(std::vector<T> const &a, std::vector<T> const &b) {
+    return a.size() == b.size() && (a.empty() || !std::memcmp(a.data(), b.data(), a.size() * sizeof(T)));
+}
+
+template <class T>
+static bool sameAttr(zeno::AttrVector<T> const &a, zeno::AttrVector<T> const &b, std::string const &key) {
+    bool res = false;
+    a.template attr_visit<zeno::AttrAcceptAll>(key, [&] (auto const &arr) {
+        using V = std::decay_t<decltype(arr[0])>;
+        res = b.template attr_is<V>(key) && same(arr, b.template attr<V>(key));
+    });
+    return res;
+}
+
+int main() {
+    auto frame0 = makeFrame(0.f);
+    auto prep0 = getPrimMeshPrep(frame0.get());
+    prepare(*prep0, frame0.get());
+
+    auto frame1 = makeFrame(1.f);
+    auto prep1 = getPrimMeshPrep(frame1.get());
+    CHECK(prep1 == prep0);
+    auto polyEdges = prep1->polyEdges;
+    auto polyUvEdges = prep1->polyUvEdges;
+    prepare(*prep1, frame1.get());
+
+    auto fresh = makeFrame(1.f);
+    PrimMeshPrep freshPrep;
+    primMeshPolyEdges(freshPrep, fresh.get());
+    CHECK(same(polyEdges, freshPrep.polyEdges));
+    CHECK(same(polyUvEdges, freshPrep.polyUvEdges));
+    zeno::primCalcNormal(fresh.get(), 1);
+    zeno::primTriangulateQuads(fresh.get());
+    zeno::primTriangulate(fresh.get());
+    primMeshHashPositions(freshPrep, fresh.get());
+    primMeshTrianglesTangent(freshPrep, fresh.get());
+    primMeshTriangleCorners(freshPrep, fresh.get());
+
+    CHECK(same(frame1->verts.attr<zeno::vec3f>("nrm"), fresh->verts.attr<zeno::vec3f>("nrm")));
+    CHECK(same(frame1->tris.values, fresh->tris.values));
+    CHECK(same(frame1->lines.values, fresh->lines.values));
+    CHECK(frame1->quads.size() == 0 && frame1->polys.size() == 0 && frame1->loops.size() == 0);
+    CHECK(frame1->tris.num_attrs<zeno::AttrAcceptAll>() == fresh->tris.num_attrs<zeno::AttrAcceptAll>());
+    for (auto const &key: fresh->tris.attr_keys<zeno::AttrAcceptAll>())
+        CHECK(sameAttr(frame1->tris, fresh->tris, key));
+    CHECK(same(prep1->triCorners, freshPrep.triCorners));
+    for (int c = 0; c < PrimMeshPrep::NumCornerChannels; c++)
+        CHECK(same(prep1->corners[c], freshPrep.corners[c]));
+
+    auto other = makeFrame(1.f);
+    other->tris[0] = zeno::vec3i(0, 2, 1);
+    CHECK(getPrimMeshPrep(other.get()) != prep0);
+
+    if (failures)
+        std::printf("%d checks failed\n", failures);
+    else
+        std::printf("all checks passed\n");
+    return failures != 0;
+}